@@ -0,0 +1,328 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SMALL_VECTOR_HPP
+#define NFD_CORE_SMALL_VECTOR_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief a sequence container that stores up to \p N elements inline
+ *
+ *  SmallVector behaves like a minimal std::vector, but its first \p N elements live
+ *  inside the object, so that a SmallVector on the stack does not touch the heap
+ *  until it grows beyond \p N elements.
+ *  Iterators are plain pointers, and are invalidated by any insertion.
+ */
+template<typename T, size_t N>
+class SmallVector
+{
+  static_assert(N > 0, "SmallVector must have inline capacity");
+
+public:
+  typedef T value_type;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+  typedef size_t size_type;
+
+  SmallVector()
+    : m_begin(inlineData())
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  SmallVector(const SmallVector& other)
+    : SmallVector()
+  {
+    this->reserve(other.size());
+    for (const T& item : other) {
+      this->push_back(item);
+    }
+  }
+
+  SmallVector(SmallVector&& other)
+    : SmallVector()
+  {
+    this->steal(other);
+  }
+
+  ~SmallVector()
+  {
+    this->clear();
+    this->deallocate();
+  }
+
+  SmallVector&
+  operator=(const SmallVector& other)
+  {
+    if (this != &other) {
+      this->clear();
+      this->reserve(other.size());
+      for (const T& item : other) {
+        this->push_back(item);
+      }
+    }
+    return *this;
+  }
+
+  SmallVector&
+  operator=(SmallVector&& other)
+  {
+    if (this != &other) {
+      this->clear();
+      this->steal(other);
+    }
+    return *this;
+  }
+
+public: // iteration and access
+  iterator
+  begin()
+  {
+    return m_begin;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_begin;
+  }
+
+  iterator
+  end()
+  {
+    return m_begin + m_size;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_begin + m_size;
+  }
+
+  reference
+  operator[](size_t i)
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_begin[i];
+  }
+
+  const_reference
+  operator[](size_t i) const
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_begin[i];
+  }
+
+  reference
+  back()
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[m_size - 1];
+  }
+
+  const_reference
+  back() const
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[m_size - 1];
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \return whether elements are stored inline, i.e. no heap memory is held
+   */
+  bool
+  isInline() const
+  {
+    return m_begin == inlineData();
+  }
+
+public: // modifiers
+  template<typename... Args>
+  reference
+  emplace_back(Args&&... args)
+  {
+    if (m_size < m_capacity) {
+      new (m_begin + m_size) T(std::forward<Args>(args)...);
+    }
+    else {
+      // construct the new element first, because args may refer to an existing element
+      size_t newCapacity = m_capacity * 2;
+      T* newBegin = allocate(newCapacity);
+      new (newBegin + m_size) T(std::forward<Args>(args)...);
+      this->relocate(newBegin, newCapacity);
+    }
+    return m_begin[m_size++];
+  }
+
+  void
+  push_back(const T& item)
+  {
+    this->emplace_back(item);
+  }
+
+  void
+  push_back(T&& item)
+  {
+    this->emplace_back(std::move(item));
+  }
+
+  void
+  pop_back()
+  {
+    BOOST_ASSERT(m_size > 0);
+    m_begin[--m_size].~T();
+  }
+
+  /** \brief removes the element at \p pos, and shifts subsequent elements forward
+   *  \return iterator following the removed element
+   */
+  iterator
+  erase(const_iterator pos)
+  {
+    BOOST_ASSERT(pos >= begin() && pos < end());
+    iterator it = m_begin + (pos - m_begin);
+    std::move(it + 1, this->end(), it);
+    this->pop_back();
+    return it;
+  }
+
+  void
+  reserve(size_t capacity)
+  {
+    if (capacity > m_capacity) {
+      this->relocate(allocate(capacity), capacity);
+    }
+  }
+
+  /** \brief destroys all elements
+   *
+   *  Heap memory, if any, is retained for reuse.
+   */
+  void
+  clear()
+  {
+    for (size_t i = 0; i < m_size; ++i) {
+      m_begin[i].~T();
+    }
+    m_size = 0;
+  }
+
+private:
+  T*
+  inlineData()
+  {
+    return reinterpret_cast<T*>(m_inline);
+  }
+
+  const T*
+  inlineData() const
+  {
+    return reinterpret_cast<const T*>(m_inline);
+  }
+
+  static T*
+  allocate(size_t capacity)
+  {
+    return static_cast<T*>(::operator new(capacity * sizeof(T)));
+  }
+
+  void
+  deallocate()
+  {
+    if (!this->isInline()) {
+      ::operator delete(m_begin);
+    }
+  }
+
+  /** \brief moves existing elements into \p newBegin, and adopts it as storage
+   */
+  void
+  relocate(T* newBegin, size_t newCapacity)
+  {
+    for (size_t i = 0; i < m_size; ++i) {
+      new (newBegin + i) T(std::move(m_begin[i]));
+      m_begin[i].~T();
+    }
+    this->deallocate();
+    m_begin = newBegin;
+    m_capacity = newCapacity;
+  }
+
+  /** \brief takes elements from \p other, which must be empty afterwards
+   *  \pre this->empty()
+   */
+  void
+  steal(SmallVector& other)
+  {
+    BOOST_ASSERT(m_size == 0);
+    if (other.isInline()) {
+      for (T& item : other) {
+        this->emplace_back(std::move(item));
+      }
+      other.clear();
+      return;
+    }
+
+    this->deallocate();
+    m_begin = other.m_begin;
+    m_size = other.m_size;
+    m_capacity = other.m_capacity;
+    other.m_begin = other.inlineData();
+    other.m_size = 0;
+    other.m_capacity = N;
+  }
+
+private:
+  T* m_begin;
+  size_t m_size;
+  size_t m_capacity;
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SMALL_VECTOR_HPP
@@ -0,0 +1,496 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_TIMER_WHEEL_HPP
+#define NFD_CORE_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include "scheduler.hpp"
+
+namespace nfd {
+
+template<typename T>
+class TimerWheel;
+
+/** \brief links an object into TimerWheel<T>
+ *
+ *  T must derive publicly from TimerWheelHook<T>, and from enable_shared_from_this.
+ *  The hook holds the timer state of the object, so that arming and cancelling the timer
+ *  need no memory allocation.
+ */
+template<typename T>
+class TimerWheelHook
+{
+protected:
+  TimerWheelHook();
+
+private:
+  enum TimerState : uint8_t {
+    TIMER_IDLE,
+    TIMER_ARMED,
+    TIMER_EXPIRING
+  };
+  TimerState m_timerState;
+  uint8_t m_timerLevel;
+  uint64_t m_timerExpiry;
+  T* m_timerPrev;
+  T* m_timerNext;
+
+  friend class TimerWheel<T>;
+};
+
+/** \brief a hierarchical timing wheel
+ *
+ *  The wheel has N_LEVELS levels of N_SLOTS slots. A level 0 slot spans one tick.
+ *  A slot on level L spans N_SLOTS^L ticks. Each slot is the head of a doubly linked list.
+ *  The list links are stored in the TimerWheelHook of each object. Therefore arming and
+ *  cancelling a timer are O(1) and allocate no memory.
+ *  As the wheel turns, objects on higher levels are cascaded down toward level 0.
+ *
+ *  A single scheduler event drives the wheel. It is scheduled for the next tick that
+ *  has due objects or needs a cascade. When it fires, every object that is due is
+ *  unlinked, and the expire callback is invoked on them as one batch.
+ *  A timer never fires before its deadline, and fires at most one tick after it.
+ *
+ *  \tparam T type of object that has a timer, see TimerWheelHook
+ */
+template<typename T>
+class TimerWheel : noncopyable
+{
+public:
+  typedef function<void(const shared_ptr<T>&)> ExpireCallback;
+
+  explicit
+  TimerWheel(const ExpireCallback& expire,
+             const time::nanoseconds& tickDuration = time::milliseconds(1));
+
+  ~TimerWheel();
+
+  /** \brief arms the timer of \p entry to fire after \p after
+   *
+   *  If the timer of \p entry is already armed, it is rearmed.
+   *  \pre entry is owned by a shared_ptr
+   */
+  void
+  arm(T& entry, const time::nanoseconds& after);
+
+  /** \brief disarms the timer of \p entry if it is armed
+   */
+  void
+  cancel(T& entry);
+
+  /** \return whether the timer of \p entry is armed
+   */
+  static bool
+  isArmed(const T& entry);
+
+  /** \return an object whose timer fires soonest, or nullptr if no timer is armed
+   *
+   *  The result is exact for objects due within N_SLOTS ticks. Beyond that, the result
+   *  is one of the objects in the earliest non-empty slot of a higher level.
+   */
+  T*
+  findSoonest() const;
+
+  /** \return number of armed timers
+   */
+  size_t
+  size() const;
+
+  const time::nanoseconds&
+  getTickDuration() const;
+
+private:
+  typedef uint64_t Tick;
+  typedef TimerWheelHook<T> Hook;
+
+  static Hook&
+  hook(T& entry);
+
+  /** \return the tick that contains \p t
+   */
+  Tick
+  toTick(const time::steady_clock::TimePoint& t) const;
+
+  /** \brief links \p entry into the slot for its expiry tick
+   *  \pre hook(entry).m_timerExpiry >= m_nextTick
+   */
+  void
+  link(T& entry);
+
+  void
+  unlink(T& entry);
+
+  /** \brief moves all objects in a slot on \p level to lower levels
+   */
+  void
+  cascade(size_t level, size_t slot);
+
+  /** \brief processes all ticks up to the current time, and expires due objects
+   */
+  void
+  advance();
+
+  /** \return the next tick that has due objects or needs a cascade
+   *  \pre the wheel is not empty
+   */
+  Tick
+  findNextTick() const;
+
+  /** \brief schedules the scheduler event for \p tick, unless it fires earlier
+   */
+  void
+  scheduleTick(Tick tick);
+
+private:
+  static const size_t N_LEVELS = 4;
+  static const size_t SLOT_BITS = 8;
+  static const size_t N_SLOTS = 1 << SLOT_BITS;
+  static const Tick SLOT_MASK = N_SLOTS - 1;
+  static const Tick MAX_DELTA = (Tick(1) << (N_LEVELS * SLOT_BITS)) - 1;
+  static const Tick NO_TICK = std::numeric_limits<Tick>::max();
+
+  ExpireCallback m_expire;
+  time::nanoseconds m_tickDuration;
+  time::steady_clock::TimePoint m_epoch;
+
+  /// the first tick that has not been processed
+  Tick m_nextTick;
+  T* m_slots[N_LEVELS][N_SLOTS];
+  size_t m_size;
+
+  scheduler::EventId m_tickEvent;
+  /// the tick that m_tickEvent is scheduled for, or NO_TICK
+  Tick m_scheduledTick;
+
+  /// due objects of the current batch; kept as a member so that its capacity is reused
+  std::vector<shared_ptr<T>> m_expired;
+};
+
+template<typename T>
+TimerWheelHook<T>::TimerWheelHook()
+  : m_timerState(TIMER_IDLE)
+  , m_timerLevel(0)
+  , m_timerExpiry(0)
+  , m_timerPrev(nullptr)
+  , m_timerNext(nullptr)
+{
+}
+
+template<typename T>
+const size_t TimerWheel<T>::N_LEVELS;
+template<typename T>
+const size_t TimerWheel<T>::SLOT_BITS;
+template<typename T>
+const size_t TimerWheel<T>::N_SLOTS;
+template<typename T>
+const typename TimerWheel<T>::Tick TimerWheel<T>::SLOT_MASK;
+template<typename T>
+const typename TimerWheel<T>::Tick TimerWheel<T>::MAX_DELTA;
+template<typename T>
+const typename TimerWheel<T>::Tick TimerWheel<T>::NO_TICK;
+
+template<typename T>
+TimerWheel<T>::TimerWheel(const ExpireCallback& expire, const time::nanoseconds& tickDuration)
+  : m_expire(expire)
+  , m_tickDuration(tickDuration)
+  , m_epoch(time::steady_clock::now())
+  , m_nextTick(0)
+  , m_size(0)
+  , m_scheduledTick(NO_TICK)
+{
+  BOOST_ASSERT(m_tickDuration > time::nanoseconds::zero());
+  std::fill(&m_slots[0][0], &m_slots[0][0] + N_LEVELS * N_SLOTS, nullptr);
+}
+
+template<typename T>
+TimerWheel<T>::~TimerWheel()
+{
+  scheduler::cancel(m_tickEvent);
+
+  // objects may outlive the wheel, so leave them unlinked
+  for (auto& level : m_slots) {
+    for (T*& head : level) {
+      for (T* entry = head; entry != nullptr;) {
+        Hook& h = hook(*entry);
+        T* next = h.m_timerNext;
+        h.m_timerPrev = h.m_timerNext = nullptr;
+        h.m_timerState = Hook::TIMER_IDLE;
+        entry = next;
+      }
+      head = nullptr;
+    }
+  }
+}
+
+template<typename T>
+inline typename TimerWheel<T>::Hook&
+TimerWheel<T>::hook(T& entry)
+{
+  return static_cast<Hook&>(entry);
+}
+
+template<typename T>
+inline bool
+TimerWheel<T>::isArmed(const T& entry)
+{
+  return static_cast<const Hook&>(entry).m_timerState != Hook::TIMER_IDLE;
+}
+
+template<typename T>
+inline size_t
+TimerWheel<T>::size() const
+{
+  return m_size;
+}
+
+template<typename T>
+inline const time::nanoseconds&
+TimerWheel<T>::getTickDuration() const
+{
+  return m_tickDuration;
+}
+
+template<typename T>
+typename TimerWheel<T>::Tick
+TimerWheel<T>::toTick(const time::steady_clock::TimePoint& t) const
+{
+  if (t <= m_epoch) {
+    return 0;
+  }
+  return static_cast<Tick>((t - m_epoch).count() / m_tickDuration.count());
+}
+
+template<typename T>
+void
+TimerWheel<T>::arm(T& entry, const time::nanoseconds& after)
+{
+  this->cancel(entry);
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  if (m_size == 0) {
+    // no object is linked, so the ticks that have passed need no processing
+    m_nextTick = std::max(m_nextTick, this->toTick(now));
+  }
+
+  // round the deadline up to a tick boundary, so that the timer never fires early
+  time::nanoseconds offset = now + after - m_epoch;
+  Tick expiry = 0;
+  if (offset > time::nanoseconds::zero()) {
+    expiry = static_cast<Tick>((offset.count() + m_tickDuration.count() - 1) /
+                               m_tickDuration.count());
+  }
+  expiry = std::min(std::max(expiry, m_nextTick), m_nextTick + MAX_DELTA);
+
+  Hook& h = hook(entry);
+  h.m_timerExpiry = expiry;
+  this->link(entry);
+  ++m_size;
+
+  if (h.m_timerLevel == 0) {
+    this->scheduleTick(expiry);
+  }
+  else {
+    // the object reaches level 0 through a cascade, which happens on a multiple of N_SLOTS
+    this->scheduleTick((m_nextTick + SLOT_MASK) & ~SLOT_MASK);
+  }
+}
+
+template<typename T>
+void
+TimerWheel<T>::cancel(T& entry)
+{
+  Hook& h = hook(entry);
+  switch (h.m_timerState) {
+  case Hook::TIMER_ARMED:
+    this->unlink(entry);
+    --m_size;
+    break;
+  case Hook::TIMER_EXPIRING:
+    // object is in the current batch, and its callback must not be invoked
+    break;
+  case Hook::TIMER_IDLE:
+    return;
+  }
+  h.m_timerState = Hook::TIMER_IDLE;
+}
+
+template<typename T>
+T*
+TimerWheel<T>::findSoonest() const
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    size_t current = (m_nextTick >> (level * SLOT_BITS)) & SLOT_MASK;
+    // on higher levels, the current slot has been cascaded, and only holds objects
+    // that are a full revolution ahead
+    size_t first = level == 0 ? 0 : 1;
+    for (size_t offset = first; offset < first + N_SLOTS; ++offset) {
+      T* head = m_slots[level][(current + offset) & SLOT_MASK];
+      if (head != nullptr) {
+        return head;
+      }
+    }
+  }
+  return nullptr;
+}
+
+template<typename T>
+void
+TimerWheel<T>::link(T& entry)
+{
+  Hook& h = hook(entry);
+  BOOST_ASSERT(h.m_timerExpiry >= m_nextTick);
+  Tick delta = h.m_timerExpiry - m_nextTick;
+  BOOST_ASSERT(delta <= MAX_DELTA);
+
+  size_t level = 0;
+  while (delta >> ((level + 1) * SLOT_BITS) != 0) {
+    ++level;
+  }
+  T*& head = m_slots[level][(h.m_timerExpiry >> (level * SLOT_BITS)) & SLOT_MASK];
+
+  h.m_timerLevel = static_cast<uint8_t>(level);
+  h.m_timerPrev = nullptr;
+  h.m_timerNext = head;
+  if (head != nullptr) {
+    hook(*head).m_timerPrev = &entry;
+  }
+  head = &entry;
+  h.m_timerState = Hook::TIMER_ARMED;
+}
+
+template<typename T>
+void
+TimerWheel<T>::unlink(T& entry)
+{
+  Hook& h = hook(entry);
+  if (h.m_timerPrev != nullptr) {
+    hook(*h.m_timerPrev).m_timerNext = h.m_timerNext;
+  }
+  else {
+    size_t level = h.m_timerLevel;
+    m_slots[level][(h.m_timerExpiry >> (level * SLOT_BITS)) & SLOT_MASK] = h.m_timerNext;
+  }
+
+  if (h.m_timerNext != nullptr) {
+    hook(*h.m_timerNext).m_timerPrev = h.m_timerPrev;
+  }
+  h.m_timerPrev = h.m_timerNext = nullptr;
+}
+
+template<typename T>
+void
+TimerWheel<T>::cascade(size_t level, size_t slot)
+{
+  T* entry = m_slots[level][slot];
+  m_slots[level][slot] = nullptr;
+  while (entry != nullptr) {
+    T* next = hook(*entry).m_timerNext;
+    this->link(*entry);
+    entry = next;
+  }
+}
+
+template<typename T>
+void
+TimerWheel<T>::advance()
+{
+  m_tickEvent.reset();
+  m_scheduledTick = NO_TICK;
+
+  Tick lastTick = this->toTick(time::steady_clock::now());
+  for (; m_nextTick <= lastTick && m_size > 0; ++m_nextTick) {
+    Tick tick = m_nextTick;
+
+    // when a lower level wraps around, move the next slot of the level above down
+    size_t index = tick & SLOT_MASK;
+    for (size_t level = 1; index == 0 && level < N_LEVELS; ++level) {
+      index = (tick >> (level * SLOT_BITS)) & SLOT_MASK;
+      this->cascade(level, index);
+    }
+
+    T*& head = m_slots[0][tick & SLOT_MASK];
+    for (T* entry = head; entry != nullptr;) {
+      Hook& h = hook(*entry);
+      BOOST_ASSERT(h.m_timerExpiry == tick);
+      T* next = h.m_timerNext;
+      h.m_timerPrev = h.m_timerNext = nullptr;
+      h.m_timerState = Hook::TIMER_EXPIRING;
+      m_expired.push_back(entry->shared_from_this());
+      --m_size;
+      entry = next;
+    }
+    head = nullptr;
+  }
+
+  for (const shared_ptr<T>& entry : m_expired) {
+    // an earlier callback in this batch may have cancelled or rearmed the object
+    Hook& h = hook(*entry);
+    if (h.m_timerState == Hook::TIMER_EXPIRING) {
+      h.m_timerState = Hook::TIMER_IDLE;
+      m_expire(entry);
+    }
+  }
+  m_expired.clear();
+
+  if (m_size > 0) {
+    this->scheduleTick(this->findNextTick());
+  }
+}
+
+template<typename T>
+typename TimerWheel<T>::Tick
+TimerWheel<T>::findNextTick() const
+{
+  // objects on level 0 are due within N_SLOTS ticks;
+  // objects on higher levels need a cascade, which happens on a multiple of N_SLOTS
+  Tick tick = m_nextTick;
+  while (m_slots[0][tick & SLOT_MASK] == nullptr && (tick & SLOT_MASK) != 0) {
+    ++tick;
+  }
+  return tick;
+}
+
+template<typename T>
+void
+TimerWheel<T>::scheduleTick(Tick tick)
+{
+  if (tick >= m_scheduledTick) {
+    // the scheduled event fires earlier, and will schedule the next one
+    return;
+  }
+
+  time::steady_clock::TimePoint when = m_epoch + m_tickDuration * static_cast<int64_t>(tick);
+  time::nanoseconds after = std::max(when - time::steady_clock::now(),
+                                     time::nanoseconds::zero());
+
+  scheduler::cancel(m_tickEvent);
+  m_tickEvent = scheduler::schedule(after, bind(&TimerWheel<T>::advance, this));
+  m_scheduledTick = tick;
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_TIMER_WHEEL_HPP
@@ -175,13 +175,16 @@ AccessStrategy::multicast(shared_ptr<pit::Entry> pitEntry, shared_ptr<fib::Entry
                           std::unordered_set<FaceId> exceptFaces)
 {
   for (const fib::NextHop& nexthop : fibEntry->getNextHops()) {
-    shared_ptr<Face> face = nexthop.getFace();
-    if (exceptFaces.count(face->getId()) > 0) {
+    if (exceptFaces.count(nexthop.getFaceId()) > 0) {
       continue;
     }
-    NFD_LOG_DEBUG(pitEntry->getInterest() << " interestTo " << face->getId() <<
+    Face* outFace = this->getFaceTable().find(nexthop.getFaceId());
+    if (outFace == nullptr) {
+      continue;
+    }
+    NFD_LOG_DEBUG(pitEntry->getInterest() << " interestTo " << nexthop.getFaceId() <<
                   " multicast");
-    this->sendInterest(pitEntry, face);
+    this->sendInterest(pitEntry, *outFace);
   }
 }
 
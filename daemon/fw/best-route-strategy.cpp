@@ -40,13 +40,6 @@ BestRouteStrategy::~BestRouteStrategy()
 {
 }
 
-static inline bool
-predicate_PitEntry_canForwardTo_NextHop(shared_ptr<pit::Entry> pitEntry,
-                                        const fib::NextHop& nexthop)
-{
-  return pitEntry->canForwardTo(*nexthop.getFace());
-}
-
 void
 BestRouteStrategy::afterReceiveInterest(const Face& inFace,
                    const Interest& interest,
@@ -59,16 +52,15 @@ BestRouteStrategy::afterReceiveInterest(const Face& inFace,
   }
 
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
-  fib::NextHopList::const_iterator it = std::find_if(nexthops.begin(), nexthops.end(),
-    bind(&predicate_PitEntry_canForwardTo_NextHop, pitEntry, _1));
-
-  if (it == nexthops.end()) {
-    this->rejectPendingInterest(pitEntry);
-    return;
+  for (const fib::NextHop& nexthop : nexthops) {
+    Face* outFace = this->getFaceTable().find(nexthop.getFaceId());
+    if (outFace != nullptr && pitEntry->canForwardTo(*outFace)) {
+      this->sendInterest(pitEntry, *outFace);
+      return;
+    }
   }
 
-  shared_ptr<Face> outFace = it->getFace();
-  this->sendInterest(pitEntry, outFace);
+  this->rejectPendingInterest(pitEntry);
 }
 
 } // namespace fw
@@ -40,29 +40,34 @@ BestRouteStrategy2::BestRouteStrategy2(Forwarder& forwarder, const Name& name)
 }
 
 /** \brief determines whether a NextHop is eligible
+ *  \param faceTable resolves the face of NextHop
  *  \param currentDownstream incoming FaceId of current Interest
  *  \param wantUnused if true, NextHop must not have unexpired OutRecord
  *  \param now time::steady_clock::now(), ignored if !wantUnused
  */
 static inline bool
-predicate_NextHop_eligible(const shared_ptr<pit::Entry>& pitEntry,
+predicate_NextHop_eligible(const shared_ptr<pit::Entry>& pitEntry, const FaceTable& faceTable,
   const fib::NextHop& nexthop, FaceId currentDownstream,
   bool wantUnused = false,
   time::steady_clock::TimePoint now = time::steady_clock::TimePoint::min())
 {
-  shared_ptr<Face> upstream = nexthop.getFace();
-
   // upstream is current downstream
-  if (upstream->getId() == currentDownstream)
+  if (nexthop.getFaceId() == currentDownstream)
+    return false;
+
+  // upstream has been removed
+  Face* upstreamPtr = faceTable.find(nexthop.getFaceId());
+  if (upstreamPtr == nullptr)
     return false;
+  Face& upstream = *upstreamPtr;
 
   // forwarding would violate scope
-  if (pitEntry->violatesScope(*upstream))
+  if (pitEntry->violatesScope(upstream))
     return false;
 
   if (wantUnused) {
     // NextHop must not have unexpired OutRecord
-    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(*upstream);
+    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(upstream);
     if (outRecord != pitEntry->getOutRecords().end() &&
         outRecord->getExpiry() > now) {
       return false;
@@ -77,15 +82,17 @@ predicate_NextHop_eligible(const shared_ptr<pit::Entry>& pitEntry,
  */
 static inline fib::NextHopList::const_iterator
 findEligibleNextHopWithEarliestOutRecord(const shared_ptr<pit::Entry>& pitEntry,
+                                         const FaceTable& faceTable,
                                          const fib::NextHopList& nexthops,
                                          FaceId currentDownstream)
 {
   fib::NextHopList::const_iterator found = nexthops.end();
   time::steady_clock::TimePoint earliestRenewed = time::steady_clock::TimePoint::max();
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    if (!predicate_NextHop_eligible(pitEntry, *it, currentDownstream))
+    if (!predicate_NextHop_eligible(pitEntry, faceTable, *it, currentDownstream))
       continue;
-    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(*it->getFace());
+    pit::OutRecordCollection::const_iterator outRecord =
+      pitEntry->getOutRecord(*faceTable.find(it->getFaceId()));
     BOOST_ASSERT(outRecord != pitEntry->getOutRecords().end());
     if (outRecord->getLastRenewed() < earliestRenewed) {
       found = it;
@@ -101,6 +108,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
                                          shared_ptr<fib::Entry> fibEntry,
                                          shared_ptr<pit::Entry> pitEntry)
 {
+  const FaceTable& faceTable = this->getFaceTable();
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   fib::NextHopList::const_iterator it = nexthops.end();
 
@@ -109,7 +117,7 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
   if (suppression == RetxSuppression::NEW) {
     // forward to nexthop with lowest cost except downstream
     it = std::find_if(nexthops.begin(), nexthops.end(),
-      bind(&predicate_NextHop_eligible, pitEntry, _1, inFace.getId(),
+      bind(&predicate_NextHop_eligible, pitEntry, cref(faceTable), _1, inFace.getId(),
            false, time::steady_clock::TimePoint::min()));
 
     if (it == nexthops.end()) {
@@ -118,10 +126,9 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
       return;
     }
 
-    shared_ptr<Face> outFace = it->getFace();
-    this->sendInterest(pitEntry, outFace);
+    this->sendInterest(pitEntry, *faceTable.find(it->getFaceId()));
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
-                           << " newPitEntry-to=" << outFace->getId());
+                           << " newPitEntry-to=" << it->getFaceId());
     return;
   }
 
@@ -133,26 +140,24 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
 
   // find an unused upstream with lowest cost except downstream
   it = std::find_if(nexthops.begin(), nexthops.end(),
-                    bind(&predicate_NextHop_eligible, pitEntry, _1, inFace.getId(),
-                         true, time::steady_clock::now()));
+                    bind(&predicate_NextHop_eligible, pitEntry, cref(faceTable), _1,
+                         inFace.getId(), true, time::steady_clock::now()));
   if (it != nexthops.end()) {
-    shared_ptr<Face> outFace = it->getFace();
-    this->sendInterest(pitEntry, outFace);
+    this->sendInterest(pitEntry, *faceTable.find(it->getFaceId()));
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
-                           << " retransmit-unused-to=" << outFace->getId());
+                           << " retransmit-unused-to=" << it->getFaceId());
     return;
   }
 
   // find an eligible upstream that is used earliest
-  it = findEligibleNextHopWithEarliestOutRecord(pitEntry, nexthops, inFace.getId());
+  it = findEligibleNextHopWithEarliestOutRecord(pitEntry, faceTable, nexthops, inFace.getId());
   if (it == nexthops.end()) {
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmitNoNextHop");
   }
   else {
-    shared_ptr<Face> outFace = it->getFace();
-    this->sendInterest(pitEntry, outFace);
+    this->sendInterest(pitEntry, *faceTable.find(it->getFaceId()));
     NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
-                           << " retransmit-retry-to=" << outFace->getId());
+                           << " retransmit-retry-to=" << it->getFaceId());
   }
 }
 
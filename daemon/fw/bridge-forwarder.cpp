@@ -92,12 +92,30 @@ BridgeForwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   std::cout << m_id << " forwarding interest " << interest.getName() << std::endl;
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest, inFace.getId(),
+                                                 this->getHashContext(interest.getName())).first;
+  if (pitEntry == nullptr) {
+    // PIT is full, or inFace has reached its quota
+    NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
+                  " interest=[N:" << interest.getName() <<
+                  ", SN:" << interest.getSupportingName() <<
+                  "] rejected by PIT");
+    // (drop)
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float> duration = end - start;
+
+    if (m_interestDelayCallback != 0) {
+      m_interestDelayCallback(m_id, ns3::Simulator::Now(), duration.count());
+    }
+    return;
+  }
 
   // detect duplicate Nonce
+  // (Dead Nonce List reuses the Name hash computed by NameTree during PIT insert)
   int dnw = pitEntry->findNonce(interest.getNonce(), inFace);
   bool hasDuplicateNonce = (dnw != pit::DUPLICATE_NONCE_NONE) ||
-                           m_deadNonceList.has(interest.getName(), interest.getNonce());
+                           m_deadNonceList.has(m_nameTree.get(*pitEntry)->getHash(),
+                                               pitEntry->getName().size(), interest.getNonce());
   if (hasDuplicateNonce) {
     // goto Interest loop pipeline
     this->onInterestLoop(inFace, interest, pitEntry);
@@ -118,9 +136,9 @@ BridgeForwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   bool isPending = inRecords.begin() != inRecords.end();
   if (!isPending) {
     if (m_csFromNdnSim == nullptr) {
-      m_cs.find(interest,
-                bind(&BridgeForwarder::onContentStoreHit, this, ref(inFace), _1, _2),
-                bind(&BridgeForwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
+      this->findInCs(interest,
+                     bind(&BridgeForwarder::onContentStoreHit, this, ref(inFace), _1, _2),
+                     bind(&BridgeForwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
       shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
@@ -161,7 +179,9 @@ BridgeForwarder::onContentStoreMiss(const Face& inFace,
   }
 
   // FIB lookup
-  shared_ptr<fib::Entry> fibEntry = Forwarder::getFib().findLongestPrefixMatch(interest.getName());
+  shared_ptr<fib::Entry> fibEntry =
+    Forwarder::getFib().findLongestPrefixMatch(interest.getName(),
+                                               this->getHashContext(interest.getName()));
 
   // We need to set the supporting name here...
   // Interest newInterest(interest.getName(), m_Name);
@@ -200,7 +220,7 @@ static inline bool
 predicate_canForwardTo_NextHop(const Face& inFace,
                                const fib::NextHop& nexthop)
 {
-  return (inFace.getId() != nexthop.getFace()->getId());
+  return (inFace.getId() != nexthop.getFaceId());
 }
 
 void
@@ -265,22 +285,25 @@ BridgeForwarder::onIncomingData(Face& inFace, const Data& data)
   // what is used to route downstream.
   const_cast<Data&>(data).setName(data.getSupportingName());
 
-  // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
-  // - reduce amount of memory used by cached entries
-  // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
-  //
-  // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
-  // pointing to the same underlying memory buffer.
-  shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
-  dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-
   // CS insert
-  if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutPacket);
-  else
+  if (m_csFromNdnSim == nullptr) {
+    // NFD's CS keeps only the wire encoding, so neither a copy nor tag removal is needed
+    this->insertToCs(data, this->getHashContext(data.getName()));
+  }
+  else {
+    // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
+    // - reduce amount of memory used by cached entries
+    // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
+    //
+    // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
+    // pointing to the same underlying memory buffer.
+    shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
+    dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
     m_csFromNdnSim->Add(dataCopyWithoutPacket);
+  }
 
-  std::set<shared_ptr<Face> > pendingDownstreams;
+  SmallVector<shared_ptr<Face>, 8> pendingDownstreams;
+  const time::steady_clock::TimePoint now = time::steady_clock::now();
   // foreach PitEntry
   for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
@@ -292,8 +315,10 @@ BridgeForwarder::onIncomingData(Face& inFace, const Data& data)
     const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
     for (pit::InRecordCollection::const_iterator it = inRecords.begin();
                                                  it != inRecords.end(); ++it) {
-      if (it->getExpiry() > time::steady_clock::now()) {
-        pendingDownstreams.insert(it->getFace());
+      if (it->getExpiry() > now &&
+          std::find(pendingDownstreams.begin(), pendingDownstreams.end(),
+                    it->getFace()) == pendingDownstreams.end()) {
+        pendingDownstreams.push_back(it->getFace());
       }
     }
 
@@ -314,9 +339,7 @@ BridgeForwarder::onIncomingData(Face& inFace, const Data& data)
   }
 
   // foreach pending downstream
-  for (std::set<shared_ptr<Face> >::iterator it = pendingDownstreams.begin();
-      it != pendingDownstreams.end(); ++it) {
-    shared_ptr<Face> pendingDownstream = *it;
+  for (const shared_ptr<Face>& pendingDownstream : pendingDownstreams) {
     if (pendingDownstream.get() == &inFace) {
       continue;
     }
@@ -86,16 +86,16 @@ protected: // actions
   /// send Interest to outFace
   VIRTUAL_WITH_TESTS void
   sendInterestBridge(const Interest& interest,
-                      shared_ptr<Face> outFace,
+                      Face& outFace,
                       bool wantNewNonce = false);
 };
 
 inline void
 BridgeStrategy::sendInterestBridge(const Interest& interest,
-                                              shared_ptr<Face> outFace,
+                                              Face& outFace,
                                               bool wantNewNonce)
 {
-  dynamic_cast<nfd::BridgeForwarder&>(getForwarder()).onOutgoingInterestBridge(interest, *outFace, wantNewNonce);
+  dynamic_cast<nfd::BridgeForwarder&>(getForwarder()).onOutgoingInterestBridge(interest, outFace, wantNewNonce);
 }
 
 } // namespace fw
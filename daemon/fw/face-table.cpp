@@ -33,10 +33,44 @@ namespace nfd {
 
 NFD_LOG_INIT("FaceTable");
 
+/// number of bits in a FaceId for the slot generation, taken from the high end
+static const int GENERATION_BITS = 8;
+/// number of bits in a FaceId for the slot index
+static const int SLOT_BITS = std::numeric_limits<FaceId>::digits - GENERATION_BITS;
+static const uint32_t MAX_GENERATION = (1 << GENERATION_BITS) - 1;
+static const size_t SLOT_MASK = (static_cast<size_t>(1) << SLOT_BITS) - 1;
+static const size_t FIRST_SLOT = FACEID_RESERVED_MAX + 1;
+
+/** \brief encodes slot index in low bits and generation in high bits
+ *
+ *  Generation 0 FaceIds equal their slot index, so that FaceIds of a table whose slots
+ *  have not been reused are FACEID_RESERVED_MAX+1, FACEID_RESERVED_MAX+2, and so on.
+ */
+static inline FaceId
+makeFaceId(size_t slot, uint32_t generation)
+{
+  BOOST_ASSERT(slot >= FIRST_SLOT && slot <= SLOT_MASK && generation <= MAX_GENERATION);
+  return static_cast<FaceId>((static_cast<size_t>(generation) << SLOT_BITS) | slot);
+}
+
+/** \return slot index encoded in \p faceId
+ *  \pre faceId >= 0
+ */
+static inline size_t
+getSlotIndex(FaceId faceId)
+{
+  BOOST_ASSERT(faceId >= 0);
+  return static_cast<size_t>(faceId) & SLOT_MASK;
+}
+
 FaceTable::FaceTable(Forwarder& forwarder)
   : m_forwarder(forwarder)
-  , m_lastFaceId(FACEID_RESERVED_MAX)
+  , m_nFaces(0)
 {
+  Slot emptySlot;
+  emptySlot.faceId = INVALID_FACEID;
+  emptySlot.generation = 0;
+  m_slots.assign(FIRST_SLOT, emptySlot);
 }
 
 FaceTable::~FaceTable()
@@ -44,28 +78,59 @@ FaceTable::~FaceTable()
 
 }
 
+size_t
+FaceTable::findSlot(FaceId faceId) const
+{
+  if (faceId < 0) {
+    return m_slots.size();
+  }
+
+  size_t slot = getSlotIndex(faceId);
+  if (slot >= m_slots.size() || m_slots[slot].faceId != faceId) {
+    return m_slots.size();
+  }
+  return slot;
+}
+
 shared_ptr<Face>
 FaceTable::get(FaceId id) const
 {
-  std::map<FaceId, shared_ptr<Face> >::const_iterator i = m_faces.find(id);
-  return (i == m_faces.end()) ? (shared_ptr<Face>()) : (i->second);
+  size_t slot = this->findSlot(id);
+  return slot < m_slots.size() ? m_slots[slot].face : shared_ptr<Face>();
 }
 
-size_t
-FaceTable::size() const
+Face*
+FaceTable::find(FaceId id) const
 {
-  return m_faces.size();
+  size_t slot = this->findSlot(id);
+  return slot < m_slots.size() ? m_slots[slot].face.get() : nullptr;
 }
 
 void
 FaceTable::add(shared_ptr<Face> face, bool isPITless, bool isBridge)
 {
-  if (face->getId() != INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != INVALID_FACEID && this->get(face->getId()) != nullptr) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
 
-  FaceId faceId = ++m_lastFaceId;
+  size_t slot = m_slots.size();
+  if (!m_freeSlots.empty()) {
+    slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  }
+  else {
+    if (slot > SLOT_MASK) {
+      NFD_LOG_WARN("Face table is full, cannot add face remote=" << face->getRemoteUri());
+      return;
+    }
+    Slot emptySlot;
+    emptySlot.faceId = INVALID_FACEID;
+    emptySlot.generation = 0;
+    m_slots.push_back(emptySlot);
+  }
+
+  FaceId faceId = makeFaceId(slot, m_slots[slot].generation);
   BOOST_ASSERT(faceId > FACEID_RESERVED_MAX);
   this->addImpl(face, faceId, isPITless, isBridge);
 }
@@ -74,16 +139,20 @@ void
 FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 {
   BOOST_ASSERT(face->getId() == INVALID_FACEID);
-  BOOST_ASSERT(m_faces.count(face->getId()) == 0);
   BOOST_ASSERT(faceId <= FACEID_RESERVED_MAX);
+  BOOST_ASSERT(m_slots[faceId].face == nullptr);
   this->addImpl(face, faceId);
 }
 
 void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId, bool isPITless, bool isBridge)
 {
+  size_t slot = getSlotIndex(faceId);
+  BOOST_ASSERT(slot < m_slots.size() && m_slots[slot].face == nullptr);
+  m_slots[slot].face = face;
+  m_slots[slot].faceId = faceId;
+  ++m_nFaces;
   face->setId(faceId);
-  m_faces[faceId] = face;
   NFD_LOG_INFO("Added face id=" << faceId << " remote=" << face->getRemoteUri()
                                           << " local=" << face->getLocalUri());
 
@@ -107,22 +176,34 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
 {
   this->onRemove(face);
 
+  // FIB finds the routes through this face by FaceId, so this precedes setId
+  m_forwarder.getFib().removeNextHopFromAllEntries(face);
+
   FaceId faceId = face->getId();
-  m_faces.erase(faceId);
+  size_t slot = this->findSlot(faceId);
+  BOOST_ASSERT(slot < m_slots.size() && m_slots[slot].face == face);
+  m_slots[slot].face.reset();
+  m_slots[slot].faceId = INVALID_FACEID;
+  --m_nFaces;
+  if (slot >= FIRST_SLOT) {
+    // the next face in this slot gets a different FaceId
+    if (++m_slots[slot].generation <= MAX_GENERATION) {
+      m_freeSlots.push_back(slot);
+    }
+  }
   face->setId(INVALID_FACEID);
 
   NFD_LOG_INFO("Removed face id=" << faceId <<
                " remote=" << face->getRemoteUri() <<
                " local=" << face->getLocalUri() <<
                " (" << reason << ")");
-
-  m_forwarder.getFib().removeNextHopFromAllEntries(face);
 }
 
 FaceTable::ForwardRange
 FaceTable::getForwardRange() const
 {
-  return m_faces | boost::adaptors::map_values;
+  return m_slots | boost::adaptors::filtered(IsOccupied())
+                 | boost::adaptors::transformed(GetFace());
 }
 
 FaceTable::const_iterator
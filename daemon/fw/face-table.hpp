@@ -27,7 +27,8 @@
 #define NFD_DAEMON_FW_FACE_TABLE_HPP
 
 #include "face/face.hpp"
-#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 
 namespace nfd {
 
@@ -36,6 +37,18 @@ class PITlessForwarder;
 class BridgeForwarder;
 
 /** \brief container of all Faces
+ *
+ *  Faces are stored in a dense array of slots, and a FaceId identifies a slot and
+ *  a generation of that slot. Lookup by FaceId is a bounds check and a generation check.
+ *  A slot released by a removed face is reused with the next generation, so that
+ *  a FaceId of a removed face never resolves to another face.
+ *  A slot that has exhausted its generations is retired.
+ *
+ *  A FaceId holds the slot index in its low bits, and the generation in its high bits.
+ *  Reserved FaceIds map to the first FACEID_RESERVED_MAX+1 slots.
+ *  Until a slot is reused, FaceIds are dense and sequential from FACEID_RESERVED_MAX+1,
+ *  as with a FaceId counter. A face in a reused slot gets a FaceId in a higher range, e.g.
+ *  FACEID_RESERVED_MAX+1 + 2^23 for the second face in the first dynamic slot.
  */
 class FaceTable : noncopyable
 {
@@ -56,15 +69,58 @@ public:
   VIRTUAL_WITH_TESTS shared_ptr<Face>
   get(FaceId id) const;
 
+  /** \return the face with \p id, or nullptr if there is no such face
+   *
+   *  Unlike get(), this does not share ownership of the face, and does not touch its
+   *  reference count. The pointer is valid until the face is removed.
+   */
+  Face*
+  find(FaceId id) const;
+
   size_t
   size() const;
 
-public: // enumeration
-  typedef std::map<FaceId, shared_ptr<Face>> FaceMap;
+private:
+  /** \brief a slot in the face array
+   *
+   *  Per-face state that is needed on lookup is kept here, in contiguous storage.
+   */
+  struct Slot
+  {
+    shared_ptr<Face> face;
+    FaceId faceId;
+    uint32_t generation; ///< generation of the current or next face in this slot
+  };
+
+  typedef std::vector<Slot> SlotList;
+
+  struct IsOccupied
+  {
+    bool
+    operator()(const Slot& slot) const
+    {
+      return slot.face != nullptr;
+    }
+  };
+
+  struct GetFace
+  {
+    typedef const shared_ptr<Face>& result_type;
+
+    const shared_ptr<Face>&
+    operator()(const Slot& slot) const
+    {
+      return slot.face;
+    }
+  };
 
-  typedef boost::select_second_const_range<FaceMap> ForwardRange;
+public: // enumeration
+  typedef boost::transformed_range<GetFace,
+            const boost::filtered_range<IsOccupied, const SlotList>> ForwardRange;
 
-  /** \brief ForwardIterator for shared_ptr<Face>
+  /** \brief BidirectionalIterator for shared_ptr<Face>, in slot order
+   *
+   *  This is increasing FaceId order among faces of the same generation.
    */
   typedef boost::range_iterator<ForwardRange>::type const_iterator;
 
@@ -97,12 +153,24 @@ private:
   ForwardRange
   getForwardRange() const;
 
+  /** \return slot index of \p faceId, or m_slots.size() if \p faceId does not refer to a slot
+   */
+  size_t
+  findSlot(FaceId faceId) const;
+
 private:
   Forwarder& m_forwarder;
-  FaceId m_lastFaceId;
-  FaceMap m_faces;
+  SlotList m_slots;
+  std::vector<size_t> m_freeSlots;
+  size_t m_nFaces;
 };
 
+inline size_t
+FaceTable::size() const
+{
+  return m_nFaces;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FW_FACE_TABLE_HPP
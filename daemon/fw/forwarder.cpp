@@ -51,6 +51,9 @@ Forwarder::Forwarder()
 {
   fw::installStrategies(*this);
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
+  m_pit.onExpire.connect(bind(&Forwarder::onExpiryTimer, this, _1));
+  // an evicted entry is finalized as if it has expired unsatisfied
+  m_pit.beforeEvict.connect(bind(&Forwarder::onInterestUnsatisfied, this, _1));
   m_interestDelayCallback = 0; // NULL to start
   m_contentDelayCallback = 0; // NULL to start
 }
@@ -60,6 +63,48 @@ Forwarder::~Forwarder()
 
 }
 
+void
+Forwarder::setCsShards(size_t nShards)
+{
+  BOOST_ASSERT(nShards > 0);
+  BOOST_ASSERT(m_cs.size() == 0 && (m_shardedCs == nullptr || m_shardedCs->size() == 0));
+
+  if (nShards == 1) {
+    m_shardedCs.reset();
+    return;
+  }
+
+  std::string policyName = m_cs.getPolicy()->getName();
+  m_shardedCs.reset(new ShardedCs(nShards, m_cs.getLimit(),
+                                  ShardedCs::DEFAULT_ROUTING_PREFIX_LENGTH,
+                                  [policyName] { return cs::makePolicy(policyName); }));
+}
+
+void
+Forwarder::findInCs(const Interest& interest,
+                    const Cs::HitCallback& hitCallback,
+                    const Cs::MissCallback& missCallback)
+{
+  if (m_shardedCs != nullptr) {
+    m_shardedCs->find(interest, this->getHashContext(interest.getName()),
+                      hitCallback, missCallback);
+  }
+  else {
+    m_cs.find(interest, hitCallback, missCallback);
+  }
+}
+
+void
+Forwarder::insertToCs(const Data& data, const name_tree::HashContext& hashes, bool isUnsolicited)
+{
+  if (m_shardedCs != nullptr) {
+    m_shardedCs->insert(data, hashes, isUnsolicited);
+  }
+  else {
+    m_cs.insert(data, hashes, isUnsolicited);
+  }
+}
+
 void
 Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 {
@@ -88,12 +133,28 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   }
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest, inFace.getId(),
+                                                 this->getHashContext(interest.getName())).first;
+  if (pitEntry == nullptr) {
+    // PIT is full, or inFace has reached its quota
+    NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
+                  " interest=" << interest.getName() << " rejected by PIT");
+    // (drop)
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float> duration = end - start;
+
+    if (m_interestDelayCallback != 0) {
+      m_interestDelayCallback(m_id, ns3::Simulator::Now(), duration.count());
+    }
+    return;
+  }
 
   // detect duplicate Nonce
+  // (Dead Nonce List reuses the Name hash computed by NameTree during PIT insert)
   int dnw = pitEntry->findNonce(interest.getNonce(), inFace);
   bool hasDuplicateNonce = (dnw != pit::DUPLICATE_NONCE_NONE) ||
-                           m_deadNonceList.has(interest.getName(), interest.getNonce());
+                           m_deadNonceList.has(m_nameTree.get(*pitEntry)->getHash(),
+                                               pitEntry->getName().size(), interest.getNonce());
   if (hasDuplicateNonce) {
     // goto Interest loop pipeline
     this->onInterestLoop(inFace, interest, pitEntry);
@@ -114,9 +175,9 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   bool isPending = inRecords.begin() != inRecords.end();
   if (!isPending) {
     if (m_csFromNdnSim == nullptr) {
-      m_cs.find(interest,
-                bind(&Forwarder::onContentStoreHit, this, ref(inFace), pitEntry, _1, _2),
-                bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
+      this->findInCs(interest,
+                     bind(&Forwarder::onContentStoreHit, this, ref(inFace), pitEntry, _1, _2),
+                     bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
     }
     else {
       shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
@@ -332,7 +393,8 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   }
 
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  const name_tree::HashContext& hashes = this->getHashContext(data.getName());
+  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data, hashes);
   if (pitMatches.begin() == pitMatches.end()) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(inFace, data);
@@ -345,22 +407,26 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
-  // - reduce amount of memory used by cached entries
-  // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
-  //
-  // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
-  // pointing to the same underlying memory buffer.
-  shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
-  dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
-
   // CS insert
-  if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutPacket);
-  else
+  if (m_csFromNdnSim == nullptr) {
+    // NFD's CS keeps only the wire encoding, so neither a copy nor tag removal is needed
+    this->insertToCs(data, hashes);
+  }
+  else {
+    // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
+    // - reduce amount of memory used by cached entries
+    // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
+    //
+    // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
+    // pointing to the same underlying memory buffer.
+    shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
+    dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
     m_csFromNdnSim->Add(dataCopyWithoutPacket);
+  }
 
-  std::set<shared_ptr<Face> > pendingDownstreams;
+  // pending downstreams are few, so a linear scan of an inline array beats std::set
+  SmallVector<shared_ptr<Face>, 8> pendingDownstreams;
+  const time::steady_clock::TimePoint now = time::steady_clock::now();
   // foreach PitEntry
   for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
@@ -372,8 +438,10 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
     for (pit::InRecordCollection::const_iterator it = inRecords.begin();
                                                  it != inRecords.end(); ++it) {
-      if (it->getExpiry() > time::steady_clock::now()) {
-        pendingDownstreams.insert(it->getFace());
+      if (it->getExpiry() > now &&
+          std::find(pendingDownstreams.begin(), pendingDownstreams.end(),
+                    it->getFace()) == pendingDownstreams.end()) {
+        pendingDownstreams.push_back(it->getFace());
       }
     }
 
@@ -394,9 +462,7 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   }
 
   // foreach pending downstream
-  for (std::set<shared_ptr<Face> >::iterator it = pendingDownstreams.begin();
-      it != pendingDownstreams.end(); ++it) {
-    shared_ptr<Face> pendingDownstream = *it;
+  for (const shared_ptr<Face>& pendingDownstream : pendingDownstreams) {
     if (pendingDownstream.get() == &inFace) {
       continue;
     }
@@ -420,7 +486,7 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
   if (acceptToCache) {
     // CS insert
     if (m_csFromNdnSim == nullptr)
-      m_cs.insert(data, true);
+      this->insertToCs(data, this->getHashContext(data.getName()), true);
     else
       m_csFromNdnSim->Add(data.shared_from_this());
   }
@@ -476,9 +542,8 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
     // TODO all InRecords are already expired; will this happen?
   }
 
-  scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  pitEntry->m_unsatisfyTimer = scheduler::schedule(lastExpiryFromNow,
-    bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
+  pitEntry->m_isStraggler = false;
+  m_pit.setExpiryTimer(*pitEntry, lastExpiryFromNow);
 }
 
 void
@@ -487,23 +552,34 @@ Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
 {
   time::nanoseconds stragglerTime = time::milliseconds(100);
 
-  scheduler::cancel(pitEntry->m_stragglerTimer);
-  pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
-    bind(&Forwarder::onInterestFinalize, this, pitEntry, isSatisfied, dataFreshnessPeriod));
+  pitEntry->m_isStraggler = true;
+  pitEntry->m_isSatisfied = isSatisfied;
+  pitEntry->m_dataFreshnessPeriod = dataFreshnessPeriod;
+  m_pit.setExpiryTimer(*pitEntry, stragglerTime);
 }
 
 void
 Forwarder::cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry)
 {
-  scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  scheduler::cancel(pitEntry->m_stragglerTimer);
+  m_pit.cancelExpiryTimer(*pitEntry);
+}
+
+void
+Forwarder::onExpiryTimer(shared_ptr<pit::Entry> pitEntry)
+{
+  if (pitEntry->m_isStraggler) {
+    this->onInterestFinalize(pitEntry, pitEntry->m_isSatisfied, pitEntry->m_dataFreshnessPeriod);
+  }
+  else {
+    this->onInterestUnsatisfied(pitEntry);
+  }
 }
 
 static inline void
-insertNonceToDnl(DeadNonceList& dnl, const pit::Entry& pitEntry,
+insertNonceToDnl(DeadNonceList& dnl, size_t nameHash, size_t nComponents,
                  const pit::OutRecord& outRecord)
 {
-  dnl.add(pitEntry.getName(), outRecord.getLastNonce());
+  dnl.add(nameHash, nComponents, outRecord.getLastNonce());
 }
 
 void
@@ -528,17 +604,19 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
   }
 
   // Dead Nonce List insert
+  size_t nameHash = m_nameTree.get(pitEntry)->getHash();
+  size_t nComponents = pitEntry.getName().size();
   if (upstream == 0) {
     // insert all outgoing Nonces
     const pit::OutRecordCollection& outRecords = pitEntry.getOutRecords();
     std::for_each(outRecords.begin(), outRecords.end(),
-                  bind(&insertNonceToDnl, ref(m_deadNonceList), cref(pitEntry), _1));
+                  bind(&insertNonceToDnl, ref(m_deadNonceList), nameHash, nComponents, _1));
   }
   else {
     // insert outgoing Nonce of a specific face
     pit::OutRecordCollection::const_iterator outRecord = pitEntry.getOutRecord(*upstream);
     if (outRecord != pitEntry.getOutRecords().end()) {
-      m_deadNonceList.add(pitEntry.getName(), outRecord->getLastNonce());
+      m_deadNonceList.add(nameHash, nComponents, outRecord->getLastNonce());
     }
   }
 }
@@ -33,6 +33,7 @@
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 #include "table/cs.hpp"
+#include "table/cs-sharded.hpp"
 #include "table/measurements.hpp"
 #include "table/strategy-choice.hpp"
 #include "table/dead-nonce-list.hpp"
@@ -116,6 +117,22 @@ public: // forwarding entrypoints and tables
   Cs&
   getCs();
 
+  /** \return the sharded ContentStore, or nullptr if ContentStore is not sharded
+   *
+   *  When the ContentStore is sharded, forwarding pipelines use it instead of getCs().
+   */
+  ShardedCs*
+  getShardedCs();
+
+  /** \brief partitions the ContentStore into \p nShards shards
+   *
+   *  The sharded ContentStore takes the capacity and replacement policy of getCs().
+   *  \param nShards number of shards; 1 returns to the unsharded getCs()
+   *  \pre ContentStore is empty
+   */
+  void
+  setCsShards(size_t nShards);
+
   Measurements&
   getMeasurements();
 
@@ -125,6 +142,16 @@ public: // forwarding entrypoints and tables
   DeadNonceList&
   getDeadNonceList();
 
+  /** \return hashes of every prefix of \p name
+   *
+   *  The Forwarder keeps one HashContext, which is recomputed in place when \p name differs
+   *  from the Name it was computed from, so that the tables and the strategy reuse
+   *  the hashes of the packet being processed without allocating.
+   *  The returned reference is valid until the next call with a different Name.
+   */
+  const name_tree::HashContext&
+  getHashContext(const Name& name);
+
 public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs);
@@ -206,6 +233,20 @@ protected:
   VIRTUAL_WITH_TESTS void
   onOutgoingData(const Data& data, Face& outFace);
 
+protected:
+  /** \brief looks up \p interest in the ContentStore in use
+   */
+  void
+  findInCs(const Interest& interest,
+           const Cs::HitCallback& hitCallback,
+           const Cs::MissCallback& missCallback);
+
+  /** \brief inserts \p data into the ContentStore in use
+   *  \param hashes must be computed from Data Name
+   */
+  void
+  insertToCs(const Data& data, const name_tree::HashContext& hashes, bool isUnsolicited = false);
+
 protected:
   VIRTUAL_WITH_TESTS void
   setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry);
@@ -217,6 +258,11 @@ protected:
   VIRTUAL_WITH_TESTS void
   cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief dispatches an expired PIT entry to the pipeline of its unsatisfy or straggler timer
+   */
+  void
+  onExpiryTimer(shared_ptr<pit::Entry> pitEntry);
+
   /** \brief insert Nonce to Dead Nonce List if necessary
    *  \param upstream if null, insert Nonces from all OutRecords;
    *                  if not null, insert Nonce only on the OutRecord of this face
@@ -250,6 +296,8 @@ protected:
   StrategyChoice m_strategyChoice;
   DeadNonceList  m_deadNonceList;
   shared_ptr<NullFace> m_csFace;
+  name_tree::HashContext m_hashContext;
+  unique_ptr<ShardedCs> m_shardedCs;
 
 
 
@@ -337,6 +385,12 @@ Forwarder::getCs()
   return m_cs;
 }
 
+inline ShardedCs*
+Forwarder::getShardedCs()
+{
+  return m_shardedCs.get();
+}
+
 inline Measurements&
 Forwarder::getMeasurements()
 {
@@ -355,6 +409,15 @@ Forwarder::getDeadNonceList()
   return m_deadNonceList;
 }
 
+inline const name_tree::HashContext&
+Forwarder::getHashContext(const Name& name)
+{
+  if (!m_hashContext.matches(name)) {
+    m_hashContext.reset(name);
+  }
+  return m_hashContext;
+}
+
 inline void
 Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
 {
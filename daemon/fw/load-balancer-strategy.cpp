@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "load-balancer-strategy.hpp"
+#include "table/name-tree.hpp"
+#include "core/logger.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("LoadBalancerStrategy");
+
+const Name LoadBalancerStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/load-balancer/%FD%01");
+NFD_REGISTER_STRATEGY(LoadBalancerStrategy);
+
+const time::nanoseconds LoadBalancerStrategy::MEASUREMENTS_LIFETIME = time::seconds(16);
+const double LoadBalancerStrategy::RTT_GAIN = 0.125;
+const int LoadBalancerStrategy::WEIGHT_LEVELS = 8;
+
+LoadBalancerStrategy::LoadBalancerStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder, name)
+  , m_hashPrefixLength(-1)
+{
+}
+
+void
+LoadBalancerStrategy::setHashPrefixLength(ssize_t prefixLength)
+{
+  m_hashPrefixLength = prefixLength;
+}
+
+size_t
+LoadBalancerStrategy::computeFlowHash(const Interest& interest) const
+{
+  size_t nComps = interest.getName().size();
+  size_t prefixLen = 0;
+  if (m_hashPrefixLength > 0) {
+    prefixLen = std::min(nComps, static_cast<size_t>(m_hashPrefixLength));
+  }
+  else {
+    prefixLen = nComps - std::min(nComps, static_cast<size_t>(-m_hashPrefixLength));
+  }
+
+  // Forwarder has computed the hash of every prefix during PIT insertion
+  return this->getForwarder().getHashContext(interest.getName()).getHash(prefixLen);
+}
+
+double
+LoadBalancerStrategy::computeScore(size_t flowHash, FaceId faceId, double weight)
+{
+  // mix flowHash with FaceId (splitmix64 finalizer)
+  uint64_t h = static_cast<uint64_t>(flowHash) ^
+               (static_cast<uint64_t>(faceId) * UINT64_C(0x9e3779b97f4a7c15));
+  h ^= h >> 30;
+  h *= UINT64_C(0xbf58476d1ce4e5b9);
+  h ^= h >> 27;
+  h *= UINT64_C(0x94d049bb133111eb);
+  h ^= h >> 31;
+
+  // uniform in (0,1)
+  double u = (static_cast<double>(h >> 11) + 0.5) / static_cast<double>(UINT64_C(1) << 53);
+
+  // weighted rendezvous hashing: the upstream with highest score wins,
+  // with probability proportional to its weight
+  return -weight / std::log(u);
+}
+
+void
+LoadBalancerStrategy::MtInfo::addRtt(FaceId faceId, time::nanoseconds rtt)
+{
+  double sample = static_cast<double>(time::duration_cast<time::microseconds>(rtt).count());
+  auto it = srtt.find(faceId);
+  if (it == srtt.end()) {
+    srtt[faceId] = sample;
+  }
+  else {
+    it->second += RTT_GAIN * (sample - it->second);
+  }
+}
+
+double
+LoadBalancerStrategy::MtInfo::getSrtt(FaceId faceId) const
+{
+  auto it = srtt.find(faceId);
+  if (it == srtt.end()) {
+    return 0.0;
+  }
+  return it->second;
+}
+
+/** \brief determines whether a NextHop is eligible
+ *  \param faceTable resolves the face of NextHop
+ *  \param currentDownstream incoming FaceId of current Interest
+ *  \param wantUnused if true, NextHop must not have unexpired OutRecord
+ *  \param now time::steady_clock::now(), ignored if !wantUnused
+ */
+static inline bool
+predicate_NextHop_eligible(const pit::Entry& pitEntry, const FaceTable& faceTable,
+                           const fib::NextHop& nexthop,
+                           FaceId currentDownstream, bool wantUnused,
+                           const time::steady_clock::TimePoint& now)
+{
+  // upstream is current downstream
+  if (nexthop.getFaceId() == currentDownstream)
+    return false;
+
+  // upstream has been removed
+  Face* upstreamPtr = faceTable.find(nexthop.getFaceId());
+  if (upstreamPtr == nullptr)
+    return false;
+  Face& upstream = *upstreamPtr;
+
+  // forwarding would violate scope
+  if (pitEntry.violatesScope(upstream))
+    return false;
+
+  if (wantUnused) {
+    // NextHop must not have unexpired OutRecord
+    pit::OutRecordCollection::const_iterator outRecord = pitEntry.getOutRecord(upstream);
+    if (outRecord != pitEntry.getOutRecords().end() &&
+        outRecord->getExpiry() > now) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/** \brief pick the eligible NextHop with lowest cost, and highest rendezvous score among
+ *         NextHops of that cost
+ *  \param mi RTT measurements, may be nullptr
+ *  \return the NextHop, or nullptr if no NextHop is eligible
+ */
+static const fib::NextHop*
+findBestNextHop(const pit::Entry& pitEntry, const FaceTable& faceTable,
+                const fib::NextHopList& nexthops,
+                FaceId currentDownstream, bool wantUnused, size_t flowHash,
+                const LoadBalancerStrategy::MtInfo* mi)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  // lowest cost, and lowest smoothed RTT among nexthops of that cost
+  uint64_t lowestCost = std::numeric_limits<uint64_t>::max();
+  double lowestSrtt = std::numeric_limits<double>::max();
+  for (const fib::NextHop& nexthop : nexthops) {
+    if (nexthop.getCost() > lowestCost ||
+        !predicate_NextHop_eligible(pitEntry, faceTable, nexthop, currentDownstream,
+                                    wantUnused, now)) {
+      continue;
+    }
+    if (nexthop.getCost() < lowestCost) {
+      lowestCost = nexthop.getCost();
+      lowestSrtt = std::numeric_limits<double>::max();
+    }
+    double srtt = mi == nullptr ? 0.0 : mi->getSrtt(nexthop.getFaceId());
+    if (srtt > 0.0) {
+      lowestSrtt = std::min(lowestSrtt, srtt);
+    }
+  }
+
+  const fib::NextHop* best = nullptr;
+  double bestScore = 0.0;
+  for (const fib::NextHop& nexthop : nexthops) {
+    if (nexthop.getCost() != lowestCost ||
+        !predicate_NextHop_eligible(pitEntry, faceTable, nexthop, currentDownstream,
+                                    wantUnused, now)) {
+      continue;
+    }
+
+    double weight = 1.0;
+    double srtt = mi == nullptr ? 0.0 : mi->getSrtt(nexthop.getFaceId());
+    if (srtt > 0.0) {
+      double level = std::round(LoadBalancerStrategy::WEIGHT_LEVELS * lowestSrtt / srtt);
+      weight = std::max(1.0, level) / LoadBalancerStrategy::WEIGHT_LEVELS;
+    }
+
+    double score = LoadBalancerStrategy::computeScore(flowHash, nexthop.getFaceId(), weight);
+    if (best == nullptr || score > bestScore) {
+      best = &nexthop;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+void
+LoadBalancerStrategy::afterReceiveInterest(const Face& inFace,
+                                           const Interest& interest,
+                                           shared_ptr<fib::Entry> fibEntry,
+                                           shared_ptr<pit::Entry> pitEntry)
+{
+  const FaceTable& faceTable = this->getFaceTable();
+  const fib::NextHopList& nexthops = fibEntry->getNextHops();
+  if (nexthops.empty()) {
+    // this also covers Fib::s_emptyEntry, which has no Measurements entry
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+    this->rejectPendingInterest(pitEntry);
+    return;
+  }
+
+  RetxSuppression::Result suppression =
+      m_retxSuppression.decide(inFace, interest, *pitEntry);
+  if (suppression == RetxSuppression::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " suppressed");
+    return;
+  }
+
+  shared_ptr<MtInfo> mi;
+  shared_ptr<measurements::Entry> me = this->getMeasurements().get(*fibEntry);
+  if (me != nullptr) {
+    this->getMeasurements().extendLifetime(*me, MEASUREMENTS_LIFETIME);
+    mi = me->getOrCreateStrategyInfo<MtInfo>();
+  }
+
+  size_t flowHash = this->computeFlowHash(interest);
+
+  if (suppression == RetxSuppression::NEW) {
+    const fib::NextHop* nexthop = findBestNextHop(*pitEntry, faceTable, nexthops, inFace.getId(),
+                                                  false, flowHash, mi.get());
+    if (nexthop == nullptr) {
+      NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+      this->rejectPendingInterest(pitEntry);
+      return;
+    }
+
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
+                           << " newPitEntry-to=" << nexthop->getFaceId());
+    this->sendInterest(pitEntry, *faceTable.find(nexthop->getFaceId()));
+    return;
+  }
+
+  // find the highest ranked unused upstream
+  const fib::NextHop* nexthop = findBestNextHop(*pitEntry, faceTable, nexthops, inFace.getId(),
+                                                true, flowHash, mi.get());
+  if (nexthop != nullptr) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
+                           << " retransmit-unused-to=" << nexthop->getFaceId());
+    this->sendInterest(pitEntry, *faceTable.find(nexthop->getFaceId()));
+    return;
+  }
+
+  // all upstreams have been used, start over
+  nexthop = findBestNextHop(*pitEntry, faceTable, nexthops, inFace.getId(), false, flowHash,
+                            mi.get());
+  if (nexthop == nullptr) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmitNoNextHop");
+    return;
+  }
+
+  NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
+                         << " retransmit-retry-to=" << nexthop->getFaceId());
+  this->sendInterest(pitEntry, *faceTable.find(nexthop->getFaceId()));
+}
+
+void
+LoadBalancerStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                                            const Face& inFace, const Data& data)
+{
+  pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
+  if (outRecord == pitEntry->getOutRecords().end()) { // no OutRecord
+    return;
+  }
+
+  shared_ptr<measurements::Entry> me = this->getMeasurements().findLongestPrefixMatch(*pitEntry,
+    measurements::EntryWithStrategyInfo<MtInfo>());
+  if (me == nullptr) {
+    return;
+  }
+
+  time::nanoseconds rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+  NFD_LOG_DEBUG(pitEntry->getInterest() << " dataFrom " << inFace.getId() <<
+                " rtt=" << time::duration_cast<time::microseconds>(rtt).count());
+  me->getStrategyInfo<MtInfo>()->addRtt(inFace.getId(), rtt);
+}
+
+void
+LoadBalancerStrategy::beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry)
+{
+  shared_ptr<measurements::Entry> me = this->getMeasurements().findLongestPrefixMatch(*pitEntry,
+    measurements::EntryWithStrategyInfo<MtInfo>());
+  if (me == nullptr) {
+    return;
+  }
+
+  // upstreams that did not answer are charged the time they have been waiting
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  shared_ptr<MtInfo> mi = me->getStrategyInfo<MtInfo>();
+  for (const pit::OutRecord& outRecord : pitEntry->getOutRecords()) {
+    NFD_LOG_DEBUG(pitEntry->getInterest() << " timeoutFrom " << outRecord.getFace()->getId());
+    mi->addRtt(outRecord.getFace()->getId(), now - outRecord.getLastRenewed());
+  }
+}
+
+} // namespace fw
+} // namespace nfd
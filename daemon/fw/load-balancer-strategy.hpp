@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_LOAD_BALANCER_STRATEGY_HPP
+#define NFD_DAEMON_FW_LOAD_BALANCER_STRATEGY_HPP
+
+#include "strategy.hpp"
+#include "retx-suppression-exponential.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief Load Balancer strategy version 1
+ *
+ *  This strategy spreads Interests across the lowest-cost nexthops (except downstream)
+ *  with weighted rendezvous hashing on a prefix of the Interest Name.
+ *  Interests sharing that prefix, such as segments of one object, are forwarded to
+ *  the same upstream as long as the nexthops and their weights are unchanged,
+ *  so that each upstream caches a distinct portion of the content.
+ *  When a nexthop is added or removed, only the flows that rank it highest are moved.
+ *
+ *  The weight of an upstream is inversely proportional to its smoothed RTT,
+ *  measured on Data retrieved under the FIB prefix, so that a congested upstream
+ *  receives less traffic. An upstream that does not answer before the PIT entry expires
+ *  is charged the time it has been waiting as an RTT sample.
+ *  Weights are quantized so that small RTT variations do not move flows. An upstream without RTT samples has the highest weight.
+ *  RTT measurements are kept in the Measurements entry of the FIB prefix.
+ *
+ *  If consumer retransmits the Interest (and is not suppressed according to
+ *  exponential backoff algorithm), the strategy forwards the Interest to the highest
+ *  ranked upstream that is not previously used. If all upstreams have been used,
+ *  the Interest is forwarded to the highest ranked upstream again.
+ */
+class LoadBalancerStrategy : public Strategy
+{
+public:
+  LoadBalancerStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  /** \brief set the length of the Interest Name prefix that is hashed
+   *  \param prefixLength a positive value is the number of leading components;
+   *         a non-positive value excludes -prefixLength trailing components
+   *
+   *  The default is -1, which excludes the last component (usually the segment number).
+   */
+  void
+  setHashPrefixLength(ssize_t prefixLength);
+
+  ssize_t
+  getHashPrefixLength() const;
+
+public: // triggers
+  virtual void
+  afterReceiveInterest(const Face& inFace,
+                       const Interest& interest,
+                       shared_ptr<fib::Entry> fibEntry,
+                       shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  virtual void
+  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                        const Face& inFace, const Data& data) DECL_OVERRIDE;
+
+  virtual void
+  beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // StrategyInfo
+  /** \brief StrategyInfo in measurements table
+   */
+  class MtInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1030;
+    }
+
+    /** \brief add an RTT sample of \p faceId
+     */
+    void
+    addRtt(FaceId faceId, time::nanoseconds rtt);
+
+    /** \return smoothed RTT of \p faceId in microseconds, or 0 if there is no sample
+     */
+    double
+    getSrtt(FaceId faceId) const;
+
+  public:
+    /// smoothed RTT in microseconds, per upstream
+    std::map<FaceId, double> srtt;
+  };
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // ranking
+  /** \return rendezvous score of an upstream for a flow
+   *  \param flowHash hash of the Name prefix of the flow
+   *  \param weight weight of the upstream, in (0,1]
+   */
+  static double
+  computeScore(size_t flowHash, FaceId faceId, double weight);
+
+  /** \return hash of the Name prefix that identifies the flow of \p interest
+   */
+  size_t
+  computeFlowHash(const Interest& interest) const;
+
+public:
+  static const Name STRATEGY_NAME;
+
+  /// lifetime of Measurements entry that holds MtInfo
+  static const time::nanoseconds MEASUREMENTS_LIFETIME;
+
+  /// gain of the smoothed RTT
+  static const double RTT_GAIN;
+
+  /// weights are quantized to multiples of 1/WEIGHT_LEVELS
+  static const int WEIGHT_LEVELS;
+
+private:
+  ssize_t m_hashPrefixLength;
+  RetxSuppressionExponential m_retxSuppression;
+};
+
+inline ssize_t
+LoadBalancerStrategy::getHashPrefixLength() const
+{
+  return m_hashPrefixLength;
+}
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_LOAD_BALANCER_STRATEGY_HPP
@@ -45,9 +45,9 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
 
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    shared_ptr<Face> outFace = it->getFace();
-    if (pitEntry->canForwardTo(*outFace)) {
-      this->sendInterest(pitEntry, outFace);
+    Face* outFace = this->getFaceTable().find(it->getFaceId());
+    if (outFace != nullptr && pitEntry->canForwardTo(*outFace)) {
+      this->sendInterest(pitEntry, *outFace);
     }
   }
 
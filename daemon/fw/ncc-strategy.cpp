@@ -86,12 +86,12 @@ NccStrategy::afterReceiveInterest(const Face& inFace,
   }
   else {
     // use first eligible nexthop
-    auto firstEligibleNexthop = std::find_if(nexthops.begin(), nexthops.end(),
-        [&pitEntry] (const fib::NextHop& nexthop) {
-          return pitEntry->canForwardTo(*nexthop.getFace());
-        });
-    if (firstEligibleNexthop != nexthops.end()) {
-      this->sendInterest(pitEntry, firstEligibleNexthop->getFace());
+    for (const fib::NextHop& nexthop : nexthops) {
+      Face* face = this->getFaceTable().find(nexthop.getFaceId());
+      if (face != nullptr && pitEntry->canForwardTo(*face)) {
+        this->sendInterest(pitEntry, *face);
+        break;
+      }
     }
   }
 
@@ -145,10 +145,10 @@ NccStrategy::doPropagate(weak_ptr<pit::Entry> pitEntryWeak, weak_ptr<fib::Entry>
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   bool isForwarded = false;
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    shared_ptr<Face> face = it->getFace();
-    if (pitEntry->canForwardTo(*face)) {
+    Face* face = this->getFaceTable().find(it->getFaceId());
+    if (face != nullptr && pitEntry->canForwardTo(*face)) {
       isForwarded = true;
-      this->sendInterest(pitEntry, face);
+      this->sendInterest(pitEntry, *face);
       break;
     }
   }
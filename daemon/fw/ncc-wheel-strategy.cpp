@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ncc-wheel-strategy.hpp"
+#include "core/random.hpp"
+#include <boost/random/uniform_int_distribution.hpp>
+
+namespace nfd {
+namespace fw {
+
+const Name NccWheelStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/ncc-wheel/%FD%01");
+NFD_REGISTER_STRATEGY(NccWheelStrategy);
+
+const time::nanoseconds NccWheelStrategy::TIMER_TICK = time::microseconds(100);
+
+NccWheelStrategy::NccWheelStrategy(Forwarder& forwarder, const Name& name)
+  : NccStrategy(forwarder, name)
+  , m_timerWheel(bind(&NccWheelStrategy::onTimer, this, _1), TIMER_TICK)
+{
+}
+
+NccWheelStrategy::~NccWheelStrategy()
+{
+}
+
+void
+NccWheelStrategy::afterReceiveInterest(const Face& inFace,
+                                       const Interest& interest,
+                                       shared_ptr<fib::Entry> fibEntry,
+                                       shared_ptr<pit::Entry> pitEntry)
+{
+  const fib::NextHopList& nexthops = fibEntry->getNextHops();
+  if (nexthops.size() == 0) {
+    this->rejectPendingInterest(pitEntry);
+    return;
+  }
+
+  shared_ptr<PitEntryInfo> pitEntryInfo =
+    pitEntry->getOrCreateStrategyInfo<PitEntryInfo>();
+  bool isNewPitEntry = !pitEntry->hasUnexpiredOutRecords();
+  if (!isNewPitEntry) {
+    return;
+  }
+
+  shared_ptr<MeasurementsEntryInfo> measurementsEntryInfo =
+    this->getMeasurementsEntryInfo(pitEntry);
+
+  time::microseconds deferFirst = DEFER_FIRST_WITHOUT_BEST_FACE;
+  time::microseconds deferRange = DEFER_RANGE_WITHOUT_BEST_FACE;
+  size_t nUpstreams = nexthops.size();
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  pitEntryInfo->pitEntry = pitEntry;
+  pitEntryInfo->fibEntry = fibEntry;
+  pitEntryInfo->wheel = &m_timerWheel;
+
+  shared_ptr<Face> bestFace = measurementsEntryInfo->getBestFace();
+  if (static_cast<bool>(bestFace) && fibEntry->hasNextHop(bestFace) &&
+      pitEntry->canForwardTo(*bestFace)) {
+    deferFirst = measurementsEntryInfo->prediction;
+    deferRange = time::microseconds((deferFirst.count() + 1) / 2);
+    --nUpstreams;
+    this->sendInterest(pitEntry, bestFace);
+    pitEntryInfo->bestFaceDeadline = now + measurementsEntryInfo->prediction;
+  }
+  else {
+    // use first eligible nexthop
+    for (const fib::NextHop& nexthop : nexthops) {
+      Face* face = this->getFaceTable().find(nexthop.getFaceId());
+      if (face != nullptr && pitEntry->canForwardTo(*face)) {
+        this->sendInterest(pitEntry, *face);
+        break;
+      }
+    }
+  }
+
+  shared_ptr<Face> previousFace = measurementsEntryInfo->previousFace.lock();
+  if (static_cast<bool>(previousFace) && fibEntry->hasNextHop(previousFace) &&
+      pitEntry->canForwardTo(*previousFace)) {
+    --nUpstreams;
+  }
+
+  if (nUpstreams > 0) {
+    pitEntryInfo->maxInterval = std::max(time::microseconds(1),
+      time::microseconds((2 * deferRange.count() + nUpstreams - 1) / nUpstreams));
+  }
+  else {
+    // see NccStrategy::afterReceiveInterest (bug 1853)
+    pitEntryInfo->maxInterval = deferFirst;
+  }
+  pitEntryInfo->propagateDeadline = now + deferFirst;
+  this->armTimer(*pitEntryInfo);
+}
+
+void
+NccWheelStrategy::armTimer(PitEntryInfo& pitEntryInfo)
+{
+  time::steady_clock::TimePoint deadline = std::min(pitEntryInfo.bestFaceDeadline,
+                                                    pitEntryInfo.propagateDeadline);
+  if (deadline == time::steady_clock::TimePoint::max()) {
+    m_timerWheel.cancel(pitEntryInfo);
+    return;
+  }
+
+  time::nanoseconds after = deadline - time::steady_clock::now();
+  m_timerWheel.arm(pitEntryInfo, std::max(after, time::nanoseconds::zero()));
+}
+
+void
+NccWheelStrategy::onTimer(const shared_ptr<PitEntryInfo>& pitEntryInfo)
+{
+  shared_ptr<pit::Entry> pitEntry = pitEntryInfo->pitEntry.lock();
+  if (!static_cast<bool>(pitEntry)) {
+    return;
+  }
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  if (pitEntryInfo->bestFaceDeadline <= now) {
+    pitEntryInfo->bestFaceDeadline = time::steady_clock::TimePoint::max();
+    this->timeoutOnBestFace(pitEntry);
+  }
+  if (pitEntryInfo->propagateDeadline <= now) {
+    pitEntryInfo->propagateDeadline = time::steady_clock::TimePoint::max();
+    this->doPropagate(pitEntry, *pitEntryInfo);
+  }
+  this->armTimer(*pitEntryInfo);
+}
+
+void
+NccWheelStrategy::doPropagate(const shared_ptr<pit::Entry>& pitEntry, PitEntryInfo& pitEntryInfo)
+{
+  shared_ptr<fib::Entry> fibEntry = pitEntryInfo.fibEntry.lock();
+  if (!static_cast<bool>(fibEntry)) {
+    return;
+  }
+
+  shared_ptr<MeasurementsEntryInfo> measurementsEntryInfo =
+    this->getMeasurementsEntryInfo(pitEntry);
+
+  shared_ptr<Face> previousFace = measurementsEntryInfo->previousFace.lock();
+  if (static_cast<bool>(previousFace) && fibEntry->hasNextHop(previousFace) &&
+      pitEntry->canForwardTo(*previousFace)) {
+    this->sendInterest(pitEntry, previousFace);
+  }
+
+  const fib::NextHopList& nexthops = fibEntry->getNextHops();
+  bool isForwarded = false;
+  for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
+    Face* face = this->getFaceTable().find(it->getFaceId());
+    if (face != nullptr && pitEntry->canForwardTo(*face)) {
+      isForwarded = true;
+      this->sendInterest(pitEntry, *face);
+      break;
+    }
+  }
+
+  if (isForwarded) {
+    boost::random::uniform_int_distribution<time::nanoseconds::rep> dist(0,
+      pitEntryInfo.maxInterval.count() - 1);
+    time::nanoseconds deferNext = time::nanoseconds(dist(getGlobalRng()));
+    pitEntryInfo.propagateDeadline = time::steady_clock::now() + deferNext;
+  }
+}
+
+void
+NccWheelStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                                        const Face& inFace, const Data& data)
+{
+  if (pitEntry->getInRecords().empty()) {
+    // PIT entry has already been satisfied (and is now waiting for straggler timer to expire)
+    return;
+  }
+
+  this->NccStrategy::beforeSatisfyInterest(pitEntry, inFace, data);
+
+  shared_ptr<PitEntryInfo> pitEntryInfo = pitEntry->getStrategyInfo<PitEntryInfo>();
+  if (static_cast<bool>(pitEntryInfo)) {
+    pitEntryInfo->propagateDeadline = time::steady_clock::TimePoint::max();
+    this->armTimer(*pitEntryInfo);
+  }
+}
+
+NccWheelStrategy::PitEntryInfo::PitEntryInfo()
+  : bestFaceDeadline(time::steady_clock::TimePoint::max())
+  , propagateDeadline(time::steady_clock::TimePoint::max())
+  , wheel(nullptr)
+{
+}
+
+NccWheelStrategy::PitEntryInfo::~PitEntryInfo()
+{
+  if (wheel != nullptr && TimerWheel<PitEntryInfo>::isArmed(*this)) {
+    wheel->cancel(*this);
+  }
+}
+
+} // namespace fw
+} // namespace nfd
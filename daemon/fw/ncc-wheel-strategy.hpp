@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_NCC_WHEEL_STRATEGY_HPP
+#define NFD_DAEMON_FW_NCC_WHEEL_STRATEGY_HPP
+
+#include "ncc-strategy.hpp"
+#include "core/timer-wheel.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief a variant of NccStrategy that keeps its timers on a timing wheel
+ *
+ *  Forwarding decisions are identical to NccStrategy. The best face timeout and the
+ *  propagation timer of each PIT entry are stored inline in PitEntryInfo, and are driven
+ *  by one TimerWheel per strategy instance instead of one scheduler event per timer.
+ *  Arming and cancelling a timer therefore allocate no memory, and timers that are due
+ *  in the same tick fire as one batch.
+ *
+ *  The wheel has a resolution of TIMER_TICK, so a timer may fire up to one tick late.
+ */
+class NccWheelStrategy : public NccStrategy
+{
+public:
+  NccWheelStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual
+  ~NccWheelStrategy();
+
+  virtual void
+  afterReceiveInterest(const Face& inFace,
+                       const Interest& interest,
+                       shared_ptr<fib::Entry> fibEntry,
+                       shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  virtual void
+  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                        const Face& inFace, const Data& data) DECL_OVERRIDE;
+
+protected:
+  /// StrategyInfo on pit::Entry
+  class PitEntryInfo : public StrategyInfo
+                     , public TimerWheelHook<PitEntryInfo>
+                     , public enable_shared_from_this<PitEntryInfo>
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1002;
+    }
+
+    PitEntryInfo();
+
+    virtual
+    ~PitEntryInfo();
+
+  public:
+    weak_ptr<pit::Entry> pitEntry;
+    weak_ptr<fib::Entry> fibEntry;
+    /// when best face does not respond within predicted time, or TimePoint::max() if unset
+    time::steady_clock::TimePoint bestFaceDeadline;
+    /// when to propagate to another face, or TimePoint::max() if unset
+    time::steady_clock::TimePoint propagateDeadline;
+    /// maximum interval between forwarding to two nexthops except best and previous
+    time::microseconds maxInterval;
+    /// the wheel this entry is armed on
+    TimerWheel<PitEntryInfo>* wheel;
+  };
+
+  /// arms the timer for the earlier deadline of \p pitEntryInfo, or cancels it if none is set
+  void
+  armTimer(PitEntryInfo& pitEntryInfo);
+
+  /// one or both deadlines of \p pitEntryInfo have passed
+  void
+  onTimer(const shared_ptr<PitEntryInfo>& pitEntryInfo);
+
+  /// propagate to another upstream
+  void
+  doPropagate(const shared_ptr<pit::Entry>& pitEntry, PitEntryInfo& pitEntryInfo);
+
+public:
+  static const Name STRATEGY_NAME;
+  static const time::nanoseconds TIMER_TICK;
+
+private:
+  TimerWheel<PitEntryInfo> m_timerWheel;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_NCC_WHEEL_STRATEGY_HPP
@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pitless-adaptive-rtt-strategy.hpp"
+#include "table/name-tree.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("PITlessAdaptiveRttStrategy");
+
+const Name PITlessAdaptiveRttStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/pitless-adaptive-rtt/%FD%01");
+NFD_REGISTER_PITLESS_STRATEGY(PITlessAdaptiveRttStrategy);
+
+const time::nanoseconds PITlessAdaptiveRttStrategy::MEASUREMENTS_LIFETIME = time::seconds(16);
+const uint32_t PITlessAdaptiveRttStrategy::EXPLORE_PERIOD = 32;
+const size_t PITlessAdaptiveRttStrategy::PROBE_TABLE_SIZE = 1024;
+
+PITlessAdaptiveRttStrategy::PITlessAdaptiveRttStrategy(Forwarder& forwarder, const Name& name)
+  : PITlessStrategy(forwarder, name)
+  , m_probes(PROBE_TABLE_SIZE)
+{
+  BOOST_ASSERT((PROBE_TABLE_SIZE & (PROBE_TABLE_SIZE - 1)) == 0);
+}
+
+PITlessAdaptiveRttStrategy::~PITlessAdaptiveRttStrategy()
+{
+}
+
+void
+PITlessAdaptiveRttStrategy::afterReceiveInterestPITless(const Face& inFace,
+                                                        const Interest& interest,
+                                                        shared_ptr<fib::Entry> fibEntry)
+{
+  if (fibEntry->getNextHops().empty()) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+    return;
+  }
+
+  // MtInfo is unavailable if this strategy does not manage the FIB prefix,
+  // in which case the first eligible nexthop is used
+  shared_ptr<MtInfo> mi = this->getMtInfo(*fibEntry);
+
+  const fib::NextHop* unusedNexthop = nullptr;
+  const fib::NextHop* fastestNexthop = nullptr;
+  const fib::NextHop* oldestNexthop = nullptr;
+  RttEstimator::Duration fastestRtt = RttEstimator::Duration::max();
+  time::steady_clock::TimePoint oldestSample = time::steady_clock::TimePoint::max();
+  const FaceTable& faceTable = this->getFaceTable();
+
+  for (const fib::NextHop& nexthop : fibEntry->getNextHops()) {
+    if (nexthop.getFaceId() == inFace.getId() || faceTable.find(nexthop.getFaceId()) == nullptr) {
+      continue;
+    }
+    if (mi == nullptr) {
+      fastestNexthop = &nexthop;
+      break;
+    }
+
+    auto it = mi->faceStats.find(nexthop.getFaceId());
+    if (it == mi->faceStats.end()) {
+      unusedNexthop = &nexthop;
+      break;
+    }
+
+    RttEstimator::Duration rtt = it->second.rtt.getSmoothedRtt();
+    if (rtt < fastestRtt) {
+      fastestRtt = rtt;
+      fastestNexthop = &nexthop;
+    }
+    if (it->second.lastSample < oldestSample) {
+      oldestSample = it->second.lastSample;
+      oldestNexthop = &nexthop;
+    }
+  }
+
+  const fib::NextHop* chosen = fastestNexthop;
+  if (unusedNexthop != nullptr) {
+    // until a sample arrives, the face ranks with RttEstimator's initial RTT
+    mi->faceStats[unusedNexthop->getFaceId()].lastSample = time::steady_clock::now();
+    chosen = unusedNexthop;
+  }
+  else if (mi != nullptr && ++mi->nInterests % EXPLORE_PERIOD == 0) {
+    chosen = oldestNexthop;
+  }
+
+  if (chosen == nullptr) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+    return;
+  }
+
+  Face& outFace = *faceTable.find(chosen->getFaceId());
+  if (mi != nullptr) {
+    this->startProbe(interest, outFace, fibEntry);
+  }
+  this->sendInterestPITless(interest, outFace);
+}
+
+void
+PITlessAdaptiveRttStrategy::afterReceiveDataPITless(const Face& inFace, const Data& data)
+{
+  size_t nameHash = this->getForwarder().getHashContext(data.getName()).getFullHash();
+  Probe& probe = m_probes[nameHash & (PROBE_TABLE_SIZE - 1)];
+  if (probe.faceId != inFace.getId() || probe.nameHash != nameHash) {
+    return;
+  }
+
+  // Data arriving after the deadline is still a valid sample,
+  // because PITless forwarding does not drop it
+  RttEstimator::Duration rtt =
+    time::duration_cast<RttEstimator::Duration>(time::steady_clock::now() - probe.sendTime);
+  shared_ptr<fib::Entry> fibEntry = probe.fibEntry.lock();
+  probe.faceId = INVALID_FACEID;
+  probe.fibEntry.reset();
+
+  if (fibEntry != nullptr) {
+    this->addRttSample(*fibEntry, inFace.getId(), rtt);
+  }
+}
+
+void
+PITlessAdaptiveRttStrategy::startProbe(const Interest& interest, const Face& outFace,
+                                       const shared_ptr<fib::Entry>& fibEntry)
+{
+  // PITlessForwarder has computed the hashes during FIB lookup
+  size_t nameHash = this->getForwarder().getHashContext(interest.getName()).getFullHash();
+  Probe& probe = m_probes[nameHash & (PROBE_TABLE_SIZE - 1)];
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  if (probe.faceId != INVALID_FACEID) {
+    if (now < probe.deadline) {
+      // slot is taken by a pending probe
+      return;
+    }
+
+    // Data did not come back within InterestLifetime
+    shared_ptr<fib::Entry> probeFibEntry = probe.fibEntry.lock();
+    if (probeFibEntry != nullptr) {
+      this->addRttSample(*probeFibEntry, probe.faceId,
+        time::duration_cast<RttEstimator::Duration>(probe.deadline - probe.sendTime));
+    }
+  }
+
+  time::milliseconds lifetime = interest.getInterestLifetime();
+  if (lifetime < time::milliseconds::zero()) {
+    lifetime = ndn::DEFAULT_INTEREST_LIFETIME;
+  }
+
+  probe.nameHash = nameHash;
+  probe.faceId = outFace.getId();
+  probe.sendTime = now;
+  probe.deadline = now + lifetime;
+  probe.fibEntry = fibEntry;
+}
+
+void
+PITlessAdaptiveRttStrategy::addRttSample(const fib::Entry& fibEntry, FaceId faceId,
+                                         const RttEstimator::Duration& rtt)
+{
+  shared_ptr<MtInfo> mi = this->getMtInfo(fibEntry);
+  if (mi == nullptr) {
+    return;
+  }
+
+  NFD_LOG_TRACE(fibEntry.getPrefix() << " face=" << faceId << " rtt=" << rtt.count());
+  MtInfo::FaceStats& stats = mi->faceStats[faceId];
+  stats.rtt.addMeasurement(rtt);
+  stats.lastSample = time::steady_clock::now();
+}
+
+shared_ptr<PITlessAdaptiveRttStrategy::MtInfo>
+PITlessAdaptiveRttStrategy::getMtInfo(const fib::Entry& fibEntry)
+{
+  if (fibEntry.getNextHops().empty()) {
+    // Fib::s_emptyEntry is not attached to NameTree, so it has no Measurements entry
+    return nullptr;
+  }
+
+  shared_ptr<measurements::Entry> me = this->getMeasurements().get(fibEntry);
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  this->getMeasurements().extendLifetime(*me, MEASUREMENTS_LIFETIME);
+  return me->getOrCreateStrategyInfo<MtInfo>();
+}
+
+PITlessAdaptiveRttStrategy::MtInfo::MtInfo()
+  : nInterests(0)
+{
+}
+
+PITlessAdaptiveRttStrategy::Probe::Probe()
+  : nameHash(0)
+  , faceId(INVALID_FACEID)
+{
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_PITLESS_ADAPTIVE_RTT_STRATEGY_HPP
+#define NFD_DAEMON_FW_PITLESS_ADAPTIVE_RTT_STRATEGY_HPP
+
+#include "pitless-strategy.hpp"
+#include "rtt-estimator.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief PITless strategy that prefers the upstream with lowest RTT
+ *
+ *  This strategy forwards each Interest to the nexthop (except downstream) with the
+ *  lowest smoothed RTT, so that upstream selection follows congestion without a PIT.
+ *  A nexthop that has never been used is tried first. Every EXPLORE_PERIOD-th Interest
+ *  goes to the nexthop whose RTT sample is the oldest, so that an upstream that has
+ *  recovered is noticed.
+ *
+ *  RTT is measured on a sample of Interests. Since there is no out-record to remember
+ *  when an Interest was sent, the strategy keeps a small direct-mapped probe table
+ *  indexed by the hash of the Interest Name. An Interest becomes a probe if its slot is
+ *  free. The probe is completed by Data of the same Name from the same upstream.
+ *  A probe that is not completed within InterestLifetime charges the upstream
+ *  the time it has been waiting as an RTT sample.
+ *  An RttEstimator per upstream is kept in the Measurements entry of the FIB prefix.
+ */
+class PITlessAdaptiveRttStrategy : public PITlessStrategy
+{
+public:
+  PITlessAdaptiveRttStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual
+  ~PITlessAdaptiveRttStrategy();
+
+  virtual void
+  afterReceiveInterestPITless(const Face& inFace,
+                              const Interest& interest,
+                              shared_ptr<fib::Entry> fibEntry) DECL_OVERRIDE;
+
+  virtual void
+  afterReceiveDataPITless(const Face& inFace, const Data& data) DECL_OVERRIDE;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // StrategyInfo
+  /** \brief StrategyInfo in measurements table
+   */
+  class MtInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1040;
+    }
+
+    MtInfo();
+
+  public:
+    struct FaceStats
+    {
+      RttEstimator rtt;
+      /// when the last RTT sample is taken, or when the face is first used
+      time::steady_clock::TimePoint lastSample;
+    };
+
+    std::unordered_map<FaceId, FaceStats> faceStats;
+    /// number of Interests forwarded, for exploration
+    uint32_t nInterests;
+  };
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // probe table
+  /** \brief an Interest being timed
+   */
+  struct Probe
+  {
+    Probe();
+
+    /// hash of Interest Name
+    size_t nameHash;
+    /// upstream, or INVALID_FACEID if the slot is free
+    FaceId faceId;
+    time::steady_clock::TimePoint sendTime;
+    time::steady_clock::TimePoint deadline;
+    weak_ptr<fib::Entry> fibEntry;
+  };
+
+  /** \brief records \p interest as a probe to \p outFace if its slot is free
+   *
+   *  An expired probe in the slot is charged to its upstream before it is replaced.
+   */
+  void
+  startProbe(const Interest& interest, const Face& outFace,
+             const shared_ptr<fib::Entry>& fibEntry);
+
+  /** \brief adds an RTT sample of \p faceId to the Measurements entry of \p fibEntry
+   */
+  void
+  addRttSample(const fib::Entry& fibEntry, FaceId faceId, const RttEstimator::Duration& rtt);
+
+  shared_ptr<MtInfo>
+  getMtInfo(const fib::Entry& fibEntry);
+
+public:
+  static const Name STRATEGY_NAME;
+
+  /// lifetime of Measurements entry that holds MtInfo
+  static const time::nanoseconds MEASUREMENTS_LIFETIME;
+
+  /// every EXPLORE_PERIOD-th Interest goes to the upstream with oldest RTT sample
+  static const uint32_t EXPLORE_PERIOD;
+
+  /// number of slots in probe table, must be a power of two
+  static const size_t PROBE_TABLE_SIZE;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::vector<Probe> m_probes;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_PITLESS_ADAPTIVE_RTT_STRATEGY_HPP
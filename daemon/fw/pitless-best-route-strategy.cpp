@@ -44,7 +44,7 @@ static inline bool
 predicate_canForwardTo_NextHop(const Face& inFace,
                                const fib::NextHop& nexthop)
 {
-  return (inFace.getId() != nexthop.getFace()->getId());
+  return (inFace.getId() != nexthop.getFaceId());
 }
 
 void
@@ -53,18 +53,20 @@ PITlessBestRouteStrategy::afterReceiveInterestPITless(const Face& inFace,
                                                       shared_ptr<fib::Entry> fibEntry)
 {
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
-  fib::NextHopList::const_iterator it;
-  for (it = nexthops.begin(); it != nexthops.end(); ++it) {
-    if (predicate_canForwardTo_NextHop(inFace, *it) == true)
-      break;
+  Face* outFace = nullptr;
+  for (const fib::NextHop& nexthop : nexthops) {
+    if (predicate_canForwardTo_NextHop(inFace, nexthop) == true) {
+      outFace = this->getFaceTable().find(nexthop.getFaceId());
+      if (outFace != nullptr)
+        break;
+    }
   }
 
-  if (it == nexthops.end()) {
+  if (outFace == nullptr) {
     return;
   }
 
-  shared_ptr<Face> outFace = it->getFace();
-  this->sendInterestPITless(interest, outFace);
+  this->sendInterestPITless(interest, *outFace);
 }
 
 } // namespace fw
@@ -88,9 +88,9 @@ PITlessForwarder::onIncomingInterest(Face& inFace, const Interest& interest)
         std::cout << "** " << m_id << " pitless forwarding interest " << interest.getName() << std::endl;
 
   if (m_csFromNdnSim == nullptr) {
-    m_cs.find(interest,
-              bind(&PITlessForwarder::onContentStoreHit, this, ref(inFace), _1, _2),
-              bind(&PITlessForwarder::onContentStoreMiss, this, ref(inFace), _1));
+    this->findInCs(interest,
+                   bind(&PITlessForwarder::onContentStoreHit, this, ref(inFace), _1, _2),
+                   bind(&PITlessForwarder::onContentStoreMiss, this, ref(inFace), _1));
   }
   else {
     shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
@@ -118,13 +118,13 @@ PITlessForwarder::onContentStoreMiss(const Face& inFace,
                 ", SN:" << interest.getSupportingName() << "]");
 
   // FIB lookup
-  shared_ptr<fib::Entry> fibEntry = Forwarder::getFib().findLongestPrefixMatch(interest.getName());
+  const name_tree::HashContext& hashes = this->getHashContext(interest.getName());
+  shared_ptr<fib::Entry> fibEntry =
+    Forwarder::getFib().findLongestPrefixMatch(interest.getName(), hashes);
 
   // dispatch to strategy
-  // TODO(cesar): this is hard coded, find a better way.
-  Name strategyName = PITlessBestRouteStrategy::STRATEGY_NAME;
-  fw::Strategy* strategy = Forwarder::getStrategyChoice().getStrategy(strategyName);
-  ((fw::PITlessStrategy*)(strategy))->afterReceiveInterestPITless(cref(inFace), interest, fibEntry);
+  this->findEffectivePITlessStrategy(interest.getName(), hashes)
+    .afterReceiveInterestPITless(inFace, interest, fibEntry);
 }
 
 void
@@ -149,11 +149,28 @@ PITlessForwarder::onContentStoreHit(const Face& inFace,
   this->onOutgoingData(data, *const_pointer_cast<Face>(inFace.shared_from_this()));
 }
 
+fw::PITlessStrategy&
+PITlessForwarder::findEffectivePITlessStrategy(const Name& name,
+                                               const name_tree::HashContext& hashes)
+{
+  fw::Strategy& strategy = Forwarder::getStrategyChoice().findEffectiveStrategy(name, hashes);
+  PITlessStrategy* pitlessStrategy = dynamic_cast<PITlessStrategy*>(&strategy);
+  if (pitlessStrategy != nullptr) {
+    return *pitlessStrategy;
+  }
+
+  // a strategy that needs PIT is chosen for this namespace, fall back to PITless best route
+  fw::Strategy* bestRoute =
+    Forwarder::getStrategyChoice().getStrategy(PITlessBestRouteStrategy::STRATEGY_NAME);
+  BOOST_ASSERT(bestRoute != nullptr);
+  return static_cast<PITlessStrategy&>(*bestRoute);
+}
+
 static inline bool
 predicate_canForwardTo_NextHop(const Face& inFace,
                                const fib::NextHop& nexthop)
 {
-  return (inFace.getId() != nexthop.getFace()->getId());
+  return (inFace.getId() != nexthop.getFaceId());
 }
 
 void
@@ -186,6 +203,11 @@ PITlessForwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
+  // let the strategy collect measurements, as there is no PIT entry to do so;
+  // the hashes computed here are reused by the strategy, CS insert, and FIB lookup
+  this->findEffectivePITlessStrategy(data.getName(), this->getHashContext(data.getName()))
+    .afterReceiveDataPITless(inFace, data);
+
   // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
   // - reduce amount of memory used by cached entries
   // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
@@ -197,21 +219,25 @@ PITlessForwarder::onIncomingData(Face& inFace, const Data& data)
 
   // CS insert
   if (Forwarder::getCsFromNdnSim() == nullptr)
-    m_cs.insert(*dataCopyWithoutPacket);
+    this->insertToCs(*dataCopyWithoutPacket, this->getHashContext(data.getName()));
   else
     m_csFromNdnSim->Add(dataCopyWithoutPacket);
 
   // FIB lookup
-  shared_ptr<fib::Entry> fibEntry = m_fib.findLongestPrefixMatch(data.getName());
+  shared_ptr<fib::Entry> fibEntry = m_fib.findLongestPrefixMatch(data.getName(),
+                                                                 this->getHashContext(data.getName()));
 
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
-  fib::NextHopList::const_iterator it;
-  for (it = nexthops.begin(); it != nexthops.end(); ++it) {
-    if (predicate_canForwardTo_NextHop(inFace, *it) == true)
-      break;
+  Face* outFace = nullptr;
+  for (const fib::NextHop& nexthop : nexthops) {
+    if (predicate_canForwardTo_NextHop(inFace, nexthop) == true) {
+      outFace = this->getFaceTable().find(nexthop.getFaceId());
+      if (outFace != nullptr)
+        break;
+    }
   }
 
-  if (it == nexthops.end()) {
+  if (outFace == nullptr) {
     NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() <<
                   " data=[N:" << data.getName() <<
                   ", SN:" << data.getSupportingName() <<
@@ -226,8 +252,7 @@ PITlessForwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  shared_ptr<Face> outFace = it->getFace();
-  if (outFace.get() == &inFace) {
+  if (outFace == &inFace) {
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<float> duration = end - start;
 
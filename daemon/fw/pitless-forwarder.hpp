@@ -79,6 +79,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   onContentStoreHit(const Face& inFace,
                     const Interest& interest, const Data& data);
 
+  /** \return effective strategy of \p name if it is a PITless strategy,
+   *          otherwise PITlessBestRouteStrategy
+   *  \param hashes must be computed from \p name; the StrategyChoice lookup probes
+   *                NameTree with them instead of hashing the Name again
+   */
+  fw::PITlessStrategy&
+  findEffectivePITlessStrategy(const Name& name, const name_tree::HashContext& hashes);
+
 public:
   /** \brief outgoing Interest pipeline
    */
@@ -44,9 +44,12 @@ PITlessMulticastStrategy::afterReceiveInterestPITless(const Face& inFace,
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
 
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
-    shared_ptr<Face> outFace = it->getFace();
-    if (inFace.getId() != outFace->getId()) {
-      this->sendInterestPITless(interest, outFace);
+    if (inFace.getId() == it->getFaceId()) {
+      continue;
+    }
+    Face* outFace = this->getFaceTable().find(it->getFaceId());
+    if (outFace != nullptr) {
+      this->sendInterestPITless(interest, *outFace);
     }
   }
 }
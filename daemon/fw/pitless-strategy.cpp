@@ -50,5 +50,10 @@ PITlessStrategy::afterReceiveInterest(const Face& inFace,
   return;
 }
 
+void
+PITlessStrategy::afterReceiveDataPITless(const Face& inFace, const Data& data)
+{
+}
+
 } // namespace fw
 } // namespace nfd
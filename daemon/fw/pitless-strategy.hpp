@@ -77,6 +77,21 @@ public: // triggers
                               const Interest& interest,
                               shared_ptr<fib::Entry> fibEntry) = 0;
 
+  /** \brief trigger after Data is received
+   *
+   *  The Data:
+   *  - does not violate Scope
+   *  - is under a namespace managed by this strategy
+   *
+   *  There is no PIT entry to match the Data against. The strategy may use this trigger
+   *  to collect measurements about the upstream that returned the Data.
+   *  The Data is forwarded by PITlessForwarder regardless of what this trigger does.
+   *
+   *  The base class implementation does nothing.
+   */
+  virtual void
+  afterReceiveDataPITless(const Face& inFace, const Data& data);
+
   virtual void
   afterReceiveInterest(const Face& inFace,
                        const Interest& interest,
@@ -86,16 +101,16 @@ protected: // actions
   /// send Interest to outFace
   VIRTUAL_WITH_TESTS void
   sendInterestPITless(const Interest& interest,
-                      shared_ptr<Face> outFace,
+                      Face& outFace,
                       bool wantNewNonce = false);
 };
 
 inline void
 PITlessStrategy::sendInterestPITless(const Interest& interest,
-                                              shared_ptr<Face> outFace,
+                                              Face& outFace,
                                               bool wantNewNonce)
 {
-  dynamic_cast<nfd::PITlessForwarder&>(getForwarder()).onOutgoingInterestPITless(interest, *outFace, wantNewNonce);
+  dynamic_cast<nfd::PITlessForwarder&>(getForwarder()).onOutgoingInterestPITless(interest, outFace, wantNewNonce);
 }
 
 } // namespace fw
@@ -67,6 +67,16 @@ public:
   Duration
   computeRto() const;
 
+  /** \return smoothed RTT, or getInitialRtt() if there is no measurement
+   */
+  Duration
+  getSmoothedRtt() const;
+
+  /** \return number of measurements
+   */
+  uint32_t
+  getNSamples() const;
+
 private:
   uint16_t m_maxMultiplier;
   double m_minRto;
@@ -78,6 +88,18 @@ private:
   uint32_t m_nSamples;
 };
 
+inline RttEstimator::Duration
+RttEstimator::getSmoothedRtt() const
+{
+  return Duration(static_cast<Duration::rep>(m_rtt));
+}
+
+inline uint32_t
+RttEstimator::getNSamples() const
+{
+  return m_nSamples;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FW_RTT_ESTIMATOR_HPP
@@ -116,14 +116,14 @@ public:                                                           \
  *  This macro should appear once in .cpp of each built-in PITless strategy.
  */
 #define NFD_REGISTER_PITLESS_STRATEGY(StrategyType)                             \
-static class NfdAuto ## PITlessStrategyType ## PITlessStrategyRegistrationClass \
+static class NfdAuto ## StrategyType ## PITlessStrategyRegistrationClass        \
 {                                                                               \
 public:                                                                         \
-  NfdAuto ## PITlessStrategyType ## PITlessStrategyRegistrationClass()          \
+  NfdAuto ## StrategyType ## PITlessStrategyRegistrationClass()                 \
   {                                                                             \
     ::nfd::fw::registerPITlessStrategy<StrategyType>();                         \
   }                                                                             \
-} g_nfdAuto ## PITlessStrategyType ## PITlessStrategyRegistrationVariable
+} g_nfdAuto ## StrategyType ## PITlessStrategyRegistrationVariable
 
 /** \brief registers a built-in Bridge strategy
  *
@@ -117,6 +117,12 @@ public: // triggers
 protected: // actions
   /// send Interest to outFace
   VIRTUAL_WITH_TESTS void
+  sendInterest(shared_ptr<pit::Entry> pitEntry,
+               Face& outFace,
+               bool wantNewNonce = false);
+
+  /// send Interest to outFace
+  void
   sendInterest(shared_ptr<pit::Entry> pitEntry,
                shared_ptr<Face> outFace,
                bool wantNewNonce = false);
@@ -167,12 +173,20 @@ Strategy::getName() const
   return m_name;
 }
 
+inline void
+Strategy::sendInterest(shared_ptr<pit::Entry> pitEntry,
+                       Face& outFace,
+                       bool wantNewNonce)
+{
+  m_forwarder.onOutgoingInterest(pitEntry, outFace, wantNewNonce);
+}
+
 inline void
 Strategy::sendInterest(shared_ptr<pit::Entry> pitEntry,
                        shared_ptr<Face> outFace,
                        bool wantNewNonce)
 {
-  m_forwarder.onOutgoingInterest(pitEntry, *outFace, wantNewNonce);
+  this->sendInterest(pitEntry, *outFace, wantNewNonce);
 }
 
 inline void
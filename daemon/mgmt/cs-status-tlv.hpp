@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_MGMT_CS_STATUS_TLV_HPP
+#define NFD_DAEMON_MGMT_CS_STATUS_TLV_HPP
+
+namespace nfd {
+namespace tlv {
+
+/** \brief TLV-TYPE codes of CS status dataset
+ *
+ *  \code
+ *  CsStatus := CS-STATUS-TYPE TLV-LENGTH
+ *                NCsEntries
+ *                CsCapacity
+ *                CsPolicyName
+ *                NCsHits
+ *                NCsMisses
+ *  \endcode
+ *
+ *  NCsEntries is the same as in ForwarderStatus.
+ *  CsPolicyName is the name of the replacement policy, such as "lru".
+ *  NCsHits and NCsMisses count lookups since the ContentStore was created,
+ *  and are not reset when the policy changes.
+ */
+enum
+{
+  CsStatus     = 198,
+  CsCapacity   = 199,
+  CsPolicyName = 200,
+  NCsHits      = 201,
+  NCsMisses    = 202
+};
+
+} // namespace tlv
+} // namespace nfd
+
+#endif // NFD_DAEMON_MGMT_CS_STATUS_TLV_HPP
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_MGMT_PIT_STATUS_TLV_HPP
+#define NFD_DAEMON_MGMT_PIT_STATUS_TLV_HPP
+
+namespace nfd {
+namespace tlv {
+
+/** \brief TLV-TYPE codes of PIT status dataset
+ *
+ *  \code
+ *  PitStatus := PIT-STATUS-TYPE TLV-LENGTH
+ *                 NPitEntries
+ *                 PitCapacity?
+ *                 PitFaceQuota?
+ *                 NPitRejected
+ *                 NPitEvicted
+ *                 PitFaceUsage*
+ *
+ *  PitFaceUsage := PIT-FACE-USAGE-TYPE TLV-LENGTH
+ *                    FaceId
+ *                    NPitEntries
+ *  \endcode
+ *
+ *  NPitEntries and FaceId are the same as in ForwarderStatus and FaceStatus.
+ *  PitCapacity and PitFaceQuota are omitted when unlimited.
+ */
+enum
+{
+  PitStatus    = 192,
+  PitCapacity  = 193,
+  PitFaceQuota = 194,
+  NPitRejected = 195,
+  NPitEvicted  = 196,
+  PitFaceUsage = 197
+};
+
+} // namespace tlv
+} // namespace nfd
+
+#endif // NFD_DAEMON_MGMT_PIT_STATUS_TLV_HPP
@@ -24,12 +24,16 @@
  */
 
 #include "status-server.hpp"
+#include "pit-status-tlv.hpp"
+#include "cs-status-tlv.hpp"
 #include "fw/forwarder.hpp"
 #include "version.hpp"
 
 namespace nfd {
 
 const Name StatusServer::DATASET_PREFIX = "ndn:/localhost/nfd/status";
+const Name StatusServer::PIT_DATASET_PREFIX = "ndn:/localhost/nfd/status/pit";
+const Name StatusServer::CS_DATASET_PREFIX = "ndn:/localhost/nfd/status/cs";
 const time::milliseconds StatusServer::RESPONSE_FRESHNESS = time::milliseconds(5000);
 
 StatusServer::StatusServer(shared_ptr<AppFace> face, Forwarder& forwarder, ndn::KeyChain& keyChain)
@@ -44,15 +48,27 @@ StatusServer::StatusServer(shared_ptr<AppFace> face, Forwarder& forwarder, ndn::
 void
 StatusServer::onInterest(const Interest& interest) const
 {
-  Name name(DATASET_PREFIX);
+  bool isPitDataset = PIT_DATASET_PREFIX.isPrefixOf(interest.getName());
+  bool isCsDataset = CS_DATASET_PREFIX.isPrefixOf(interest.getName());
+
+  Name name(isPitDataset ? PIT_DATASET_PREFIX :
+            isCsDataset ? CS_DATASET_PREFIX : DATASET_PREFIX);
   name.appendVersion();
   name.appendSegment(0);
 
   shared_ptr<Data> data = make_shared<Data>(name);
   data->setFreshnessPeriod(RESPONSE_FRESHNESS);
 
-  shared_ptr<ndn::nfd::ForwarderStatus> status = this->collectStatus();
-  data->setContent(status->wireEncode());
+  if (isPitDataset) {
+    data->setContent(this->collectPitStatus());
+  }
+  else if (isCsDataset) {
+    data->setContent(this->collectCsStatus());
+  }
+  else {
+    shared_ptr<ndn::nfd::ForwarderStatus> status = this->collectStatus();
+    data->setContent(status->wireEncode());
+  }
 
   m_keyChain.sign(*data);
   m_face->put(*data);
@@ -71,11 +87,81 @@ StatusServer::collectStatus() const
   status->setNFibEntries(m_forwarder.getFib().size());
   status->setNPitEntries(m_forwarder.getPit().size());
   status->setNMeasurementsEntries(m_forwarder.getMeasurements().size());
-  status->setNCsEntries(m_forwarder.getCs().size());
+  const ShardedCs* shardedCs = m_forwarder.getShardedCs();
+  status->setNCsEntries(shardedCs != nullptr ? shardedCs->size() : m_forwarder.getCs().size());
 
   m_forwarder.getCounters().copyTo(*status);
 
   return status;
 }
 
+Block
+StatusServer::collectPitStatus() const
+{
+  const Pit& pit = m_forwarder.getPit();
+  ndn::EncodingBuffer encoder;
+  size_t totalLength = 0;
+
+  // prepend in reverse order
+  for (const auto& usage : pit.getFaceUsages()) {
+    size_t usageLength = 0;
+    usageLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::nfd::NPitEntries,
+                                                       usage.second);
+    usageLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::nfd::FaceId,
+                                                       usage.first);
+    usageLength += encoder.prependVarNumber(usageLength);
+    usageLength += encoder.prependVarNumber(tlv::PitFaceUsage);
+    totalLength += usageLength;
+  }
+
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::NPitEvicted,
+                                                     pit.getNEvicted());
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::NPitRejected,
+                                                     pit.getNRejected());
+  if (pit.getFaceQuota() != std::numeric_limits<size_t>::max()) {
+    totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::PitFaceQuota,
+                                                       pit.getFaceQuota());
+  }
+  if (pit.getLimit() != std::numeric_limits<size_t>::max()) {
+    totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::PitCapacity,
+                                                       pit.getLimit());
+  }
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::nfd::NPitEntries,
+                                                     pit.size());
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::PitStatus);
+
+  return encoder.block();
+}
+
+Block
+StatusServer::collectCsStatus() const
+{
+  ShardedCs* shardedCs = m_forwarder.getShardedCs();
+  // a sharded CS reports totals of all shards, and the policy of its shards
+  const Cs& cs = shardedCs != nullptr ? shardedCs->getShard(0) : m_forwarder.getCs();
+  const std::string& policyName = cs.getPolicy()->getName();
+  uint64_t nHits = shardedCs != nullptr ? shardedCs->getNHits() : cs.getNHits();
+  uint64_t nMisses = shardedCs != nullptr ? shardedCs->getNMisses() : cs.getNMisses();
+  size_t capacity = shardedCs != nullptr ? shardedCs->getLimit() : cs.getLimit();
+  size_t nEntries = shardedCs != nullptr ? shardedCs->size() : cs.size();
+  ndn::EncodingBuffer encoder;
+  size_t totalLength = 0;
+
+  // prepend in reverse order
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::NCsMisses, nMisses);
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::NCsHits, nHits);
+  totalLength += ndn::prependByteArrayBlock(encoder, tlv::CsPolicyName,
+                                            reinterpret_cast<const uint8_t*>(policyName.data()),
+                                            policyName.size());
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::CsCapacity, capacity);
+  totalLength += ndn::prependNonNegativeIntegerBlock(encoder, tlv::nfd::NCsEntries, nEntries);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::CsStatus);
+
+  return encoder.block();
+}
+
 } // namespace nfd
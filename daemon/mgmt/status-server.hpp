@@ -45,8 +45,22 @@ private:
   shared_ptr<ndn::nfd::ForwarderStatus>
   collectStatus() const;
 
+  /** \brief encodes PIT occupancy, admission counters, and per-face usage
+   *  \sa pit-status-tlv.hpp
+   */
+  Block
+  collectPitStatus() const;
+
+  /** \brief encodes CS occupancy, replacement policy, and hit/miss counters
+   *  \sa cs-status-tlv.hpp
+   */
+  Block
+  collectCsStatus() const;
+
 private:
   static const Name DATASET_PREFIX;
+  static const Name PIT_DATASET_PREFIX;
+  static const Name CS_DATASET_PREFIX;
   static const time::milliseconds RESPONSE_FRESHNESS;
 
   shared_ptr<AppFace> m_face;
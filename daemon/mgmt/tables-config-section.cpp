@@ -28,28 +28,48 @@
 #include "common.hpp"
 #include "core/logger.hpp"
 #include "core/config-file.hpp"
+#include "fw/forwarder.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
 
 namespace nfd {
 
 NFD_LOG_INIT("TablesConfigSection");
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const size_t TablesConfigSection::DEFAULT_CS_DISK_STORE_SIZE = 1024;
+const size_t TablesConfigSection::CS_DISK_STORE_SEGMENT_SIZE = 1024 * 1024;
 
 TablesConfigSection::TablesConfigSection(Cs& cs,
                                          Pit& pit,
                                          Fib& fib,
                                          StrategyChoice& strategyChoice,
-                                         Measurements& measurements)
+                                         Measurements& measurements,
+                                         NameTree& nameTree)
   : m_cs(cs)
-  // , m_pit(pit)
+  , m_pit(pit)
   // , m_fib(fib)
   , m_strategyChoice(strategyChoice)
   // , m_measurements(measurements)
+  , m_nameTree(nameTree)
+  , m_forwarder(nullptr)
   , m_areTablesConfigured(false)
 {
 
 }
 
+TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
+  : TablesConfigSection(forwarder.getCs(),
+                        forwarder.getPit(),
+                        forwarder.getFib(),
+                        forwarder.getStrategyChoice(),
+                        forwarder.getMeasurements(),
+                        forwarder.getNameTree())
+{
+  m_forwarder = &forwarder;
+}
+
 void
 TablesConfigSection::setConfigFile(ConfigFile& configFile)
 {
@@ -80,6 +100,16 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
   // tables
   // {
   //    cs_max_packets 65536
+  //    cs_policy fifo
+  //    cs_admission none
+  //    cs_shards 1
+  //    cs_snapshot_file /var/lib/ndn/nfd/cs.snapshot
+  //    cs_disk_store_file /var/lib/ndn/nfd/cs.disk
+  //    cs_disk_store_size 1024 ; in megabytes
+  //    pit_max_entries 100000
+  //    pit_overload_policy reject
+  //    pit_face_quota 10000
+  //    name_component_interning no
   //
   //    strategy_choice
   //    {
@@ -109,6 +139,121 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       nCsMaxPackets = *valCsMaxPackets;
     }
 
+  std::string csPolicyName = configSection.get<std::string>("cs_policy", "");
+  if (!csPolicyName.empty() && cs::makePolicy(csPolicyName) == nullptr)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value \"" + csPolicyName + "\" for option "
+                                              "\"cs_policy\" in \"tables\" section"));
+    }
+
+  std::string csAdmissionName = configSection.get<std::string>("cs_admission", "none");
+  if (csAdmissionName != "none" && cs::makeAdmissionFilter(csAdmissionName) == nullptr)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value \"" + csAdmissionName + "\" for option "
+                                              "\"cs_admission\" in \"tables\" section"));
+    }
+
+  size_t nCsShards = 1;
+  if (configSection.get_child_optional("cs_shards"))
+    {
+      boost::optional<size_t> valCsShards =
+        configSection.get_optional<size_t>("cs_shards");
+
+      if (!valCsShards || *valCsShards == 0)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"cs_shards\""
+                                                  " in \"tables\" section"));
+        }
+
+      if (*valCsShards > 1 && m_forwarder == nullptr)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Option \"cs_shards\" in \"tables\" section"
+                                                  " is not supported without a Forwarder"));
+        }
+
+      nCsShards = *valCsShards;
+    }
+
+  std::string csSnapshotFile = configSection.get<std::string>("cs_snapshot_file", "");
+
+  std::string csDiskStoreFile = configSection.get<std::string>("cs_disk_store_file", "");
+
+  size_t csDiskStoreSize = DEFAULT_CS_DISK_STORE_SIZE;
+  if (configSection.get_child_optional("cs_disk_store_size"))
+    {
+      boost::optional<size_t> valCsDiskStoreSize =
+        configSection.get_optional<size_t>("cs_disk_store_size");
+
+      if (!valCsDiskStoreSize || *valCsDiskStoreSize == 0)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"cs_disk_store_size\""
+                                                  " in \"tables\" section"));
+        }
+
+      csDiskStoreSize = *valCsDiskStoreSize;
+    }
+
+  size_t nPitMaxEntries = std::numeric_limits<size_t>::max();
+  if (configSection.get_child_optional("pit_max_entries"))
+    {
+      boost::optional<size_t> valPitMaxEntries =
+        configSection.get_optional<size_t>("pit_max_entries");
+
+      if (!valPitMaxEntries || *valPitMaxEntries == 0)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"pit_max_entries\""
+                                                  " in \"tables\" section"));
+        }
+
+      nPitMaxEntries = *valPitMaxEntries;
+    }
+
+  pit::OverloadPolicy pitOverloadPolicy = pit::OVERLOAD_REJECT;
+  std::string pitOverloadPolicyName = configSection.get<std::string>("pit_overload_policy",
+                                                                     "reject");
+  if (pitOverloadPolicyName == "evict-oldest")
+    {
+      pitOverloadPolicy = pit::OVERLOAD_EVICT_OLDEST;
+    }
+  else if (pitOverloadPolicyName == "evict-soonest-expiring")
+    {
+      pitOverloadPolicy = pit::OVERLOAD_EVICT_SOONEST_EXPIRING;
+    }
+  else if (pitOverloadPolicyName != "reject")
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value \"" + pitOverloadPolicyName +
+                                              "\" for option \"pit_overload_policy\" in "
+                                              "\"tables\" section"));
+    }
+
+  size_t nPitFaceQuota = std::numeric_limits<size_t>::max();
+  if (configSection.get_child_optional("pit_face_quota"))
+    {
+      boost::optional<size_t> valPitFaceQuota =
+        configSection.get_optional<size_t>("pit_face_quota");
+
+      if (!valPitFaceQuota || *valPitFaceQuota == 0)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"pit_face_quota\""
+                                                  " in \"tables\" section"));
+        }
+
+      nPitFaceQuota = *valPitFaceQuota;
+    }
+
+  bool wantComponentInterning = false;
+  std::string componentInterning = configSection.get<std::string>("name_component_interning", "no");
+  if (componentInterning == "yes")
+    {
+      wantComponentInterning = true;
+    }
+  else if (componentInterning != "no")
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value \"" + componentInterning +
+                                              "\" for option \"name_component_interning\" in "
+                                              "\"tables\" section"));
+    }
+
   boost::optional<const ConfigSection&> strategyChoiceSection =
     configSection.get_child_optional("strategy_choice");
 
@@ -119,10 +264,208 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
 
   if (!isDryRun)
     {
+      if (!csPolicyName.empty() && csPolicyName != m_cs.getPolicy()->getName())
+        {
+          if (m_cs.size() == 0)
+            {
+              NFD_LOG_INFO("Setting CS replacement policy to " << csPolicyName);
+              m_cs.setPolicy(cs::makePolicy(csPolicyName));
+            }
+          else
+            {
+              NFD_LOG_WARN("Cannot change CS replacement policy to " << csPolicyName <<
+                           " while CS is not empty");
+            }
+        }
+
       NFD_LOG_INFO("Setting CS max packets to " << nCsMaxPackets);
 
       m_cs.setLimit(nCsMaxPackets);
+
+      if (m_forwarder != nullptr)
+        {
+          applyCsShards(nCsShards, csPolicyName, nCsMaxPackets);
+        }
+
+      applyCsAdmission(csAdmissionName);
+
+      // each megabyte of cs_disk_store_size is one DiskStore segment
+      applyCsDiskStore(csDiskStoreFile, csDiskStoreSize);
+
+      NFD_LOG_INFO("Setting PIT max entries to " << nPitMaxEntries <<
+                   ", overload policy to " << pitOverloadPolicyName <<
+                   ", face quota to " << nPitFaceQuota);
+      m_pit.setLimit(nPitMaxEntries);
+      m_pit.setOverloadPolicy(pitOverloadPolicy);
+      m_pit.setFaceQuota(nPitFaceQuota);
+
+      if (wantComponentInterning != m_nameTree.isComponentInterning())
+        {
+          NFD_LOG_INFO("Setting NameTree component interning to " << componentInterning);
+          m_nameTree.setComponentInterning(wantComponentInterning);
+        }
+
       m_areTablesConfigured = true;
+
+      m_csSnapshotFile = csSnapshotFile;
+      if (!m_csSnapshotFile.empty() && m_forwarder != nullptr &&
+          m_forwarder->getShardedCs() != nullptr)
+        {
+          NFD_LOG_WARN("CS snapshot is not supported with sharded CS, ignoring " << m_csSnapshotFile);
+          m_csSnapshotFile.clear();
+        }
+
+      if (!m_csSnapshotFile.empty() && m_cs.size() == 0)
+        {
+          loadCsSnapshot();
+        }
+    }
+}
+
+void
+TablesConfigSection::applyCsShards(size_t nCsShards, const std::string& csPolicyName,
+                                   size_t nCsMaxPackets)
+{
+  ShardedCs* shardedCs = m_forwarder->getShardedCs();
+  size_t nCurrentShards = shardedCs == nullptr ? 1 : shardedCs->getNShards();
+
+  if (nCsShards != nCurrentShards)
+    {
+      if (m_cs.size() == 0 && (shardedCs == nullptr || shardedCs->size() == 0))
+        {
+          // the new shards take capacity and policy from the unsharded CS configured above
+          NFD_LOG_INFO("Setting CS shards to " << nCsShards);
+          m_forwarder->setCsShards(nCsShards);
+          return;
+        }
+
+      NFD_LOG_WARN("Cannot change CS shards to " << nCsShards << " while CS is not empty");
+    }
+
+  if (shardedCs == nullptr)
+    {
+      return;
+    }
+
+  for (size_t i = 0; i < shardedCs->getNShards(); ++i)
+    {
+      Cs& shard = shardedCs->getShard(i);
+      if (!csPolicyName.empty() && csPolicyName != shard.getPolicy()->getName())
+        {
+          if (shard.size() == 0)
+            {
+              shard.setPolicy(cs::makePolicy(csPolicyName));
+            }
+          else
+            {
+              NFD_LOG_WARN("Cannot change replacement policy of CS shard " << i << " to " <<
+                           csPolicyName << " while it is not empty");
+            }
+        }
+    }
+  shardedCs->setLimit(nCsMaxPackets);
+}
+
+void
+TablesConfigSection::applyCsAdmission(const std::string& filterName)
+{
+  std::vector<Cs*> tables(1, &m_cs);
+  ShardedCs* shardedCs = m_forwarder == nullptr ? nullptr : m_forwarder->getShardedCs();
+  for (size_t i = 0; shardedCs != nullptr && i < shardedCs->getNShards(); ++i)
+    {
+      tables.push_back(&shardedCs->getShard(i));
+    }
+
+  for (Cs* cs : tables)
+    {
+      const cs::AdmissionFilter* filter = cs->getAdmissionFilter();
+      if ((filter == nullptr ? "none" : filter->getName()) == filterName)
+        {
+          // keep the access history of the current filter
+          continue;
+        }
+      cs->setAdmissionFilter(filterName == "none" ? nullptr : cs::makeAdmissionFilter(filterName));
+    }
+
+  NFD_LOG_INFO("Setting CS admission filter to " << filterName);
+}
+
+void
+TablesConfigSection::applyCsDiskStore(const std::string& path, size_t nSegments)
+{
+  ShardedCs* shardedCs = m_forwarder == nullptr ? nullptr : m_forwarder->getShardedCs();
+  if (shardedCs == nullptr)
+    {
+      attachCsDiskStore(m_cs, path, nSegments);
+      return;
+    }
+
+  // each shard has its own backing file, named by appending the shard index to path
+  size_t nShardSegments = std::max<size_t>(1, nSegments / shardedCs->getNShards());
+  for (size_t i = 0; i < shardedCs->getNShards(); ++i)
+    {
+      attachCsDiskStore(shardedCs->getShard(i),
+                        path.empty() ? path : path + "." + std::to_string(i),
+                        nShardSegments);
+    }
+}
+
+void
+TablesConfigSection::attachCsDiskStore(Cs& cs, const std::string& path, size_t nSegments)
+{
+  const cs::DiskStore* diskStore = cs.getDiskStore();
+  if (diskStore != nullptr && diskStore->getPath() == path &&
+      diskStore->getNSegments() == nSegments)
+    {
+      // keep the DiskStore and its content across config reloads
+      return;
+    }
+
+  if (diskStore != nullptr)
+    {
+      NFD_LOG_INFO("Detaching CS disk store " << diskStore->getPath());
+      // detach before opening the new DiskStore, which may truncate the same file
+      cs.setDiskStore(nullptr);
+    }
+
+  if (path.empty())
+    {
+      return;
+    }
+
+  NFD_LOG_INFO("Attaching CS disk store " << path << " with " << nSegments << " segments");
+  try
+    {
+      cs.setDiskStore(unique_ptr<cs::DiskStore>(new cs::DiskStore(path, nSegments,
+                                                                  CS_DISK_STORE_SEGMENT_SIZE)));
+    }
+  catch (const cs::DiskStore::Error& e)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value \"" + path + "\" for option "
+                                              "\"cs_disk_store_file\" in \"tables\" section: " +
+                                              e.what()));
+    }
+}
+
+void
+TablesConfigSection::loadCsSnapshot()
+{
+  if (!boost::filesystem::exists(m_csSnapshotFile))
+    {
+      NFD_LOG_INFO("CS snapshot " << m_csSnapshotFile << " does not exist, starting with empty CS");
+      return;
+    }
+
+  std::ifstream is(m_csSnapshotFile, std::ios::binary);
+  try
+    {
+      size_t nLoaded = m_cs.loadSnapshot(is);
+      NFD_LOG_INFO("Loaded " << nLoaded << " CS entries from " << m_csSnapshotFile);
+    }
+  catch (const Cs::Error& e)
+    {
+      // a bad snapshot should not prevent NFD from starting
+      NFD_LOG_WARN("Cannot load CS snapshot " << m_csSnapshotFile << ": " << e.what());
     }
 }
 
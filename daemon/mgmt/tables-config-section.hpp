@@ -26,6 +26,7 @@
 #ifndef NFD_MGMT_TABLES_CONFIG_SECTION_HPP
 #define NFD_MGMT_TABLES_CONFIG_SECTION_HPP
 
+#include "table/name-tree.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 #include "table/cs.hpp"
@@ -36,6 +37,8 @@
 
 namespace nfd {
 
+class Forwarder;
+
 class TablesConfigSection
 {
 public:
@@ -43,7 +46,16 @@ public:
                       Pit& pit,
                       Fib& fib,
                       StrategyChoice& strategyChoice,
-                      Measurements& measurements);
+                      Measurements& measurements,
+                      NameTree& nameTree);
+
+  /** \brief configures the tables of \p forwarder
+   *
+   *  Unlike the constructor taking individual tables, this allows \p cs_shards
+   *  to partition the ContentStore of \p forwarder.
+   */
+  explicit
+  TablesConfigSection(Forwarder& forwarder);
 
   void
   setConfigFile(ConfigFile& configFile);
@@ -51,6 +63,14 @@ public:
   void
   ensureTablesAreConfigured();
 
+  /** \return path of ContentStore snapshot file, or empty string if not configured
+   */
+  const std::string&
+  getCsSnapshotFile() const
+  {
+    return m_csSnapshotFile;
+  }
+
 private:
 
   void
@@ -62,18 +82,46 @@ private:
   processSectionStrategyChoice(const ConfigSection& configSection,
                                bool isDryRun);
 
+  void
+  applyCsShards(size_t nCsShards, const std::string& csPolicyName, size_t nCsMaxPackets);
+
+  /** \brief sets the admission filter of the ContentStore and of each CS shard
+   *  \param filterName name of the filter, or "none" to admit every Data
+   */
+  void
+  applyCsAdmission(const std::string& filterName);
+
+  /** \brief attaches a DiskStore at \p path to the ContentStore, or to each CS shard
+   *  \param path path of the backing file; empty string detaches the DiskStore
+   *  \param nSegments number of segments of CS_DISK_STORE_SEGMENT_SIZE, divided among shards
+   *  \throw ConfigFile::Error the DiskStore cannot be created
+   */
+  void
+  applyCsDiskStore(const std::string& path, size_t nSegments);
+
+  void
+  attachCsDiskStore(Cs& cs, const std::string& path, size_t nSegments);
+
+  void
+  loadCsSnapshot();
+
 private:
   Cs& m_cs;
-  // Pit& m_pit;
+  Pit& m_pit;
   // Fib& m_fib;
   StrategyChoice& m_strategyChoice;
   // Measurements& m_measurements;
+  NameTree& m_nameTree;
+  Forwarder* m_forwarder;
 
   bool m_areTablesConfigured;
+  std::string m_csSnapshotFile;
 
 private:
 
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const size_t DEFAULT_CS_DISK_STORE_SIZE;
+  static const size_t CS_DISK_STORE_SEGMENT_SIZE;
 };
 
 } // namespace nfd
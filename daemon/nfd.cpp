@@ -39,6 +39,9 @@
 #include "mgmt/general-config-section.hpp"
 #include "mgmt/tables-config-section.hpp"
 
+#include <boost/filesystem.hpp>
+#include <fstream>
+
 namespace nfd {
 
 NFD_LOG_INIT("Nfd");
@@ -64,6 +67,27 @@ Nfd::~Nfd()
   // It is necessary to explicitly define the destructor, because some member variables (e.g.,
   // unique_ptr<Forwarder>) are forward-declared, but implicitly declared destructor requires
   // complete types for all members when instantiated.
+
+  if (m_forwarder != nullptr) {
+    const ShardedCs* shardedCs = m_forwarder->getShardedCs();
+    if (shardedCs != nullptr) {
+      uint64_t nLookups = shardedCs->getNHits() + shardedCs->getNMisses();
+      NFD_LOG_INFO("CS shards " << shardedCs->getNShards() << " hits=" << shardedCs->getNHits() <<
+                   " misses=" << shardedCs->getNMisses() << " hit-ratio=" <<
+                   (nLookups == 0 ? 0.0 : static_cast<double>(shardedCs->getNHits()) / nLookups));
+    }
+    else {
+      const Cs& cs = m_forwarder->getCs();
+      uint64_t nLookups = cs.getNHits() + cs.getNMisses();
+      NFD_LOG_INFO("CS policy " << cs.getPolicy()->getName() << " hits=" << cs.getNHits() <<
+                   " misses=" << cs.getNMisses() << " hit-ratio=" <<
+                   (nLookups == 0 ? 0.0 : static_cast<double>(cs.getNHits()) / nLookups));
+    }
+
+    if (!m_csSnapshotFile.empty()) {
+      saveCsSnapshot();
+    }
+  }
 }
 
 void
@@ -143,11 +167,7 @@ Nfd::initializeManagement()
   ConfigFile config(&ignoreRibAndLogSections);
   general::setConfigFile(config);
 
-  TablesConfigSection tablesConfig(m_forwarder->getCs(),
-                                   m_forwarder->getPit(),
-                                   m_forwarder->getFib(),
-                                   m_forwarder->getStrategyChoice(),
-                                   m_forwarder->getMeasurements());
+  TablesConfigSection tablesConfig(*m_forwarder);
   tablesConfig.setConfigFile(config);
 
   m_internalFace->getValidator().setConfigFile(config);
@@ -167,6 +187,7 @@ Nfd::initializeManagement()
   }
 
   tablesConfig.ensureTablesAreConfigured();
+  m_csSnapshotFile = tablesConfig.getCsSnapshotFile();
 
   // add FIB entry for NFD Management Protocol
   shared_ptr<fib::Entry> entry = m_forwarder->getFib().insert("/localhost/nfd").first;
@@ -185,11 +206,7 @@ Nfd::reloadConfigFile()
 
   general::setConfigFile(config);
 
-  TablesConfigSection tablesConfig(m_forwarder->getCs(),
-                                   m_forwarder->getPit(),
-                                   m_forwarder->getFib(),
-                                   m_forwarder->getStrategyChoice(),
-                                   m_forwarder->getMeasurements());
+  TablesConfigSection tablesConfig(*m_forwarder);
 
   tablesConfig.setConfigFile(config);
 
@@ -202,6 +219,7 @@ Nfd::reloadConfigFile()
   else {
     config.parse(m_configSection, false, INTERNAL_CONFIG);
   }
+  m_csSnapshotFile = tablesConfig.getCsSnapshotFile();
 }
 
 void
@@ -219,4 +237,22 @@ Nfd::reloadConfigFileFaceSection()
   }
 }
 
+void
+Nfd::saveCsSnapshot()
+{
+  // write to a temporary file, so that an interrupted save does not destroy the previous snapshot
+  std::string tmpFile = m_csSnapshotFile + ".tmp";
+  try {
+    {
+      std::ofstream os(tmpFile, std::ios::binary | std::ios::trunc);
+      m_forwarder->getCs().saveSnapshot(os);
+    }
+    boost::filesystem::rename(tmpFile, m_csSnapshotFile);
+    NFD_LOG_INFO("Saved CS snapshot to " << m_csSnapshotFile);
+  }
+  catch (const std::exception& e) {
+    NFD_LOG_WARN("Cannot save CS snapshot to " << m_csSnapshotFile << ": " << e.what());
+  }
+}
+
 } // namespace nfd
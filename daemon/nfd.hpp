@@ -91,11 +91,15 @@ private:
   void
   reloadConfigFileFaceSection();
 
+  void
+  saveCsSnapshot();
+
 private:
   std::string m_configFile;
   ConfigSection m_configSection;
 
   unique_ptr<Forwarder> m_forwarder;
+  std::string m_csSnapshotFile;
 
   shared_ptr<InternalFace>          m_internalFace;
   unique_ptr<FibManager>            m_fibManager;
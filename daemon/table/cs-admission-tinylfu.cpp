@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-admission-tinylfu.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tinylfu {
+
+const size_t CountMinSketch::N_ROWS;
+const uint8_t CountMinSketch::MAX_COUNT;
+
+static const uint64_t ROW_SEEDS[CountMinSketch::N_ROWS] = {
+  0xc3a5c85c97cb3127ULL,
+  0xb492b66fbe98f273ULL,
+  0x9ae16a3b2f90404fULL,
+  0xcbf29ce484222325ULL,
+};
+
+CountMinSketch::CountMinSketch(size_t width)
+{
+  size_t roundedWidth = 1;
+  while (roundedWidth < width) {
+    roundedWidth <<= 1;
+  }
+  m_mask = roundedWidth - 1;
+  m_counters.assign(N_ROWS * roundedWidth, 0);
+}
+
+size_t
+CountMinSketch::getIndex(uint64_t hash, size_t row) const
+{
+  uint64_t h = (hash + ROW_SEEDS[row]) * 0x9e3779b97f4a7c15ULL;
+  h ^= h >> 32;
+  return row * this->getWidth() + static_cast<size_t>(h & m_mask);
+}
+
+void
+CountMinSketch::increment(uint64_t hash)
+{
+  size_t indices[N_ROWS];
+  uint8_t minCount = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    indices[row] = this->getIndex(hash, row);
+    minCount = std::min(minCount, m_counters[indices[row]]);
+  }
+
+  if (minCount == MAX_COUNT) {
+    return;
+  }
+
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    if (m_counters[indices[row]] == minCount) {
+      ++m_counters[indices[row]];
+    }
+  }
+}
+
+uint8_t
+CountMinSketch::estimate(uint64_t hash) const
+{
+  uint8_t minCount = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    minCount = std::min(minCount, m_counters[this->getIndex(hash, row)]);
+  }
+  return minCount;
+}
+
+void
+CountMinSketch::halve()
+{
+  for (uint8_t& counter : m_counters) {
+    counter >>= 1;
+  }
+}
+
+const std::string TinyLfuFilter::FILTER_NAME = "tinylfu";
+const size_t TinyLfuFilter::SAMPLE_FACTOR = 10;
+
+/** \brief minimum number of counters per sketch row
+ *
+ *  This keeps collisions low when CS capacity is very small.
+ */
+static const size_t MIN_SKETCH_WIDTH = 64;
+
+TinyLfuFilter::TinyLfuFilter()
+  : AdmissionFilter(FILTER_NAME)
+  , m_sampleSize(SAMPLE_FACTOR)
+  , m_nAdditions(0)
+{
+}
+
+uint8_t
+TinyLfuFilter::estimateFrequency(uint64_t nameHash) const
+{
+  return m_sketch.estimate(nameHash);
+}
+
+void
+TinyLfuFilter::doSetLimit(size_t nMaxEntries)
+{
+  m_sketch = CountMinSketch(std::max(nMaxEntries, MIN_SKETCH_WIDTH));
+  m_sampleSize = SAMPLE_FACTOR * nMaxEntries;
+  m_nAdditions = 0;
+}
+
+void
+TinyLfuFilter::doRecordAccess(uint64_t nameHash)
+{
+  m_sketch.increment(nameHash);
+
+  if (++m_nAdditions >= m_sampleSize) {
+    m_sketch.halve();
+    m_nAdditions /= 2;
+  }
+}
+
+bool
+TinyLfuFilter::doShouldAdmit(uint64_t candidateHash, uint64_t victimHash)
+{
+  return this->estimateFrequency(candidateHash) > this->estimateFrequency(victimHash);
+}
+
+} // namespace tinylfu
+} // namespace cs
+} // namespace nfd
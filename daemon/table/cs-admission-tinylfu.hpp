@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_ADMISSION_TINYLFU_HPP
+#define NFD_DAEMON_TABLE_CS_ADMISSION_TINYLFU_HPP
+
+#include "cs-admission.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tinylfu {
+
+/** \brief a Count-Min Sketch of 4-bit saturating counters
+ *
+ *  The sketch approximates the access frequency of a key (identified by its hash)
+ *  in a fixed amount of memory. The estimate never underestimates the true count,
+ *  unless the counters have been halved.
+ */
+class CountMinSketch
+{
+public:
+  /** \brief creates a sketch
+   *  \param width number of counters per row; rounded up to a power of two
+   */
+  explicit
+  CountMinSketch(size_t width = 1);
+
+  /** \return number of counters per row
+   */
+  size_t
+  getWidth() const
+  {
+    return m_mask + 1;
+  }
+
+  /** \brief increments the counters of \p hash
+   *
+   *  Only the smallest counters are incremented (conservative update),
+   *  which reduces overestimation caused by collisions.
+   */
+  void
+  increment(uint64_t hash);
+
+  /** \return estimated frequency of \p hash
+   */
+  uint8_t
+  estimate(uint64_t hash) const;
+
+  /** \brief divides every counter by two
+   *
+   *  This ages the recorded history, so that the sketch follows changes in popularity.
+   */
+  void
+  halve();
+
+public:
+  static const size_t N_ROWS = 4;
+  static const uint8_t MAX_COUNT = 15;
+
+private:
+  size_t
+  getIndex(uint64_t hash, size_t row) const;
+
+private:
+  std::vector<uint8_t> m_counters;
+  size_t m_mask;
+};
+
+/** \brief TinyLFU admission filter
+ *
+ *  The filter records the access frequency of Data names in a CountMinSketch.
+ *  A new Data is admitted only if its estimated frequency is higher than the frequency
+ *  of the eviction victim, so that a scan of one-time Data cannot flush popular entries.
+ *  After a sample of (SAMPLE_FACTOR * capacity) accesses, all counters are halved.
+ *
+ *  \sa Gil Einziger, Roy Friedman, Ben Manes, "TinyLFU: A Highly Efficient Cache
+ *      Admission Policy", ACM Transactions on Storage, 2017
+ */
+class TinyLfuFilter : public AdmissionFilter
+{
+public:
+  TinyLfuFilter();
+
+  /** \return estimated access frequency of the Data name with hash \p nameHash
+   */
+  uint8_t
+  estimateFrequency(uint64_t nameHash) const;
+
+public:
+  static const std::string FILTER_NAME;
+  static const size_t SAMPLE_FACTOR;
+
+private:
+  virtual void
+  doSetLimit(size_t nMaxEntries) DECL_OVERRIDE;
+
+  virtual void
+  doRecordAccess(uint64_t nameHash) DECL_OVERRIDE;
+
+  virtual bool
+  doShouldAdmit(uint64_t candidateHash, uint64_t victimHash) DECL_OVERRIDE;
+
+private:
+  CountMinSketch m_sketch;
+  size_t m_sampleSize;
+  size_t m_nAdditions;
+};
+
+} // namespace tinylfu
+
+using tinylfu::TinyLfuFilter;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_ADMISSION_TINYLFU_HPP
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_ADMISSION_HPP
+#define NFD_DAEMON_TABLE_CS_ADMISSION_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief represents a CS admission filter
+ *
+ *  An admission filter sits in front of the replacement policy.
+ *  When CS is full, a new Data is admitted only if the filter prefers it over
+ *  the entry that the replacement policy would evict to make room for it.
+ *  The filter is independent from the policy, so it can be combined with any Policy.
+ *  Data names are identified by their NameTree hash (name_tree::computeHash),
+ *  which CS entries keep and the forwarding pipelines have already computed.
+ */
+class AdmissionFilter : noncopyable
+{
+public:
+  explicit
+  AdmissionFilter(const std::string& filterName);
+
+  virtual
+  ~AdmissionFilter();
+
+  const std::string&
+  getName() const;
+
+public:
+  /** \brief sets the capacity of CS (in number of entries)
+   *
+   *  The filter may size its internal state according to this capacity.
+   */
+  void
+  setLimit(size_t nMaxEntries);
+
+  /** \brief invoked by CS when a Data name is requested
+   *
+   *  This is invoked upon every CS hit, and every time a Data arrives to be inserted,
+   *  so that each request for a Data name is recorded exactly once.
+   */
+  void
+  recordAccess(uint64_t nameHash);
+
+  /** \brief invoked by CS when it is full and a new Data is about to be inserted
+   *  \param candidateHash Name hash of the new Data
+   *  \param victimHash Name hash of the entry that the replacement policy would evict
+   *  \return whether the new Data should be admitted
+   */
+  bool
+  shouldAdmit(uint64_t candidateHash, uint64_t victimHash);
+
+  /** \return number of Data admitted when CS is full
+   */
+  uint64_t
+  getNAdmitted() const;
+
+  /** \return number of Data rejected when CS is full
+   */
+  uint64_t
+  getNRejected() const;
+
+protected:
+  /** \brief invoked when CS capacity is changed
+   */
+  virtual void
+  doSetLimit(size_t nMaxEntries) = 0;
+
+  /** \brief invoked when a Data name is requested
+   */
+  virtual void
+  doRecordAccess(uint64_t nameHash) = 0;
+
+  /** \brief decides whether \p candidate should replace \p victim
+   */
+  virtual bool
+  doShouldAdmit(uint64_t candidateHash, uint64_t victimHash) = 0;
+
+private:
+  std::string m_filterName;
+  uint64_t m_nAdmitted;
+  uint64_t m_nRejected;
+};
+
+inline const std::string&
+AdmissionFilter::getName() const
+{
+  return m_filterName;
+}
+
+inline uint64_t
+AdmissionFilter::getNAdmitted() const
+{
+  return m_nAdmitted;
+}
+
+inline uint64_t
+AdmissionFilter::getNRejected() const
+{
+  return m_nRejected;
+}
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_ADMISSION_HPP
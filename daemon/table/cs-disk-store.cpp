@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-disk-store.hpp"
+#include "core/logger.hpp"
+#include "name-tree.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+NFD_LOG_INIT("DiskStore");
+
+namespace nfd {
+namespace cs {
+
+static size_t
+alignRecord(size_t length)
+{
+  return (length + 7) & ~static_cast<size_t>(7);
+}
+
+DiskStore::DiskStore(const std::string& path, size_t nSegments, size_t segmentSize)
+  : m_path(path)
+  , m_fd(-1)
+  , m_buffer(nullptr)
+  , m_segmentSize(alignRecord(segmentSize))
+  , m_segmentEnds(nSegments, 0)
+  , m_currentSegment(0)
+  , m_nReclaimedSegments(0)
+{
+  BOOST_ASSERT(nSegments > 0);
+  BOOST_ASSERT(segmentSize > sizeof(RecordHeader));
+
+  size_t fileSize = nSegments * m_segmentSize;
+
+  m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (m_fd < 0) {
+    BOOST_THROW_EXCEPTION(Error("Cannot open " + path + ": " + std::strerror(errno)));
+  }
+
+  if (::ftruncate(m_fd, static_cast<off_t>(fileSize)) != 0) {
+    int err = errno;
+    ::close(m_fd);
+    BOOST_THROW_EXCEPTION(Error("Cannot resize " + path + ": " + std::strerror(err)));
+  }
+
+  void* addr = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (addr == MAP_FAILED) {
+    int err = errno;
+    ::close(m_fd);
+    BOOST_THROW_EXCEPTION(Error("Cannot map " + path + ": " + std::strerror(err)));
+  }
+  m_buffer = static_cast<uint8_t*>(addr);
+
+  NFD_LOG_INFO("opened " << path << " nSegments=" << nSegments <<
+               " segmentSize=" << m_segmentSize);
+}
+
+DiskStore::~DiskStore()
+{
+  ::munmap(m_buffer, m_segmentEnds.size() * m_segmentSize);
+  ::close(m_fd);
+}
+
+uint64_t
+DiskStore::computeNameHash(const Name& name)
+{
+  // same hash as Entry::getNameHash
+  return name_tree::computeHash(name);
+}
+
+bool
+DiskStore::hasName(const Location& location, const Block& nameWire) const
+{
+  const uint8_t* wire = this->getSegment(location.segment) + location.offset +
+                        sizeof(RecordHeader);
+
+  // Name is the first element in Data; skip Data TLV-TYPE (one octet) and TLV-LENGTH
+  size_t nameOffset = 2;
+  if (location.length < nameOffset) {
+    return false;
+  }
+  switch (wire[1]) {
+  case 253:
+    nameOffset += 2;
+    break;
+  case 254:
+    nameOffset += 4;
+    break;
+  case 255:
+    nameOffset += 8;
+    break;
+  }
+
+  return location.length >= nameOffset + nameWire.size() &&
+         std::memcmp(wire + nameOffset, nameWire.wire(), nameWire.size()) == 0;
+}
+
+DiskStore::Index::iterator
+DiskStore::findInIndex(const Block& nameWire, uint64_t nameHash)
+{
+  auto range = m_index.equal_range(nameHash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (this->hasName(it->second, nameWire)) {
+      return it;
+    }
+  }
+  return m_index.end();
+}
+
+bool
+DiskStore::insert(const Data& data, const time::steady_clock::TimePoint& staleTime)
+{
+  return this->insertWire(data.getName().wireEncode(), computeNameHash(data.getName()),
+                          data.wireEncode(), staleTime);
+}
+
+bool
+DiskStore::insert(const Entry& entry)
+{
+  return this->insertWire(entry.getNameWire(), entry.getNameHash(), entry.getWire(),
+                          entry.getStaleTime());
+}
+
+bool
+DiskStore::insertWire(const Block& nameWire, uint64_t nameHash, const Block& wire,
+                      const time::steady_clock::TimePoint& staleTime)
+{
+  size_t recordSize = alignRecord(sizeof(RecordHeader) + wire.size());
+  if (recordSize > m_segmentSize) {
+    NFD_LOG_DEBUG("insert " << Name(nameWire) << " too-large");
+    return false;
+  }
+
+  if (m_segmentEnds[m_currentSegment] + recordSize > m_segmentSize) {
+    this->advanceSegment();
+  }
+
+  RecordHeader header;
+  header.nameHash = nameHash;
+  header.length = static_cast<uint32_t>(wire.size());
+  header.reserved = 0;
+
+  size_t offset = m_segmentEnds[m_currentSegment];
+  uint8_t* record = this->getSegment(m_currentSegment) + offset;
+  std::memcpy(record, &header, sizeof(header));
+  std::memcpy(record + sizeof(header), wire.wire(), wire.size());
+  m_segmentEnds[m_currentSegment] = offset + recordSize;
+
+  // supersede a previous record with same Name, but not one that only shares the hash
+  auto it = this->findInIndex(nameWire, nameHash);
+  if (it == m_index.end()) {
+    it = m_index.insert(std::make_pair(nameHash, Location()));
+  }
+
+  Location& location = it->second;
+  location.segment = static_cast<uint32_t>(m_currentSegment);
+  location.offset = static_cast<uint32_t>(offset);
+  location.length = header.length;
+  location.staleTime = staleTime;
+
+  NFD_LOG_DEBUG("insert " << Name(nameWire) << " segment=" << m_currentSegment <<
+                " offset=" << offset);
+  return true;
+}
+
+shared_ptr<Data>
+DiskStore::find(const Interest& interest, time::steady_clock::TimePoint& staleTime)
+{
+  const Name& name = interest.getName();
+  bool isFullName = !name.empty() && name[-1].isImplicitSha256Digest();
+  Name dataName = isFullName ? name.getPrefix(-1) : name;
+
+  auto it = this->findInIndex(dataName.wireEncode(), computeNameHash(dataName));
+  if (it == m_index.end()) {
+    return nullptr;
+  }
+  const Location& location = it->second;
+
+  if (interest.getMustBeFresh() == static_cast<int>(true) &&
+      location.staleTime < time::steady_clock::now()) {
+    return nullptr;
+  }
+
+  // Block copies the wire encoding, so that the segment can be overwritten later
+  const uint8_t* wire = this->getSegment(location.segment) + location.offset +
+                        sizeof(RecordHeader);
+  shared_ptr<Data> data = make_shared<Data>(Block(wire, location.length));
+
+  // the Interest may carry an implicit digest or selectors that exclude this Data
+  if (!interest.matchesData(*data)) {
+    return nullptr;
+  }
+
+  NFD_LOG_DEBUG("find " << name << " matching " << data->getName());
+  staleTime = location.staleTime;
+  m_index.erase(it);
+  return data;
+}
+
+void
+DiskStore::advanceSegment()
+{
+  m_currentSegment = (m_currentSegment + 1) % m_segmentEnds.size();
+  this->reclaimSegment(m_currentSegment);
+}
+
+void
+DiskStore::reclaimSegment(size_t segment)
+{
+  if (m_segmentEnds[segment] == 0) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("reclaim segment=" << segment);
+
+  // records are laid out sequentially, so the segment can be walked from its beginning;
+  // a record is live if the index still points to it
+  const uint8_t* base = this->getSegment(segment);
+  for (size_t offset = 0; offset < m_segmentEnds[segment];) {
+    RecordHeader header;
+    std::memcpy(&header, base + offset, sizeof(header));
+
+    auto range = m_index.equal_range(header.nameHash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.segment == segment && it->second.offset == offset) {
+        m_index.erase(it);
+        break;
+      }
+    }
+
+    offset += alignRecord(sizeof(RecordHeader) + header.length);
+  }
+
+  m_segmentEnds[segment] = 0;
+  ++m_nReclaimedSegments;
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_DISK_STORE_HPP
+#define NFD_DAEMON_TABLE_CS_DISK_STORE_HPP
+
+#include "cs-entry.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief a disk-backed second tier of the ContentStore
+ *
+ *  DiskStore keeps Data wire encodings in a log-structured file that is accessed via mmap.
+ *  The file is divided into fixed-size segments, which are filled in ring order.
+ *  When the ring wraps around, the oldest segment is reclaimed as a whole:
+ *  index entries pointing into it are dropped, and the segment is overwritten.
+ *
+ *  Only a compact index (hash of Data Name => location and stale time) is kept in memory.
+ *  Names that share a hash have separate index entries, which are told apart by comparing
+ *  the Name encoding in the record.
+ *  Lookups are by exact Data Name: an Interest can be satisfied from DiskStore if its Name
+ *  equals the Data Name, or the Data full Name.
+ *
+ *  The file content is not preserved across restarts.
+ */
+class DiskStore : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** \brief opens a DiskStore
+   *  \param path path of the backing file; created if not existing, truncated otherwise
+   *  \param nSegments number of segments
+   *  \param segmentSize size of each segment in bytes
+   *  \throw Error the file cannot be created or mapped
+   */
+  DiskStore(const std::string& path, size_t nSegments, size_t segmentSize);
+
+  ~DiskStore();
+
+  /** \brief writes a Data packet
+   *  \param staleTime the absolute time when the Data becomes stale
+   *  \return whether the Data is stored; false if it does not fit into a segment
+   *
+   *  A previously stored Data with same Name is superseded.
+   */
+  bool
+  insert(const Data& data, const time::steady_clock::TimePoint& staleTime);
+
+  /** \brief writes the Data packet in a CS entry
+   *
+   *  This avoids decoding the Data or its Name, and uses stale time in the entry.
+   */
+  bool
+  insert(const Entry& entry);
+
+  /** \brief finds a Data packet that can satisfy \p interest
+   *  \param[out] staleTime the absolute time when the returned Data becomes stale
+   *  \return the Data decoded from disk, or nullptr if not found
+   *
+   *  A found Data is removed from DiskStore, because CS promotes it to the memory tier.
+   */
+  shared_ptr<Data>
+  find(const Interest& interest, time::steady_clock::TimePoint& staleTime);
+
+  /** \return number of Data packets in the index
+   */
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  /** \return path of the backing file
+   */
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  size_t
+  getNSegments() const
+  {
+    return m_segmentEnds.size();
+  }
+
+  size_t
+  getSegmentSize() const
+  {
+    return m_segmentSize;
+  }
+
+  /** \return number of segments that have been reclaimed
+   */
+  uint64_t
+  getNReclaimedSegments() const
+  {
+    return m_nReclaimedSegments;
+  }
+
+private:
+  /** \brief location of a stored Data
+   */
+  struct Location
+  {
+    uint32_t segment;
+    uint32_t offset;
+    uint32_t length;
+    time::steady_clock::TimePoint staleTime;
+  };
+
+  /** \brief header of a record in a segment, followed by Data wire encoding
+   */
+  struct RecordHeader
+  {
+    uint64_t nameHash;
+    uint32_t length;
+    uint32_t reserved;
+  };
+
+  static uint64_t
+  computeNameHash(const Name& name);
+
+  typedef std::unordered_multimap<uint64_t, Location> Index;
+
+  /** \return whether the record at \p location is a Data whose Name encoding is \p nameWire
+   */
+  bool
+  hasName(const Location& location, const Block& nameWire) const;
+
+  /** \return index entry of the record whose Name encoding is \p nameWire, or m_index.end()
+   */
+  Index::iterator
+  findInIndex(const Block& nameWire, uint64_t nameHash);
+
+  bool
+  insertWire(const Block& nameWire, uint64_t nameHash, const Block& wire,
+             const time::steady_clock::TimePoint& staleTime);
+
+  /** \brief moves to next segment in the ring, and reclaims it
+   */
+  void
+  advanceSegment();
+
+  /** \brief drops index entries pointing into a segment, and empties the segment
+   */
+  void
+  reclaimSegment(size_t segment);
+
+  uint8_t*
+  getSegment(size_t segment) const
+  {
+    return m_buffer + segment * m_segmentSize;
+  }
+
+private:
+  std::string m_path;
+  int m_fd;
+  uint8_t* m_buffer;
+  size_t m_segmentSize;
+  std::vector<size_t> m_segmentEnds; // write offset of each segment
+  size_t m_currentSegment;
+  Index m_index;
+  uint64_t m_nReclaimedSegments;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_DISK_STORE_HPP
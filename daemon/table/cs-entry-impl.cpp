@@ -29,14 +29,14 @@ namespace nfd {
 namespace cs {
 
 EntryImpl::EntryImpl(const Name& name)
-  : m_queryName(name)
+  : Entry(name)
 {
   BOOST_ASSERT(this->isQuery());
 }
 
-EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited)
+EntryImpl::EntryImpl(const Data& data, bool isUnsolicited, size_t nameHash)
 {
-  this->setData(data, isUnsolicited);
+  this->setData(data, isUnsolicited, nameHash);
   BOOST_ASSERT(!this->isQuery());
 }
 
@@ -53,28 +53,22 @@ EntryImpl::canStale() const
   return this->getStaleTime() < time::steady_clock::TimePoint::max();
 }
 
-void
-EntryImpl::unsetUnsolicited()
-{
-  BOOST_ASSERT(!this->isQuery());
-  this->setData(this->getData(), false);
-}
-
 int
-compareQueryWithData(const Name& queryName, const Data& data)
+compareQueryWithData(const Name& queryName, const Entry& data)
 {
   bool queryIsFullName = !queryName.empty() && queryName[-1].isImplicitSha256Digest();
 
+  // Entry::compareName compares in the opposite direction
   int cmp = queryIsFullName ?
-            queryName.compare(0, queryName.size() - 1, data.getName()) :
-            queryName.compare(data.getName());
+            -data.compareName(queryName, queryName.size() - 1) :
+            -data.compareName(queryName);
 
   if (cmp != 0) { // Name without digest differs
     return cmp;
   }
 
   if (queryIsFullName) { // Name without digest equals, compare digest
-    return queryName[-1].compare(data.getFullName()[-1]);
+    return queryName[-1].compare(data.getImplicitDigest());
   }
   else { // queryName is a proper prefix of Data fullName
     return -1;
@@ -82,14 +76,18 @@ compareQueryWithData(const Name& queryName, const Data& data)
 }
 
 int
-compareDataWithData(const Data& lhs, const Data& rhs)
+compareDataWithData(const Entry& lhs, const Entry& rhs)
 {
-  int cmp = lhs.getName().compare(rhs.getName());
+  int cmp = lhs.compareName(rhs);
   if (cmp != 0) {
     return cmp;
   }
 
-  return lhs.getFullName()[-1].compare(rhs.getFullName()[-1]);
+  // digests are not stored; refreshing with the same Data compares equal without computing them
+  if (lhs.hasSameWire(rhs)) {
+    return 0;
+  }
+  return lhs.getImplicitDigest().compare(rhs.getImplicitDigest());
 }
 
 bool
@@ -97,18 +95,18 @@ EntryImpl::operator<(const EntryImpl& other) const
 {
   if (this->isQuery()) {
     if (other.isQuery()) {
-      return m_queryName < other.m_queryName;
+      return this->getQueryName() < other.getQueryName();
     }
     else {
-      return compareQueryWithData(m_queryName, other.getData()) < 0;
+      return compareQueryWithData(this->getQueryName(), other) < 0;
     }
   }
   else {
     if (other.isQuery()) {
-      return compareQueryWithData(other.m_queryName, this->getData()) > 0;
+      return compareQueryWithData(other.getQueryName(), *this) > 0;
     }
     else {
-      return compareDataWithData(this->getData(), other.getData()) < 0;
+      return compareDataWithData(*this, other) < 0;
     }
   }
 }
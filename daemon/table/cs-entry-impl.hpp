@@ -45,30 +45,26 @@ public:
   /** \brief construct Entry for query
    *  \note Name is implicitly convertible to Entry, so that Name can be passed to
    *        lookup functions on a container of Entry
+   *  \warning The entry refers to \p name, which must outlive it.
    */
   EntryImpl(const Name& name);
 
   /** \brief construct Entry for storage
+   *  \param nameHash NameTree hash of Data Name
    */
-  EntryImpl(shared_ptr<const Data> data, bool isUnsolicited);
+  EntryImpl(const Data& data, bool isUnsolicited, size_t nameHash);
 
   /** \return true if entry can become stale, false if entry is never stale
    */
   bool
   canStale() const;
 
-  void
-  unsetUnsolicited();
-
   bool
   operator<(const EntryImpl& other) const;
 
 private:
   bool
   isQuery() const;
-
-private:
-  Name m_queryName;
 };
 
 } // namespace cs
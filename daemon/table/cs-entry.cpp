@@ -25,18 +25,218 @@
 
 #include "cs-entry.hpp"
 
+#include <ndn-cxx/util/crypto.hpp>
+
 namespace nfd {
 namespace cs {
 
+/** \brief reads the next Name component from a Name TLV-VALUE in [pos,end)
+ *
+ *  The wire encoding has been decoded by Data before, so it is expected to be well-formed.
+ */
+static void
+readComponent(const uint8_t*& pos, const uint8_t* end,
+              uint64_t& type, const uint8_t*& value, size_t& valueSize)
+{
+  uint64_t length = 0;
+  if (!tlv::readVarNumber(pos, end, type) || !tlv::readVarNumber(pos, end, length) ||
+      length > static_cast<uint64_t>(end - pos)) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Malformed Name in CS entry"));
+  }
+  value = pos;
+  valueSize = static_cast<size_t>(length);
+  pos += valueSize;
+}
+
+/** \brief compares two Name components in the same order as name::Component::compare
+ */
+static int
+compareComponent(uint64_t type1, const uint8_t* value1, size_t valueSize1,
+                 uint64_t type2, const uint8_t* value2, size_t valueSize2)
+{
+  if (type1 != type2) {
+    return type1 < type2 ? -1 : 1;
+  }
+  if (valueSize1 != valueSize2) {
+    return valueSize1 < valueSize2 ? -1 : 1;
+  }
+  return valueSize1 == 0 ? 0 : std::memcmp(value1, value2, valueSize1);
+}
+
+Entry::Entry()
+  : m_queryName(nullptr)
+  , m_nameLength(0)
+  , m_nameSize(0)
+  , m_nameOffset(0)
+  , m_nameValueOffset(0)
+  , m_isUnsolicited(false)
+  , m_nameHash(0)
+  , m_freshnessPeriod(-1)
+{
+}
+
+Entry::Entry(const Name& name)
+  : m_queryName(&name)
+  , m_nameLength(0)
+  , m_nameSize(0)
+  , m_nameOffset(0)
+  , m_nameValueOffset(0)
+  , m_isUnsolicited(false)
+  , m_nameHash(0)
+  , m_freshnessPeriod(-1)
+{
+}
+
 void
-Entry::setData(shared_ptr<const Data> data, bool isUnsolicited)
+Entry::setData(const Data& data, bool isUnsolicited, size_t nameHash)
 {
-  m_data = data;
+  // keep the buffer but not the Block, whose sub-elements are parsed by Data
+  const Block& wire = data.wireEncode();
+  m_buffer = wire.getBuffer();
+  m_wireLocation.offset = static_cast<uint32_t>(wire.wire() - m_buffer->data());
+  m_wireLocation.size = static_cast<uint32_t>(wire.size());
+
+  const Name& name = data.getName();
+  const Block& nameWire = name.wireEncode();
+  m_nameOffset = static_cast<uint8_t>(wire.value() - wire.wire());
+  m_nameValueOffset = static_cast<uint8_t>(nameWire.value() - nameWire.wire());
+  m_nameLength = static_cast<uint32_t>(nameWire.size());
+  m_nameSize = static_cast<uint32_t>(name.size());
+  BOOST_ASSERT(m_nameLength <= wire.value_size() &&
+               std::equal(nameWire.begin(), nameWire.end(), wire.value_begin()));
+
+  m_freshnessPeriod = data.getFreshnessPeriod();
   m_isUnsolicited = isUnsolicited;
+  m_nameHash = nameHash;
 
   updateStaleTime();
 }
 
+shared_ptr<const Data>
+Entry::getData() const
+{
+  BOOST_ASSERT(this->hasData());
+  return make_shared<Data>(this->getWire());
+}
+
+Block
+Entry::getWire() const
+{
+  BOOST_ASSERT(this->hasData());
+  auto begin = m_buffer->begin() + m_wireLocation.offset;
+  return Block(m_buffer, begin, begin + m_wireLocation.size);
+}
+
+Block
+Entry::getNameWire() const
+{
+  BOOST_ASSERT(this->hasData());
+  auto begin = m_buffer->begin() + m_wireLocation.offset + m_nameOffset;
+  return Block(m_buffer, begin, begin + m_nameLength);
+}
+
+int
+Entry::compareName(const Name& other, size_t count) const
+{
+  return this->compareNamePrefix(m_nameSize, other, count);
+}
+
+int
+Entry::compareName(const Entry& other) const
+{
+  BOOST_ASSERT(this->hasData() && other.hasData());
+
+  // read both Names in place, skipping Name TLV-TYPE and TLV-LENGTH
+  const uint8_t* pos1 = this->getNameValuePtr();
+  const uint8_t* end1 = pos1 + this->getNameValueSize();
+  const uint8_t* pos2 = other.getNameValuePtr();
+  const uint8_t* end2 = pos2 + other.getNameValueSize();
+
+  while (pos1 != end1 && pos2 != end2) {
+    uint64_t type1 = 0, type2 = 0;
+    const uint8_t* value1 = nullptr;
+    const uint8_t* value2 = nullptr;
+    size_t valueSize1 = 0, valueSize2 = 0;
+    readComponent(pos1, end1, type1, value1, valueSize1);
+    readComponent(pos2, end2, type2, value2, valueSize2);
+
+    int cmp = compareComponent(type1, value1, valueSize1, type2, value2, valueSize2);
+    if (cmp != 0) {
+      return cmp;
+    }
+  }
+
+  return pos1 == end1 ? (pos2 == end2 ? 0 : -1) : 1;
+}
+
+int
+Entry::compareNamePrefix(size_t count, const Name& other, size_t otherCount) const
+{
+  BOOST_ASSERT(this->hasData());
+  count = std::min<size_t>(count, m_nameSize);
+  otherCount = std::min(otherCount, other.size());
+
+  const uint8_t* pos = this->getNameValuePtr();
+  const uint8_t* end = pos + this->getNameValueSize();
+
+  size_t minCount = std::min(count, otherCount);
+  for (size_t i = 0; i < minCount; ++i) {
+    uint64_t type = 0;
+    const uint8_t* value = nullptr;
+    size_t valueSize = 0;
+    readComponent(pos, end, type, value, valueSize);
+
+    const name::Component& component = other[i];
+    int cmp = compareComponent(type, value, valueSize,
+                               component.type(), component.value(), component.value_size());
+    if (cmp != 0) {
+      return cmp;
+    }
+  }
+
+  return count == otherCount ? 0 : (count < otherCount ? -1 : 1);
+}
+
+name::Component
+Entry::getNameComponent(size_t index) const
+{
+  BOOST_ASSERT(this->hasData() && index < m_nameSize);
+
+  const uint8_t* pos = this->getNameValuePtr();
+  const uint8_t* end = pos + this->getNameValueSize();
+
+  const uint8_t* begin = pos;
+  uint64_t type = 0;
+  const uint8_t* value = nullptr;
+  size_t valueSize = 0;
+  for (size_t i = 0; i <= index; ++i) {
+    begin = pos;
+    readComponent(pos, end, type, value, valueSize);
+  }
+
+  auto wireBegin = m_buffer->begin() + (begin - m_buffer->data());
+  return name::Component(Block(m_buffer, wireBegin, wireBegin + (pos - begin)));
+}
+
+name::Component
+Entry::getImplicitDigest() const
+{
+  BOOST_ASSERT(this->hasData());
+  // same as Data::getFullName, without decoding the Data
+  return name::Component::fromImplicitSha256Digest(ndn::crypto::sha256(this->getWirePtr(),
+                                                                       m_wireLocation.size));
+}
+
+bool
+Entry::hasSameWire(const Entry& other) const
+{
+  BOOST_ASSERT(this->hasData() && other.hasData());
+  const uint8_t* wire = this->getWirePtr();
+  const uint8_t* otherWire = other.getWirePtr();
+  return m_wireLocation.size == other.m_wireLocation.size &&
+         (wire == otherWire || std::memcmp(wire, otherWire, m_wireLocation.size) == 0);
+}
+
 bool
 Entry::isStale() const
 {
@@ -48,8 +248,8 @@ void
 Entry::updateStaleTime()
 {
   BOOST_ASSERT(this->hasData());
-  if (m_data->getFreshnessPeriod() >= time::milliseconds::zero()) {
-    m_staleTime = time::steady_clock::now() + time::milliseconds(m_data->getFreshnessPeriod());
+  if (m_freshnessPeriod >= time::milliseconds::zero()) {
+    m_staleTime = time::steady_clock::now() + m_freshnessPeriod;
   }
   else {
     m_staleTime = time::steady_clock::TimePoint::max();
@@ -60,7 +260,46 @@ bool
 Entry::canSatisfy(const Interest& interest) const
 {
   BOOST_ASSERT(this->hasData());
-  if (!interest.matchesData(*m_data)) {
+
+  // same as Interest::matchesData, but operates on Name and implicit digest
+  const Name& interestName = interest.getName();
+  size_t interestNameLength = interestName.size();
+  size_t fullNameLength = m_nameSize + 1;
+
+  size_t minSuffixComponents = std::max(interest.getMinSuffixComponents(), 0);
+  if (interestNameLength + minSuffixComponents > fullNameLength) {
+    return false;
+  }
+
+  if (interest.getMaxSuffixComponents() >= 0 &&
+      interestNameLength + interest.getMaxSuffixComponents() < fullNameLength) {
+    return false;
+  }
+
+  if (interestNameLength == fullNameLength) {
+    if (!interestName[-1].isImplicitSha256Digest() ||
+        this->compareName(interestName, interestNameLength - 1) != 0 ||
+        interestName[-1] != this->getImplicitDigest()) {
+      return false;
+    }
+  }
+  else if (interestNameLength > m_nameSize ||
+           this->compareNamePrefix(interestNameLength, interestName, interestNameLength) != 0) {
+    return false;
+  }
+
+  const Exclude& exclude = interest.getExclude();
+  if (!exclude.empty() && fullNameLength > interestNameLength) {
+    name::Component component = interestNameLength == m_nameSize ?
+                                this->getImplicitDigest() :
+                                this->getNameComponent(interestNameLength);
+    if (exclude.isExcluded(component)) {
+      return false;
+    }
+  }
+
+  if (!interest.getPublisherPublicKeyLocator().empty() &&
+      !interest.matchesData(*this->getData())) {
     return false;
   }
 
@@ -74,7 +313,14 @@ Entry::canSatisfy(const Interest& interest) const
 void
 Entry::reset()
 {
-  m_data.reset();
+  m_buffer.reset();
+  m_queryName = nullptr;
+  m_nameLength = 0;
+  m_nameSize = 0;
+  m_nameOffset = 0;
+  m_nameValueOffset = 0;
+  m_nameHash = 0;
+  m_freshnessPeriod = time::milliseconds(-1);
   m_isUnsolicited = false;
   m_staleTime = time::steady_clock::TimePoint();
 }
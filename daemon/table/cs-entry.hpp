@@ -32,38 +32,102 @@ namespace nfd {
 namespace cs {
 
 /** \brief represents a base class for CS entry
+ *
+ *  To keep per-entry overhead low, an Entry does not hold a decoded Data packet.
+ *  It keeps a reference to the buffer holding the Data wire encoding, the location of
+ *  the Data and its Name within that buffer, a hash of the Name, and FreshnessPeriod.
+ *  Name comparisons read the buffer in place. A Name, Data, or implicit digest is
+ *  materialized only when requested via getName, getData, or getImplicitDigest.
  */
 class Entry
 {
 public: // exposed through ContentStore enumeration
-  /** \return the stored Data
+  /** \return the stored Data, decoded from wire encoding
+   *  \pre hasData()
+   *  \note Each call decodes a new Data object. Use getName or getWire when possible.
+   */
+  shared_ptr<const Data>
+  getData() const;
+
+  /** \return wire encoding of the stored Data
+   *  \pre hasData()
+   *  \note The returned Block shares the buffer of the entry.
+   */
+  Block
+  getWire() const;
+
+  /** \return wire encoding of the Name of the stored Data
+   *  \pre hasData()
+   *  \note The returned Block shares the buffer of the entry.
+   */
+  Block
+  getNameWire() const;
+
+  /** \return Name of the stored Data, decoded from wire encoding
    *  \pre hasData()
+   *  \note Each call decodes a new Name. Use compareName or getNameSize when possible.
    */
-  const Data&
-  getData() const
+  Name
+  getName() const
+  {
+    return Name(this->getNameWire());
+  }
+
+  /** \return number of components in the Name of the stored Data
+   *  \pre hasData()
+   */
+  size_t
+  getNameSize() const
   {
     BOOST_ASSERT(this->hasData());
-    return *m_data;
+    return m_nameSize;
   }
 
-  /** \return Name of the stored Data
+  /** \brief compares the Name of the stored Data with the first \p count components of \p other
+   *  \return negative, zero, or positive, in the same order as Name::compare
    *  \pre hasData()
    */
-  const Name&
-  getName() const
+  int
+  compareName(const Name& other, size_t count = Name::npos) const;
+
+  /** \brief compares the Name of the stored Data with the Name of \p other
+   *  \pre hasData() && other.hasData()
+   */
+  int
+  compareName(const Entry& other) const;
+
+  /** \return NameTree hash of the Name of the stored Data
+   *  \pre hasData()
+   */
+  uint64_t
+  getNameHash() const
   {
     BOOST_ASSERT(this->hasData());
-    return m_data->getName();
+    return m_nameHash;
   }
 
+  /** \return implicit digest of the stored Data
+   *  \pre hasData()
+   *  \note The digest is not stored; each call computes it from the wire encoding.
+   */
+  name::Component
+  getImplicitDigest() const;
+
+  /** \return whether the stored Data has the same wire encoding as the Data of \p other
+   *  \pre hasData() && other.hasData()
+   *
+   *  Equal wire encodings have equal implicit digests, so the digests need not be computed.
+   */
+  bool
+  hasSameWire(const Entry& other) const;
+
   /** \return full name (including implicit digest) of the stored Data
    *  \pre hasData()
    */
-  const Name&
+  Name
   getFullName() const
   {
-    BOOST_ASSERT(this->hasData());
-    return m_data->getFullName();
+    return this->getName().append(this->getImplicitDigest());
   }
 
   /** \return whether the stored Data is unsolicited
@@ -96,6 +160,9 @@ public: // exposed through ContentStore enumeration
   /** \brief determines whether Interest can be satisified by the stored Data
    *  \note ChildSelector is not considered
    *  \pre hasData()
+   *
+   *  Name-based selectors are evaluated without decoding the Data.
+   *  The Data is decoded only if the Interest carries PublisherPublicKeyLocator.
    */
   bool
   canSatisfy(const Interest& interest) const;
@@ -106,20 +173,24 @@ public: // used by generic ContentStore implementation
   bool
   hasData() const
   {
-    return m_data != nullptr;
+    return m_buffer != nullptr;
   }
 
   /** \brief replaces the stored Data
+   *
+   *  Only the wire encoding of \p data is retained.
+   *  \param nameHash NameTree hash of Data Name, see name_tree::HashContext::getFullHash
    */
   void
-  setData(shared_ptr<const Data> data, bool isUnsolicited);
+  setData(const Data& data, bool isUnsolicited, size_t nameHash);
 
-  /** \brief replaces the stored Data
+  /** \brief marks the stored Data as solicited
    */
   void
-  setData(const Data& data, bool isUnsolicited)
+  unsetUnsolicited()
   {
-    this->setData(data.shared_from_this(), isUnsolicited);
+    BOOST_ASSERT(this->hasData());
+    m_isUnsolicited = false;
   }
 
   /** \brief refreshes stale time relative to current time
@@ -127,15 +198,110 @@ public: // used by generic ContentStore implementation
   void
   updateStaleTime();
 
+  /** \brief sets stale time to an absolute time
+   *
+   *  This is used when an entry is restored with its original stale time.
+   */
+  void
+  setStaleTime(const time::steady_clock::TimePoint& staleTime)
+  {
+    m_staleTime = staleTime;
+  }
+
   /** \brief clears the entry
    *  \post !hasData()
    */
   void
   reset();
 
+protected:
+  Entry();
+
+  /** \brief constructs an entry without Data, whose Name is \p name
+   */
+  explicit
+  Entry(const Name& name);
+
+  /** \return Name of an entry without Data
+   *  \pre !hasData()
+   */
+  const Name&
+  getQueryName() const
+  {
+    BOOST_ASSERT(!this->hasData());
+    return *m_queryName;
+  }
+
 private:
-  shared_ptr<const Data> m_data;
+  /** \brief compares the first \p count components of the Name of the stored Data
+   *         with the first \p otherCount components of \p other
+   */
+  int
+  compareNamePrefix(size_t count, const Name& other, size_t otherCount) const;
+
+  /** \return the component at \p index in the Name of the stored Data
+   */
+  name::Component
+  getNameComponent(size_t index) const;
+
+  /** \return start of the Data TLV in the buffer
+   */
+  const uint8_t*
+  getWirePtr() const
+  {
+    return m_buffer->data() + m_wireLocation.offset;
+  }
+
+  /** \return start of the Name TLV-VALUE in the buffer
+   */
+  const uint8_t*
+  getNameValuePtr() const
+  {
+    return this->getWirePtr() + m_nameOffset + m_nameValueOffset;
+  }
+
+  /** \return length of the Name TLV-VALUE
+   */
+  size_t
+  getNameValueSize() const
+  {
+    return m_nameLength - m_nameValueOffset;
+  }
+
+private:
+  struct WireLocation
+  {
+    uint32_t offset; ///< offset of Data TLV in the buffer
+    uint32_t size; ///< length of Data TLV
+  };
+
+  /** \brief buffer holding the Data wire encoding, nullptr for an entry without Data
+   *
+   *  The entry does not hold a Block, which would carry its own iterators and sub-elements.
+   */
+  ndn::ConstBufferPtr m_buffer;
+
+  union
+  {
+    /** \brief location of the Data in m_buffer, when hasData()
+     */
+    WireLocation m_wireLocation;
+
+    /** \brief Name of an entry without Data
+     *
+     *  A query entry only lives during a lookup, so it refers to the Name given by the caller.
+     */
+    const Name* m_queryName;
+  };
+
+  uint32_t m_nameLength; ///< length of Name TLV
+  uint32_t m_nameSize; ///< number of Name components
+  uint8_t m_nameOffset; ///< offset of Name TLV within Data TLV, i.e. length of Data TLV header
+  uint8_t m_nameValueOffset; ///< length of Name TLV header
   bool m_isUnsolicited;
+
+  uint64_t m_nameHash;
+  time::milliseconds m_freshnessPeriod;
   time::steady_clock::TimePoint m_staleTime;
 };
 
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-arc.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace arc {
+
+const std::string ArcPolicy::POLICY_NAME = "arc";
+
+void
+GhostList::pushBack(uint64_t nameHash)
+{
+  this->erase(nameHash);
+  m_index[nameHash] = m_queue.insert(m_queue.end(), nameHash);
+}
+
+void
+GhostList::popFront()
+{
+  BOOST_ASSERT(!m_queue.empty());
+  m_index.erase(m_queue.front());
+  m_queue.pop_front();
+}
+
+bool
+GhostList::erase(uint64_t nameHash)
+{
+  auto it = m_index.find(nameHash);
+  if (it == m_index.end()) {
+    return false;
+  }
+  m_queue.erase(it->second);
+  m_index.erase(it);
+  return true;
+}
+
+ArcPolicy::ArcPolicy()
+  : Policy(POLICY_NAME)
+  , m_targetRecentSize(0)
+  , m_isInsertingFrequentGhost(false)
+{
+}
+
+void
+ArcPolicy::doAfterInsert(iterator i)
+{
+  uint64_t nameHash = i->getNameHash();
+  size_t nRecentGhosts = m_ghostLists[QUEUE_RECENT].size();
+  size_t nFrequentGhosts = m_ghostLists[QUEUE_FREQUENT].size();
+
+  if (m_ghostLists[QUEUE_RECENT].erase(nameHash)) {
+    // T1 was too small: grow its target
+    size_t delta = std::max<size_t>(1, nFrequentGhosts / nRecentGhosts);
+    m_targetRecentSize = std::min(this->getLimit(), m_targetRecentSize + delta);
+    this->attachQueue(i, QUEUE_FREQUENT);
+  }
+  else if (m_ghostLists[QUEUE_FREQUENT].erase(nameHash)) {
+    // T2 was too small: shrink target of T1
+    size_t delta = std::max<size_t>(1, nRecentGhosts / nFrequentGhosts);
+    m_targetRecentSize = m_targetRecentSize > delta ? m_targetRecentSize - delta : 0;
+    this->attachQueue(i, QUEUE_FREQUENT);
+    m_isInsertingFrequentGhost = true;
+  }
+  else {
+    this->attachQueue(i, QUEUE_RECENT);
+  }
+
+  this->evictEntries();
+  m_isInsertingFrequentGhost = false;
+}
+
+void
+ArcPolicy::doAfterRefresh(iterator i)
+{
+  this->moveToFrequent(i);
+}
+
+void
+ArcPolicy::doBeforeErase(iterator i)
+{
+  this->detachQueue(i);
+}
+
+void
+ArcPolicy::doBeforeUse(iterator i)
+{
+  this->moveToFrequent(i);
+}
+
+iterator
+ArcPolicy::doPeekVictim()
+{
+  const Queue& queue = m_queues[this->selectVictimQueue()];
+  BOOST_ASSERT(!queue.empty());
+  return queue.front();
+}
+
+void
+ArcPolicy::doGetEvictionOrder(std::vector<iterator>& order) const
+{
+  order.insert(order.end(), m_queues[QUEUE_RECENT].begin(), m_queues[QUEUE_RECENT].end());
+  order.insert(order.end(), m_queues[QUEUE_FREQUENT].begin(), m_queues[QUEUE_FREQUENT].end());
+}
+
+void
+ArcPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  while (this->getCs()->size() > this->getLimit()) {
+    QueueType queueType = this->selectVictimQueue();
+    BOOST_ASSERT(!m_queues[queueType].empty());
+    iterator i = m_queues[queueType].front();
+    this->detachQueue(i);
+    m_ghostLists[queueType].pushBack(i->getNameHash());
+    this->emitSignal(beforeEvict, i);
+  }
+
+  this->trimGhostLists();
+}
+
+void
+ArcPolicy::attachQueue(iterator i, QueueType queueType)
+{
+  Queue& queue = m_queues[queueType];
+  EntryInfo& entryInfo = m_entryInfoMap[&*i];
+  entryInfo.queueType = queueType;
+  entryInfo.queueIt = queue.insert(queue.end(), i);
+}
+
+void
+ArcPolicy::detachQueue(iterator i)
+{
+  auto it = m_entryInfoMap.find(&*i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+  m_queues[it->second.queueType].erase(it->second.queueIt);
+  m_entryInfoMap.erase(it);
+}
+
+void
+ArcPolicy::moveToFrequent(iterator i)
+{
+  EntryInfo& entryInfo = m_entryInfoMap.at(&*i);
+  Queue& frequent = m_queues[QUEUE_FREQUENT];
+  // splice does not allocate, and keeps queueIt valid
+  frequent.splice(frequent.end(), m_queues[entryInfo.queueType], entryInfo.queueIt);
+  entryInfo.queueType = QUEUE_FREQUENT;
+}
+
+QueueType
+ArcPolicy::selectVictimQueue() const
+{
+  size_t nRecent = m_queues[QUEUE_RECENT].size();
+  if (nRecent > 0 &&
+      (nRecent > m_targetRecentSize ||
+       (m_isInsertingFrequentGhost && nRecent == m_targetRecentSize) ||
+       m_queues[QUEUE_FREQUENT].empty())) {
+    return QUEUE_RECENT;
+  }
+  return QUEUE_FREQUENT;
+}
+
+void
+ArcPolicy::trimGhostLists()
+{
+  size_t limit = this->getLimit();
+  size_t nRecent = m_queues[QUEUE_RECENT].size();
+  size_t nFrequent = m_queues[QUEUE_FREQUENT].size();
+  GhostList& recentGhosts = m_ghostLists[QUEUE_RECENT];
+  GhostList& frequentGhosts = m_ghostLists[QUEUE_FREQUENT];
+
+  while (!recentGhosts.empty() && nRecent + recentGhosts.size() > limit) {
+    recentGhosts.popFront();
+  }
+  while (!frequentGhosts.empty() &&
+         nRecent + nFrequent + recentGhosts.size() + frequentGhosts.size() > 2 * limit) {
+    frequentGhosts.popFront();
+  }
+}
+
+} // namespace arc
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+
+#include "cs-policy.hpp"
+#include "common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace arc {
+
+typedef std::list<iterator> Queue;
+typedef Queue::iterator QueueIt;
+
+enum QueueType {
+  QUEUE_RECENT,   ///< T1: entries used once since insertion
+  QUEUE_FREQUENT, ///< T2: entries used at least twice
+  QUEUE_MAX
+};
+
+/** \brief a list of Name hashes of recently evicted entries
+ *
+ *  Ghost lists remember only Entry::getNameHash, not the Data,
+ *  so that their memory overhead is a few tens of bytes per evicted entry.
+ */
+class GhostList
+{
+public:
+  bool
+  contains(uint64_t nameHash) const
+  {
+    return m_index.count(nameHash) > 0;
+  }
+
+  /** \brief appends \p nameHash as the most recent item
+   */
+  void
+  pushBack(uint64_t nameHash);
+
+  /** \brief removes the least recent item
+   *  \pre size() > 0
+   */
+  void
+  popFront();
+
+  /** \brief removes \p nameHash
+   *  \return whether \p nameHash was in the list
+   */
+  bool
+  erase(uint64_t nameHash);
+
+  size_t
+  size() const
+  {
+    return m_queue.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_queue.empty();
+  }
+
+private:
+  std::list<uint64_t> m_queue;
+  std::unordered_map<uint64_t, std::list<uint64_t>::iterator> m_index;
+};
+
+struct EntryInfo
+{
+  QueueType queueType;
+  QueueIt queueIt;
+};
+
+typedef std::unordered_map<const Entry*, EntryInfo> EntryInfoMapArc;
+
+/** \brief Adaptive Replacement Cache (ARC) cs replacement policy
+ *
+ * Entries are kept in two LRU queues: T1 holds entries that have not been used since insertion,
+ * T2 holds entries that have been used at least once more.
+ * A sequential scan only passes through T1, so it cannot flush frequently used entries in T2.
+ * Two ghost lists B1 and B2 remember Name hashes of entries recently evicted from T1 and T2.
+ * A miss that hits a ghost list shifts the target size of T1 towards the queue
+ * whose ghost was hit, so that the split between recency and frequency adapts to the workload.
+ *
+ * \sa Nimrod Megiddo and Dharmendra S. Modha, "ARC: A Self-Tuning, Low Overhead
+ *     Replacement Cache", FAST 2003
+ */
+class ArcPolicy : public Policy
+{
+public:
+  ArcPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  /** \return target size of T1
+   */
+  size_t
+  getTargetRecentSize() const
+  {
+    return m_targetRecentSize;
+  }
+
+  size_t
+  getQueueSize(QueueType queueType) const
+  {
+    return m_queues[queueType].size();
+  }
+
+  size_t
+  getGhostListSize(QueueType queueType) const
+  {
+    return m_ghostLists[queueType].size();
+  }
+
+private:
+  virtual void
+  doAfterInsert(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doAfterRefresh(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeErase(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeUse(iterator i) DECL_OVERRIDE;
+
+  virtual iterator
+  doPeekVictim() DECL_OVERRIDE;
+
+  virtual void
+  doGetEvictionOrder(std::vector<iterator>& order) const DECL_OVERRIDE;
+
+  virtual void
+  evictEntries() DECL_OVERRIDE;
+
+private:
+  /** \brief appends an entry to the end of a queue
+   */
+  void
+  attachQueue(iterator i, QueueType queueType);
+
+  /** \brief removes an entry from its queue
+   */
+  void
+  detachQueue(iterator i);
+
+  /** \brief moves an entry to the end of T2
+   */
+  void
+  moveToFrequent(iterator i);
+
+  /** \return the queue from which the next victim is taken
+   */
+  QueueType
+  selectVictimQueue() const;
+
+  /** \brief bounds ghost lists so that |T1|+|B1| <= c and |T1|+|T2|+|B1|+|B2| <= 2c
+   */
+  void
+  trimGhostLists();
+
+private:
+  Queue m_queues[QUEUE_MAX];
+  GhostList m_ghostLists[QUEUE_MAX];
+  EntryInfoMapArc m_entryInfoMap;
+
+  /** \brief target size of T1, known as p in ARC paper
+   */
+  size_t m_targetRecentSize;
+
+  /** \brief whether the entry being inserted was found in B2
+   *
+   *  ARC paper breaks the tie |T1| == p in favor of evicting from T1 in this case.
+   */
+  bool m_isInsertingFrequentGhost;
+};
+
+} // namespace arc
+
+using arc::ArcPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
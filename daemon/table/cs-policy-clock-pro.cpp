@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-clock-pro.hpp"
+#include "cs.hpp"
+
+namespace nfd {
+namespace cs {
+namespace clock_pro {
+
+const std::string ClockProPolicy::POLICY_NAME = "clock-pro";
+
+ClockProPolicy::ClockProPolicy()
+  : Policy(POLICY_NAME)
+  , m_handHot(m_clock.end())
+  , m_handCold(m_clock.end())
+  , m_handTest(m_clock.end())
+  , m_nHot(0)
+  , m_nCold(0)
+  , m_nNonResident(0)
+  , m_coldTarget(1)
+{
+}
+
+void
+ClockProPolicy::doAfterInsert(iterator i)
+{
+  Page page;
+  page.isReferenced = false;
+  page.nameHash = i->getNameHash();
+  page.entry = i;
+
+  auto nonResident = m_nonResidentPages.find(page.nameHash);
+  if (nonResident != m_nonResidentPages.end()) {
+    // reused during test period: cold pages deserve more room
+    m_coldTarget = std::min(m_coldTarget + 1, std::max<size_t>(1, this->getLimit() - 1));
+    ClockIt it = nonResident->second;
+    m_nonResidentPages.erase(nonResident);
+    this->erasePage(it);
+    --m_nNonResident;
+
+    page.status = PAGE_HOT;
+    page.isInTest = false;
+    ++m_nHot;
+  }
+  else {
+    page.status = PAGE_COLD;
+    page.isInTest = true;
+    ++m_nCold;
+  }
+
+  m_residentPages[&*i] = this->insertPage(page);
+  this->evictEntries();
+}
+
+void
+ClockProPolicy::doAfterRefresh(iterator i)
+{
+  m_residentPages.at(&*i)->isReferenced = true;
+}
+
+void
+ClockProPolicy::doBeforeErase(iterator i)
+{
+  auto resident = m_residentPages.find(&*i);
+  BOOST_ASSERT(resident != m_residentPages.end());
+  ClockIt it = resident->second;
+  m_residentPages.erase(resident);
+
+  if (it->status == PAGE_HOT) {
+    --m_nHot;
+  }
+  else {
+    --m_nCold;
+  }
+  this->erasePage(it);
+}
+
+void
+ClockProPolicy::doBeforeUse(iterator i)
+{
+  m_residentPages.at(&*i)->isReferenced = true;
+}
+
+iterator
+ClockProPolicy::doPeekVictim()
+{
+  return this->findColdVictim()->entry;
+}
+
+void
+ClockProPolicy::doGetEvictionOrder(std::vector<iterator>& order) const
+{
+  if (m_clock.empty()) {
+    return;
+  }
+
+  // cold pages in HAND_cold order, followed by hot pages
+  std::vector<iterator> hotEntries;
+  Clock::const_iterator it = m_handCold;
+  do {
+    if (it->status == PAGE_COLD) {
+      order.push_back(it->entry);
+    }
+    else if (it->status == PAGE_HOT) {
+      hotEntries.push_back(it->entry);
+    }
+    if (++it == m_clock.end()) {
+      it = m_clock.begin();
+    }
+  } while (it != Clock::const_iterator(m_handCold));
+
+  order.insert(order.end(), hotEntries.begin(), hotEntries.end());
+}
+
+void
+ClockProPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  m_coldTarget = std::min(m_coldTarget, std::max<size_t>(1, this->getLimit() - 1));
+
+  while (m_nHot > this->getHotTarget()) {
+    this->runHandHot();
+  }
+
+  while (this->getCs()->size() > this->getLimit()) {
+    ClockIt it = this->findColdVictim();
+    iterator i = it->entry;
+    m_residentPages.erase(&*i);
+    --m_nCold;
+
+    if (it->isInTest) {
+      // keep only Name hash until test period ends
+      it->status = PAGE_NON_RESIDENT;
+      ++m_nNonResident;
+      auto inserted = m_nonResidentPages.insert(std::make_pair(it->nameHash, it));
+      if (!inserted.second) { // same Name was evicted before, drop the older page
+        ClockIt older = inserted.first->second;
+        inserted.first->second = it;
+        this->erasePage(older);
+        --m_nNonResident;
+      }
+      this->advanceHand(m_handCold);
+    }
+    else {
+      this->erasePage(it);
+    }
+
+    this->emitSignal(beforeEvict, i);
+  }
+
+  while (m_nNonResident > this->getLimit()) {
+    this->runHandTest();
+  }
+}
+
+ClockIt
+ClockProPolicy::insertPage(const Page& page)
+{
+  if (m_clock.empty()) {
+    ClockIt it = m_clock.insert(m_clock.end(), page);
+    m_handHot = m_handCold = m_handTest = it;
+    return it;
+  }
+
+  return m_clock.insert(m_handHot, page);
+}
+
+void
+ClockProPolicy::erasePage(ClockIt it)
+{
+  this->moveHandsOff(it);
+  m_clock.erase(it);
+
+  if (m_clock.empty()) {
+    m_handHot = m_handCold = m_handTest = m_clock.end();
+  }
+}
+
+void
+ClockProPolicy::movePageToHead(ClockIt it)
+{
+  if (m_clock.size() == 1) {
+    return;
+  }
+
+  this->moveHandsOff(it);
+  m_clock.splice(m_handHot, m_clock, it);
+}
+
+void
+ClockProPolicy::advanceHand(ClockIt& hand)
+{
+  BOOST_ASSERT(!m_clock.empty());
+  if (++hand == m_clock.end()) {
+    hand = m_clock.begin();
+  }
+}
+
+void
+ClockProPolicy::moveHandsOff(ClockIt it)
+{
+  for (ClockIt* hand : {&m_handHot, &m_handCold, &m_handTest}) {
+    if (*hand == it) {
+      this->advanceHand(*hand);
+    }
+  }
+}
+
+ClockIt
+ClockProPolicy::findColdVictim()
+{
+  BOOST_ASSERT(m_nHot + m_nCold > 0);
+  while (true) {
+    if (m_nCold == 0) {
+      this->runHandHot();
+      continue;
+    }
+
+    ClockIt it = m_handCold;
+    if (it->status != PAGE_COLD) {
+      this->advanceHand(m_handCold);
+      continue;
+    }
+
+    if (!it->isReferenced) {
+      return it;
+    }
+
+    it->isReferenced = false;
+    if (it->isInTest) {
+      // reused during test period: promote to hot
+      it->status = PAGE_HOT;
+      it->isInTest = false;
+      --m_nCold;
+      ++m_nHot;
+      this->movePageToHead(it);
+      while (m_nHot > this->getHotTarget()) {
+        this->runHandHot();
+      }
+    }
+    else {
+      // start a new test period
+      it->isInTest = true;
+      this->movePageToHead(it);
+    }
+  }
+}
+
+void
+ClockProPolicy::runHandHot()
+{
+  while (m_nHot > 0) {
+    ClockIt it = m_handHot;
+    this->advanceHand(m_handHot);
+
+    if (it->status == PAGE_HOT) {
+      if (it->isReferenced) {
+        it->isReferenced = false;
+        continue;
+      }
+      it->status = PAGE_COLD;
+      it->isInTest = false;
+      --m_nHot;
+      ++m_nCold;
+      return;
+    }
+
+    if (it->isInTest) {
+      this->endTestPeriod(it);
+    }
+  }
+}
+
+void
+ClockProPolicy::runHandTest()
+{
+  while (m_nNonResident > 0) {
+    ClockIt it = m_handTest;
+    this->advanceHand(m_handTest);
+
+    if (it->status == PAGE_NON_RESIDENT) {
+      this->endTestPeriod(it);
+      return;
+    }
+
+    if (it->status == PAGE_COLD && it->isInTest) {
+      this->endTestPeriod(it);
+    }
+  }
+}
+
+void
+ClockProPolicy::endTestPeriod(ClockIt it)
+{
+  if (m_coldTarget > 1) {
+    --m_coldTarget;
+  }
+
+  if (it->status == PAGE_NON_RESIDENT) {
+    m_nonResidentPages.erase(it->nameHash);
+    this->erasePage(it);
+    --m_nNonResident;
+  }
+  else {
+    it->isInTest = false;
+  }
+}
+
+} // namespace clock_pro
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_CLOCK_PRO_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_CLOCK_PRO_HPP
+
+#include "cs-policy.hpp"
+#include "common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace clock_pro {
+
+enum PageStatus {
+  PAGE_HOT,
+  PAGE_COLD,        ///< resident cold page
+  PAGE_NON_RESIDENT ///< evicted cold page in its test period, only Name hash is kept
+};
+
+struct Page
+{
+  PageStatus status;
+  bool isReferenced;
+  bool isInTest;
+  uint64_t nameHash;
+  iterator entry; ///< valid if status != PAGE_NON_RESIDENT
+};
+
+typedef std::list<Page> Clock;
+typedef Clock::iterator ClockIt;
+
+typedef std::unordered_map<const Entry*, ClockIt> ResidentPageMap;
+typedef std::unordered_map<uint64_t, ClockIt> NonResidentPageMap;
+
+/** \brief CLOCK-Pro cs replacement policy
+ *
+ * All entries are kept on one circular list (the clock), classified as hot or cold.
+ * A hit only sets a reference bit on the page, without reordering any list.
+ * Three hands sweep the clock:
+ * HAND_cold evicts unreferenced cold pages, and promotes cold pages that are referenced
+ * during their test period to hot;
+ * HAND_hot demotes unreferenced hot pages to cold, and ends test periods it passes;
+ * HAND_test ends test periods and drops non-resident pages when there are too many of them.
+ * A cold page evicted during its test period stays on the clock as a non-resident page that
+ * remembers only the Name hash. If it is inserted again before its test period ends,
+ * it becomes hot right away, and the target number of cold pages grows.
+ * When a test period ends without reuse, the target shrinks.
+ * One-time sequential scans therefore stay cold and are evicted without disturbing hot pages.
+ *
+ * \sa Song Jiang, Feng Chen, and Xiaodong Zhang, "CLOCK-Pro: An Effective Improvement
+ *     of the CLOCK Replacement", USENIX ATC 2005
+ */
+class ClockProPolicy : public Policy
+{
+public:
+  ClockProPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+  /** \return target number of resident cold pages
+   */
+  size_t
+  getColdTarget() const
+  {
+    return m_coldTarget;
+  }
+
+  size_t
+  getNHotPages() const
+  {
+    return m_nHot;
+  }
+
+  size_t
+  getNColdPages() const
+  {
+    return m_nCold;
+  }
+
+  size_t
+  getNNonResidentPages() const
+  {
+    return m_nNonResident;
+  }
+
+private:
+  virtual void
+  doAfterInsert(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doAfterRefresh(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeErase(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeUse(iterator i) DECL_OVERRIDE;
+
+  virtual iterator
+  doPeekVictim() DECL_OVERRIDE;
+
+  virtual void
+  doGetEvictionOrder(std::vector<iterator>& order) const DECL_OVERRIDE;
+
+  virtual void
+  evictEntries() DECL_OVERRIDE;
+
+private: // clock
+  /** \brief inserts a page at list head, which is just behind HAND_hot
+   */
+  ClockIt
+  insertPage(const Page& page);
+
+  /** \brief removes a page from the clock, moving hands off it
+   */
+  void
+  erasePage(ClockIt it);
+
+  /** \brief moves a page to list head
+   */
+  void
+  movePageToHead(ClockIt it);
+
+  /** \brief advances a hand by one page, wrapping around
+   */
+  void
+  advanceHand(ClockIt& hand);
+
+  /** \brief moves any hand pointing at \p it to the next page
+   */
+  void
+  moveHandsOff(ClockIt it);
+
+private: // hands
+  /** \brief runs HAND_cold until it points at an unreferenced resident cold page
+   *  \pre m_nHot + m_nCold > 0
+   *
+   *  Referenced cold pages passed by the hand are promoted or have their test period restarted.
+   */
+  ClockIt
+  findColdVictim();
+
+  /** \brief runs HAND_hot until one hot page is demoted
+   */
+  void
+  runHandHot();
+
+  /** \brief runs HAND_test until one non-resident page is dropped
+   */
+  void
+  runHandTest();
+
+  /** \brief ends test period of a page
+   *
+   *  A non-resident page is dropped. The cold target shrinks,
+   *  because the page was not reused during its test period.
+   */
+  void
+  endTestPeriod(ClockIt it);
+
+  size_t
+  getHotTarget() const
+  {
+    return this->getLimit() > m_coldTarget ? this->getLimit() - m_coldTarget : 0;
+  }
+
+private:
+  Clock m_clock;
+  ClockIt m_handHot;
+  ClockIt m_handCold;
+  ClockIt m_handTest;
+  ResidentPageMap m_residentPages;
+  NonResidentPageMap m_nonResidentPages;
+
+  size_t m_nHot;
+  size_t m_nCold;
+  size_t m_nNonResident;
+
+  /** \brief target number of resident cold pages, known as m_c in CLOCK-Pro paper
+   */
+  size_t m_coldTarget;
+};
+
+} // namespace clock_pro
+
+using clock_pro::ClockProPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_CLOCK_PRO_HPP
@@ -63,6 +63,19 @@ LruPolicy::doBeforeUse(iterator i)
   this->insertToQueue(i, false);
 }
 
+iterator
+LruPolicy::doPeekVictim()
+{
+  BOOST_ASSERT(!m_queue.empty());
+  return m_queue.front();
+}
+
+void
+LruPolicy::doGetEvictionOrder(std::vector<iterator>& order) const
+{
+  order.insert(order.end(), m_queue.begin(), m_queue.end());
+}
+
 void
 LruPolicy::evictEntries()
 {
@@ -83,6 +83,12 @@ private:
   virtual void
   doBeforeUse(iterator i) DECL_OVERRIDE;
 
+  virtual iterator
+  doPeekVictim() DECL_OVERRIDE;
+
+  virtual void
+  doGetEvictionOrder(std::vector<iterator>& order) const DECL_OVERRIDE;
+
   virtual void
   evictEntries() DECL_OVERRIDE;
 
@@ -32,6 +32,7 @@ namespace cs {
 namespace priority_fifo {
 
 const std::string PriorityFifoPolicy::POLICY_NAME = "fifo";
+const time::nanoseconds PriorityFifoPolicy::STALE_SLOT_DURATION = time::seconds(1);
 
 PriorityFifoPolicy::PriorityFifoPolicy()
   : Policy(POLICY_NAME)
@@ -62,36 +63,54 @@ void
 PriorityFifoPolicy::doBeforeUse(iterator i)
 {
   BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
-}
-
-void
-PriorityFifoPolicy::evictEntries()
-{
-  BOOST_ASSERT(this->getCs() != nullptr);
 
-  while (this->getCs()->size() > this->getLimit()) {
-    this->evictOne();
+  if (i->isStale() && m_entryInfoMap[i]->queueType == QUEUE_FIFO) {
+    this->moveToStaleQueue(i);
   }
 }
 
-void
-PriorityFifoPolicy::evictOne()
+iterator
+PriorityFifoPolicy::doPeekVictim()
 {
+  if (m_queues[QUEUE_UNSOLICITED].empty() && m_queues[QUEUE_STALE].empty()) {
+    this->moveStaleEntries(time::steady_clock::now(), 1);
+  }
+
   BOOST_ASSERT(!m_queues[QUEUE_UNSOLICITED].empty() ||
                !m_queues[QUEUE_STALE].empty() ||
                !m_queues[QUEUE_FIFO].empty());
 
-  iterator i;
   if (!m_queues[QUEUE_UNSOLICITED].empty()) {
-    i = m_queues[QUEUE_UNSOLICITED].front();
+    return m_queues[QUEUE_UNSOLICITED].front();
   }
   else if (!m_queues[QUEUE_STALE].empty()) {
-    i = m_queues[QUEUE_STALE].front();
+    return m_queues[QUEUE_STALE].front();
+  }
+  return m_queues[QUEUE_FIFO].front();
+}
+
+void
+PriorityFifoPolicy::doGetEvictionOrder(std::vector<iterator>& order) const
+{
+  for (const Queue& queue : m_queues) {
+    order.insert(order.end(), queue.begin(), queue.end());
   }
-  else if (!m_queues[QUEUE_FIFO].empty()) {
-    i = m_queues[QUEUE_FIFO].front();
+}
+
+void
+PriorityFifoPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->getCs()->size() > this->getLimit()) {
+    this->evictOne();
   }
+}
 
+void
+PriorityFifoPolicy::evictOne()
+{
+  iterator i = this->doPeekVictim();
   this->detachQueue(i);
   this->emitSignal(beforeEvict, i);
 }
@@ -102,6 +121,7 @@ PriorityFifoPolicy::attachQueue(iterator i)
   BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
 
   EntryInfo* entryInfo = new EntryInfo();
+  entryInfo->hasStaleBucket = false;
   if (i->isUnsolicited()) {
     entryInfo->queueType = QUEUE_UNSOLICITED;
   }
@@ -112,8 +132,7 @@ PriorityFifoPolicy::attachQueue(iterator i)
     entryInfo->queueType = QUEUE_FIFO;
 
     if (i->canStale()) {
-      entryInfo->moveStaleEventId = scheduler::schedule(i->getData().getFreshnessPeriod(),
-                                              bind(&PriorityFifoPolicy::moveToStaleQueue, this, i));
+      this->attachStaleBucket(i, entryInfo);
     }
   }
 
@@ -128,12 +147,11 @@ PriorityFifoPolicy::detachQueue(iterator i)
   BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
 
   EntryInfo* entryInfo = m_entryInfoMap[i];
-  if (entryInfo->queueType == QUEUE_FIFO) {
-    scheduler::cancel(entryInfo->moveStaleEventId);
-  }
+  this->detachStaleBucket(entryInfo);
 
   m_queues[entryInfo->queueType].erase(entryInfo->queueIt);
   m_entryInfoMap.erase(i);
+  delete entryInfo;
 }
 
 void
@@ -145,11 +163,83 @@ PriorityFifoPolicy::moveToStaleQueue(iterator i)
   BOOST_ASSERT(entryInfo->queueType == QUEUE_FIFO);
 
   m_queues[QUEUE_FIFO].erase(entryInfo->queueIt);
+  this->detachStaleBucket(entryInfo);
 
   entryInfo->queueType = QUEUE_STALE;
   Queue& queue = m_queues[QUEUE_STALE];
   entryInfo->queueIt = queue.insert(queue.end(), i);
-  m_entryInfoMap[i] = entryInfo;
+}
+
+void
+PriorityFifoPolicy::attachStaleBucket(iterator i, EntryInfo* entryInfo)
+{
+  BOOST_ASSERT(i->canStale());
+  BOOST_ASSERT(!entryInfo->hasStaleBucket);
+
+  StaleBuckets::iterator bucketIt = m_staleBuckets.insert(
+    std::make_pair(getStaleSlot(i->getStaleTime()), StaleBucket())).first;
+  StaleBucket& bucket = bucketIt->second;
+
+  QueueIt pos = bucket.entries.end();
+  if (bucket.isSorted) {
+    while (pos != bucket.entries.begin() &&
+           i->getStaleTime() < (*std::prev(pos))->getStaleTime()) {
+      --pos;
+    }
+  }
+
+  entryInfo->hasStaleBucket = true;
+  entryInfo->staleBucketIt = bucketIt;
+  entryInfo->staleBucketEntryIt = bucket.entries.insert(pos, i);
+}
+
+void
+PriorityFifoPolicy::detachStaleBucket(EntryInfo* entryInfo)
+{
+  if (!entryInfo->hasStaleBucket) {
+    return;
+  }
+
+  Queue& entries = entryInfo->staleBucketIt->second.entries;
+  entries.erase(entryInfo->staleBucketEntryIt);
+  if (entries.empty()) {
+    m_staleBuckets.erase(entryInfo->staleBucketIt);
+  }
+  entryInfo->hasStaleBucket = false;
+}
+
+void
+PriorityFifoPolicy::moveStaleEntries(const time::steady_clock::TimePoint& now, size_t nMax)
+{
+  int64_t nowSlot = getStaleSlot(now);
+
+  for (size_t nMoved = 0; nMoved < nMax && !m_staleBuckets.empty(); ++nMoved) {
+    StaleBuckets::iterator bucketIt = m_staleBuckets.begin();
+    if (bucketIt->first > nowSlot) {
+      return;
+    }
+
+    StaleBucket& bucket = bucketIt->second;
+    if (!bucket.isSorted) {
+      bucket.entries.sort([] (const iterator& a, const iterator& b) {
+          return a->getStaleTime() < b->getStaleTime();
+        });
+      bucket.isSorted = true;
+    }
+
+    // a bucket is never empty; it's erased when its last entry is detached
+    iterator i = bucket.entries.front();
+    if (!(i->getStaleTime() < now)) {
+      return;
+    }
+    this->moveToStaleQueue(i);
+  }
+}
+
+int64_t
+PriorityFifoPolicy::getStaleSlot(const time::steady_clock::TimePoint& staleTime)
+{
+  return staleTime.time_since_epoch() / STALE_SLOT_DURATION;
 }
 
 } // namespace priorityfifo
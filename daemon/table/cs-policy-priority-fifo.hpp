@@ -28,7 +28,6 @@
 
 #include "cs-policy.hpp"
 #include "common.hpp"
-#include "core/scheduler.hpp"
 
 namespace nfd {
 namespace cs {
@@ -44,11 +43,40 @@ enum QueueType {
   QUEUE_MAX
 };
 
+/** \brief entries in FIFO queue whose stale time falls into the same time slot
+ */
+struct StaleBucket
+{
+  StaleBucket()
+    : isSorted(false)
+  {
+  }
+
+  Queue entries;
+
+  /** \brief whether entries are sorted by stale time
+   *
+   *  A bucket is sorted once when its time slot is reached, and kept sorted afterwards.
+   */
+  bool isSorted;
+};
+
+/** \brief stale buckets indexed by time slot number
+ */
+typedef std::map<int64_t, StaleBucket> StaleBuckets;
+
 struct EntryInfo
 {
   QueueType queueType;
   QueueIt queueIt;
-  scheduler::EventId moveStaleEventId;
+
+  /** \brief whether the entry is in a stale bucket
+   *
+   *  An entry is in a stale bucket if it's in FIFO queue and can become stale.
+   */
+  bool hasStaleBucket;
+  StaleBuckets::iterator staleBucketIt;
+  QueueIt staleBucketEntryIt;
 };
 
 struct EntryItComparator
@@ -69,6 +97,11 @@ typedef std::map<iterator, EntryInfo*, EntryItComparator> EntryInfoMapFifo;
  * forwarding of the corresponding Interest packet.
  * Next, the Data packets with expired freshness are removed.
  * Last, the Data packets are removed from the Content Store on a pure FIFO basis.
+ *
+ * Staleness is tracked without timers: entries in FIFO queue are indexed by stale time
+ * in coarse time slots (STALE_SLOT_DURATION).
+ * Stale entries are moved to the STALE queue lazily, when the entry is used,
+ * and incrementally when an eviction victim needs to be found.
  */
 class PriorityFifoPolicy : public Policy
 {
@@ -78,6 +111,10 @@ public:
 public:
   static const std::string POLICY_NAME;
 
+  /** \brief duration of a time slot in stale bucket index
+   */
+  static const time::nanoseconds STALE_SLOT_DURATION;
+
 private:
   virtual void
   doAfterInsert(iterator i) DECL_OVERRIDE;
@@ -91,6 +128,12 @@ private:
   virtual void
   doBeforeUse(iterator i) DECL_OVERRIDE;
 
+  virtual iterator
+  doPeekVictim() DECL_OVERRIDE;
+
+  virtual void
+  doGetEvictionOrder(std::vector<iterator>& order) const DECL_OVERRIDE;
+
   virtual void
   evictEntries() DECL_OVERRIDE;
 
@@ -118,9 +161,33 @@ private:
   void
   moveToStaleQueue(iterator i);
 
+  /** \brief inserts an entry in FIFO queue into the stale bucket of its stale time
+   *  \pre i->canStale()
+   */
+  void
+  attachStaleBucket(iterator i, EntryInfo* entryInfo);
+
+  /** \brief removes an entry from its stale bucket
+   */
+  void
+  detachStaleBucket(EntryInfo* entryInfo);
+
+  /** \brief moves entries that are stale at \p now from FIFO queue to STALE queue
+   *  \param nMax maximum number of entries to move
+   *
+   *  Stale buckets are visited in time order, so that entries are appended to STALE queue
+   *  in the order they became stale.
+   */
+  void
+  moveStaleEntries(const time::steady_clock::TimePoint& now, size_t nMax);
+
+  static int64_t
+  getStaleSlot(const time::steady_clock::TimePoint& staleTime);
+
 private:
   Queue m_queues[QUEUE_MAX];
   EntryInfoMapFifo m_entryInfoMap;
+  StaleBuckets m_staleBuckets;
 };
 
 } // namespace priorityfifo
@@ -75,5 +75,20 @@ Policy::beforeUse(iterator i)
   this->doBeforeUse(i);
 }
 
+iterator
+Policy::peekVictim()
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  return this->doPeekVictim();
+}
+
+std::vector<iterator>
+Policy::getEvictionOrder() const
+{
+  std::vector<iterator> order;
+  this->doGetEvictionOrder(order);
+  return order;
+}
+
 } // namespace cs
 } // namespace nfd
@@ -109,6 +109,23 @@ public:
   void
   beforeUse(iterator i);
 
+  /** \brief returns the entry that would be evicted next
+   *  \pre cs.size() > 0
+   *
+   *  This does not evict the entry. CS uses it to consult an AdmissionFilter
+   *  before a new entry is inserted into a full CS.
+   */
+  iterator
+  peekVictim();
+
+  /** \return all entries in the order they would be evicted, starting from the next victim
+   *
+   *  Inserting these entries into an empty CS in the returned order
+   *  reproduces the same eviction order.
+   */
+  std::vector<iterator>
+  getEvictionOrder() const;
+
 protected:
   /** \brief invoked after a new entry is created in CS
    *
@@ -146,6 +163,20 @@ protected:
   virtual void
   doBeforeUse(iterator i) = 0;
 
+  /** \brief returns the entry that would be evicted next
+   *
+   *  When overridden in a subclass, a policy implementation should return the entry
+   *  that evictEntries would evict first. It may bring its cleanup index up to date,
+   *  but must not evict any entry.
+   */
+  virtual iterator
+  doPeekVictim() = 0;
+
+  /** \brief appends all entries to \p order, in the order they would be evicted
+   */
+  virtual void
+  doGetEvictionOrder(std::vector<iterator>& order) const = 0;
+
   /** \brief evicts zero or more entries
    *  \post CS size does not exceed hard limit
    */
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-sharded.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+namespace cs {
+
+NFD_LOG_INIT("ShardedCs");
+
+const size_t ShardedCs::DEFAULT_ROUTING_PREFIX_LENGTH = 1;
+
+/** \return capacity of shard \p index
+ *
+ *  Remainder goes to the first shards. Each shard holds at least one entry,
+ *  because Policy does not accept zero capacity.
+ */
+static size_t
+computeShardLimit(size_t nMaxPackets, size_t nShards, size_t index)
+{
+  return std::max<size_t>(1, nMaxPackets / nShards + (index < nMaxPackets % nShards ? 1 : 0));
+}
+
+ShardedCs::Shard::Shard(size_t nMaxPackets, unique_ptr<Policy> policy)
+  : cs(nMaxPackets, std::move(policy))
+  , nHits(0)
+  , nMisses(0)
+  , nInserts(0)
+{
+}
+
+ShardedCs::ShardedCs(size_t nShards, size_t nMaxPackets, size_t routingPrefixLength,
+                     const PolicyFactory& makePolicy)
+  : m_routingPrefixLength(routingPrefixLength)
+{
+  BOOST_ASSERT(nShards > 0);
+  m_shards.reserve(nShards);
+  for (size_t i = 0; i < nShards; ++i) {
+    m_shards.push_back(unique_ptr<Shard>(
+      new Shard(computeShardLimit(nMaxPackets, nShards, i), makePolicy())));
+  }
+}
+
+size_t
+ShardedCs::getShardIndex(const Name& name) const
+{
+  return this->getShardIndex(name, name_tree::HashContext(name));
+}
+
+size_t
+ShardedCs::getShardIndex(const Name& name, const name_tree::HashContext& hashes) const
+{
+  BOOST_ASSERT(hashes.size() == name.size());
+
+  // Data Name does not contain the implicit digest that a full Name Interest carries
+  size_t nameLength = name.size();
+  if (nameLength > 0 && name[-1].isImplicitSha256Digest()) {
+    --nameLength;
+  }
+
+  size_t prefixLength = std::min(nameLength, m_routingPrefixLength);
+  return hashes.getHash(prefixLength) % m_shards.size();
+}
+
+bool
+ShardedCs::insert(const Data& data, bool isUnsolicited)
+{
+  return this->insert(data, name_tree::HashContext(data.getName()), isUnsolicited);
+}
+
+bool
+ShardedCs::insert(const Data& data, const name_tree::HashContext& hashes, bool isUnsolicited)
+{
+  Shard& shard = *m_shards[this->getShardIndex(data.getName(), hashes)];
+  bool isInserted = shard.cs.insert(data, hashes, isUnsolicited);
+  if (isInserted) {
+    shard.nInserts.fetch_add(1, std::memory_order_relaxed);
+  }
+  return isInserted;
+}
+
+void
+ShardedCs::find(const Interest& interest,
+                const Cs::HitCallback& hitCallback,
+                const Cs::MissCallback& missCallback)
+{
+  this->find(interest, name_tree::HashContext(interest.getName()), hitCallback, missCallback);
+}
+
+void
+ShardedCs::find(const Interest& interest, const name_tree::HashContext& hashes,
+                const Cs::HitCallback& hitCallback,
+                const Cs::MissCallback& missCallback)
+{
+  // a full Name matches only one Data, which is in the shard of its Name
+  const Name& name = interest.getName();
+  bool isFullName = !name.empty() && name[-1].isImplicitSha256Digest();
+  if (!isFullName && name.size() < m_routingPrefixLength && m_shards.size() > 1) {
+    this->findInAllShards(interest, hitCallback, missCallback);
+    return;
+  }
+
+  this->findInShard(*m_shards[this->getShardIndex(name, hashes)],
+                    interest, hitCallback, missCallback);
+}
+
+void
+ShardedCs::findInShard(Shard& shard,
+                       const Interest& interest,
+                       const Cs::HitCallback& hitCallback,
+                       const Cs::MissCallback& missCallback)
+{
+  shard.cs.find(interest,
+    [&shard, &hitCallback] (const Interest& interest, const Data& data) {
+      shard.nHits.fetch_add(1, std::memory_order_relaxed);
+      hitCallback(interest, data);
+    },
+    [&shard, &missCallback] (const Interest& interest) {
+      shard.nMisses.fetch_add(1, std::memory_order_relaxed);
+      missCallback(interest);
+    });
+}
+
+void
+ShardedCs::findInAllShards(const Interest& interest,
+                           const Cs::HitCallback& hitCallback,
+                           const Cs::MissCallback& missCallback)
+{
+  NFD_LOG_DEBUG("find " << interest.getName() << " in all shards");
+  bool isRightmost = interest.getChildSelector() == 1;
+
+  // probing has no side effects, so shards that do not answer are left untouched
+  const Entry* best = nullptr;
+  Shard* bestShard = nullptr;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    const Entry* match = shard->cs.probe(interest);
+    if (match != nullptr &&
+        (best == nullptr ||
+         (isRightmost ? best->compareName(*match) < 0 : match->compareName(*best) < 0))) {
+      best = match;
+      bestShard = shard.get();
+    }
+  }
+
+  if (best == nullptr) {
+    m_shards.front()->nMisses.fetch_add(1, std::memory_order_relaxed);
+    missCallback(interest);
+    return;
+  }
+
+  // repeat the lookup on the answering shard, which finds the same entry,
+  // and updates its replacement policy and counters
+  this->findInShard(*bestShard, interest, hitCallback, missCallback);
+}
+
+void
+ShardedCs::setLimit(size_t nMaxPackets)
+{
+  size_t nShards = m_shards.size();
+  for (size_t i = 0; i < nShards; ++i) {
+    m_shards[i]->cs.setLimit(computeShardLimit(nMaxPackets, nShards, i));
+  }
+}
+
+size_t
+ShardedCs::getLimit() const
+{
+  size_t nMaxPackets = 0;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    nMaxPackets += shard->cs.getLimit();
+  }
+  return nMaxPackets;
+}
+
+size_t
+ShardedCs::size() const
+{
+  size_t nEntries = 0;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    nEntries += shard->cs.size();
+  }
+  return nEntries;
+}
+
+template<typename F>
+uint64_t
+ShardedCs::sumCounters(F getCounter) const
+{
+  uint64_t sum = 0;
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    sum += getCounter(*shard).load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+uint64_t
+ShardedCs::getNHits() const
+{
+  return this->sumCounters([] (const Shard& shard) -> const std::atomic<uint64_t>& {
+    return shard.nHits;
+  });
+}
+
+uint64_t
+ShardedCs::getNMisses() const
+{
+  return this->sumCounters([] (const Shard& shard) -> const std::atomic<uint64_t>& {
+    return shard.nMisses;
+  });
+}
+
+uint64_t
+ShardedCs::getNInserts() const
+{
+  return this->sumCounters([] (const Shard& shard) -> const std::atomic<uint64_t>& {
+    return shard.nInserts;
+  });
+}
+
+} // namespace cs
+} // namespace nfd
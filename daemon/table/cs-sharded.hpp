@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_SHARDED_HPP
+#define NFD_DAEMON_TABLE_CS_SHARDED_HPP
+
+#include "cs.hpp"
+
+#include <atomic>
+
+namespace nfd {
+namespace cs {
+
+/** \brief a ContentStore partitioned into independent shards
+ *
+ *  Each shard is a complete Cs with its own Table, Policy, and capacity.
+ *  A Data or Interest is routed to a shard by a hash of the first few components of its Name,
+ *  so that all Data under one routing prefix are stored in one shard,
+ *  and prefix lookups with the usual selectors are answered by that shard alone.
+ *  A trailing implicit digest is not part of the routing prefix, so that an Interest for
+ *  a full Name is routed to the shard of the Data.
+ *  Since shards share no state, each shard can be owned by a different forwarding thread.
+ *
+ *  Hit/miss/insert counters are kept per shard as relaxed atomics,
+ *  and are aggregated when read.
+ */
+class ShardedCs : noncopyable
+{
+public:
+  typedef std::function<unique_ptr<Policy>()> PolicyFactory;
+
+  /** \brief constructs a sharded ContentStore
+   *  \param nShards number of shards, must be positive
+   *  \param nMaxPackets total capacity, divided among shards
+   *  \param routingPrefixLength number of leading Name components hashed to pick a shard
+   *  \param makePolicy creates the replacement policy of each shard
+   */
+  ShardedCs(size_t nShards, size_t nMaxPackets,
+            size_t routingPrefixLength = DEFAULT_ROUTING_PREFIX_LENGTH,
+            const PolicyFactory& makePolicy = &makeDefaultPolicy);
+
+  /** \brief inserts a Data packet into its shard
+   */
+  bool
+  insert(const Data& data, bool isUnsolicited = false);
+
+  /** \brief inserts a Data packet into its shard, using precomputed hashes
+   *  \param hashes must be computed from Data Name
+   */
+  bool
+  insert(const Data& data, const name_tree::HashContext& hashes, bool isUnsolicited = false);
+
+  /** \brief finds the best matching Data packet
+   *
+   *  If Interest Name has at least routingPrefixLength components or is a full Name,
+   *  only one shard is searched. Otherwise, the memory tier of every shard is probed
+   *  without side effects, and the lookup is performed on the shard holding the leftmost
+   *  (or rightmost, if ChildSelector=1) match by Name; DiskStore of a shard is consulted
+   *  only in single-shard lookups.
+   */
+  void
+  find(const Interest& interest,
+       const Cs::HitCallback& hitCallback,
+       const Cs::MissCallback& missCallback);
+
+  /** \brief finds the best matching Data packet, using precomputed hashes
+   *  \param hashes must be computed from Interest Name
+   */
+  void
+  find(const Interest& interest, const name_tree::HashContext& hashes,
+       const Cs::HitCallback& hitCallback,
+       const Cs::MissCallback& missCallback);
+
+  /** \brief changes total capacity, divided evenly among shards
+   *
+   *  Each shard holds at least one entry, so getLimit() may exceed \p nMaxPackets
+   *  if it is smaller than the number of shards.
+   */
+  void
+  setLimit(size_t nMaxPackets);
+
+  /** \return total capacity
+   */
+  size_t
+  getLimit() const;
+
+  /** \return total number of stored packets
+   */
+  size_t
+  size() const;
+
+public: // shards
+  size_t
+  getNShards() const
+  {
+    return m_shards.size();
+  }
+
+  /** \return the shard at \p index
+   */
+  Cs&
+  getShard(size_t index)
+  {
+    return m_shards.at(index)->cs;
+  }
+
+  /** \return index of the shard responsible for \p name
+   *
+   *  The shard is picked by the NameTree hash of the routing prefix.
+   *  The result depends only on Name, routingPrefixLength, and number of shards,
+   *  so it is stable across runs and across threads.
+   *  A trailing implicit digest component in \p name is ignored.
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /** \return index of the shard responsible for \p name, using precomputed hashes
+   *  \param hashes must be computed from \p name
+   */
+  size_t
+  getShardIndex(const Name& name, const name_tree::HashContext& hashes) const;
+
+  size_t
+  getRoutingPrefixLength() const
+  {
+    return m_routingPrefixLength;
+  }
+
+public: // statistics
+  uint64_t
+  getNHits() const;
+
+  uint64_t
+  getNMisses() const;
+
+  uint64_t
+  getNInserts() const;
+
+public:
+  static const size_t DEFAULT_ROUTING_PREFIX_LENGTH;
+
+private:
+  struct Shard : noncopyable
+  {
+    Shard(size_t nMaxPackets, unique_ptr<Policy> policy);
+
+    Cs cs;
+    std::atomic<uint64_t> nHits;
+    std::atomic<uint64_t> nMisses;
+    std::atomic<uint64_t> nInserts;
+  };
+
+  void
+  findInShard(Shard& shard,
+              const Interest& interest,
+              const Cs::HitCallback& hitCallback,
+              const Cs::MissCallback& missCallback);
+
+  void
+  findInAllShards(const Interest& interest,
+                  const Cs::HitCallback& hitCallback,
+                  const Cs::MissCallback& missCallback);
+
+  template<typename F>
+  uint64_t
+  sumCounters(F getCounter) const;
+
+private:
+  std::vector<unique_ptr<Shard>> m_shards;
+  size_t m_routingPrefixLength;
+};
+
+} // namespace cs
+
+using cs::ShardedCs;
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_SHARDED_HPP
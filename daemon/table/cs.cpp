@@ -25,9 +25,17 @@
 
 #include "cs.hpp"
 #include "cs-policy-priority-fifo.hpp"
+#include "cs-policy-lru.hpp"
+#include "cs-policy-arc.hpp"
+#include "cs-policy-clock-pro.hpp"
+#include "cs-admission-tinylfu.hpp"
 #include "core/logger.hpp"
 #include "core/algorithm.hpp"
 
+#include <deque>
+#include <istream>
+#include <ostream>
+
 NFD_LOG_INIT("ContentStore");
 
 namespace nfd {
@@ -50,7 +58,36 @@ makeDefaultPolicy()
   return unique_ptr<Policy>(new PriorityFifoPolicy());
 }
 
+unique_ptr<Policy>
+makePolicy(const std::string& policyName)
+{
+  if (policyName == PriorityFifoPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new PriorityFifoPolicy());
+  }
+  if (policyName == LruPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new LruPolicy());
+  }
+  if (policyName == ArcPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new ArcPolicy());
+  }
+  if (policyName == ClockProPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new ClockProPolicy());
+  }
+  return nullptr;
+}
+
+unique_ptr<AdmissionFilter>
+makeAdmissionFilter(const std::string& filterName)
+{
+  if (filterName == TinyLfuFilter::FILTER_NAME) {
+    return unique_ptr<AdmissionFilter>(new TinyLfuFilter());
+  }
+  return nullptr;
+}
+
 Cs::Cs(size_t nMaxPackets, unique_ptr<Policy> policy)
+  : m_nHits(0)
+  , m_nMisses(0)
 {
   this->setPolicyImpl(policy);
   m_policy->setLimit(nMaxPackets);
@@ -60,6 +97,10 @@ void
 Cs::setLimit(size_t nMaxPackets)
 {
   m_policy->setLimit(nMaxPackets);
+
+  if (m_admissionFilter != nullptr) {
+    m_admissionFilter->setLimit(nMaxPackets);
+  }
 }
 
 size_t
@@ -78,9 +119,26 @@ Cs::setPolicy(unique_ptr<Policy> policy)
   m_policy->setLimit(limit);
 }
 
+void
+Cs::setAdmissionFilter(unique_ptr<AdmissionFilter> filter)
+{
+  m_admissionFilter = std::move(filter);
+
+  if (m_admissionFilter != nullptr) {
+    m_admissionFilter->setLimit(m_policy->getLimit());
+  }
+}
+
 bool
 Cs::insert(const Data& data, bool isUnsolicited)
 {
+  return this->insert(data, name_tree::HashContext(data.getName()), isUnsolicited);
+}
+
+bool
+Cs::insert(const Data& data, const name_tree::HashContext& hashes, bool isUnsolicited)
+{
+  BOOST_ASSERT(hashes.matches(data.getName()));
   NFD_LOG_DEBUG("insert " << data.getName());
 
   // recognize CachingPolicy
@@ -93,13 +151,41 @@ Cs::insert(const Data& data, bool isUnsolicited)
     }
   }
 
+  return this->insertImpl(data, hashes.getFullHash(), isUnsolicited, nullptr);
+}
+
+bool
+Cs::insertImpl(const Data& data, size_t nameHash, bool isUnsolicited,
+               const time::steady_clock::TimePoint* staleTime)
+{
   bool isNewEntry = false;
   iterator it;
   // use .insert because gcc46 does not support .emplace
-  std::tie(it, isNewEntry) = m_table.insert(EntryImpl(data.shared_from_this(), isUnsolicited));
+  std::tie(it, isNewEntry) = m_table.insert(EntryImpl(data, isUnsolicited, nameHash));
+
+  if (m_admissionFilter != nullptr) {
+    m_admissionFilter->recordAccess(nameHash);
+
+    // CS was full before this insertion: the new entry competes with the eviction victim,
+    // unless it is promoted from DiskStore, which would otherwise lose the Data
+    if (isNewEntry && staleTime == nullptr && m_table.size() > m_policy->getLimit()) {
+      iterator victim = m_policy->peekVictim();
+      if (!m_admissionFilter->shouldAdmit(nameHash, victim->getNameHash())) {
+        NFD_LOG_DEBUG("  rejected-by-admission-filter");
+        m_table.erase(it);
+        return false;
+      }
+    }
+  }
+
   EntryImpl& entry = const_cast<EntryImpl&>(*it);
 
-  entry.updateStaleTime();
+  if (staleTime == nullptr) {
+    entry.updateStaleTime();
+  }
+  else {
+    entry.setStaleTime(*staleTime);
+  }
 
   if (!isNewEntry) { // existing entry
     // XXX This doesn't forbid unsolicited Data from refreshing a solicited entry.
@@ -119,14 +205,49 @@ Cs::insert(const Data& data, bool isUnsolicited)
 void
 Cs::find(const Interest& interest,
          const HitCallback& hitCallback,
-         const MissCallback& missCallback) const
+         const MissCallback& missCallback)
 {
   BOOST_ASSERT(static_cast<bool>(hitCallback));
   BOOST_ASSERT(static_cast<bool>(missCallback));
 
+  NFD_LOG_DEBUG("find " << interest.getName() <<
+                (interest.getChildSelector() == 1 ? " R" : " L"));
+
+  iterator match = this->findMatch(interest);
+  if (match == m_table.end()) {
+    if (m_diskStore != nullptr && this->findInDiskStore(interest, hitCallback)) {
+      ++m_nHits;
+      return;
+    }
+    NFD_LOG_DEBUG("  no-match");
+    ++m_nMisses;
+    missCallback(interest);
+    return;
+  }
+  NFD_LOG_DEBUG("  matching " << match->getName());
+  ++m_nHits;
+  m_policy->beforeUse(match);
+  if (m_admissionFilter != nullptr) {
+    m_admissionFilter->recordAccess(match->getNameHash());
+  }
+
+  // CS entry keeps only wire encoding, Data is decoded on hit
+  shared_ptr<const Data> data = match->getData();
+  hitCallback(interest, *data);
+}
+
+const Entry*
+Cs::probe(const Interest& interest) const
+{
+  iterator match = this->findMatch(interest);
+  return match == m_table.end() ? nullptr : &*match;
+}
+
+iterator
+Cs::findMatch(const Interest& interest) const
+{
   const Name& prefix = interest.getName();
   bool isRightmost = interest.getChildSelector() == 1;
-  NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
   iterator first = m_table.lower_bound(prefix);
   iterator last = m_table.end();
@@ -142,14 +263,7 @@ Cs::find(const Interest& interest,
     match = this->findLeftmost(interest, first, last);
   }
 
-  if (match == last) {
-    NFD_LOG_DEBUG("  no-match");
-    missCallback(interest);
-    return;
-  }
-  NFD_LOG_DEBUG("  matching " << match->getName());
-  m_policy->beforeUse(match);
-  hitCallback(interest, match->getData());
+  return match == last ? m_table.end() : match;
 }
 
 iterator
@@ -170,7 +284,7 @@ Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
     iterator prev = std::prev(right);
 
     // special case: [first,prev] have exact Names
-    if (prev->getName().size() == interestNameLength) {
+    if (prev->getNameSize() == interestNameLength) {
       NFD_LOG_TRACE("  find-among-exact " << prev->getName());
       iterator matchExact = this->findRightmostAmongExact(interest, first, right);
       return matchExact == right ? last : matchExact;
@@ -196,11 +310,36 @@ Cs::findRightmostAmongExact(const Interest& interest, iterator first, iterator l
   return find_last_if(first, last, bind(&EntryImpl::canSatisfy, _1, interest));
 }
 
+bool
+Cs::findInDiskStore(const Interest& interest, const HitCallback& hitCallback)
+{
+  time::steady_clock::TimePoint staleTime;
+  shared_ptr<Data> data = m_diskStore->find(interest, staleTime);
+  if (data == nullptr) {
+    return false;
+  }
+
+  NFD_LOG_DEBUG("  matching-on-disk " << data->getName());
+  // DiskStore has removed the Data, so promotion always succeeds (admission is bypassed)
+  this->insertImpl(*data, name_tree::computeHash(data->getName()), false, &staleTime);
+  hitCallback(interest, *data);
+  return true;
+}
+
+void
+Cs::setDiskStore(unique_ptr<DiskStore> diskStore)
+{
+  m_diskStore = std::move(diskStore);
+}
+
 void
 Cs::setPolicyImpl(unique_ptr<Policy>& policy)
 {
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      if (m_diskStore != nullptr && !it->isUnsolicited()) {
+        m_diskStore->insert(*it);
+      }
       m_table.erase(it);
     });
 
@@ -208,6 +347,186 @@ Cs::setPolicyImpl(unique_ptr<Policy>& policy)
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
+/** \brief snapshot file format
+ *
+ *  Snapshot       ::= MAGIC VERSION Record*
+ *  Record         ::= isUnsolicited(uint8) hasStaleTime(uint8) staleTime(int64)
+ *                     wireLength(uint32) wire
+ *
+ *  Integers are in host byte order; a snapshot is meant to be loaded on the same host.
+ *  staleTime is in milliseconds since system clock epoch.
+ */
+static const char SNAPSHOT_MAGIC[8] = {'N', 'F', 'D', 'C', 'S', 'S', 'N', 'P'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+template<typename T>
+static void
+writeSnapshotField(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+static bool
+readSnapshotField(std::istream& is, T& value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+/** \brief a snapshot record that is read but not yet decoded
+ */
+struct SnapshotRecord
+{
+  bool isUnsolicited;
+  bool hasStaleTime;
+  int64_t staleTime;
+  shared_ptr<ndn::Buffer> wire;
+};
+
+void
+Cs::saveSnapshot(std::ostream& os) const
+{
+  os.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  writeSnapshotField(os, SNAPSHOT_VERSION);
+
+  time::steady_clock::TimePoint steadyNow = time::steady_clock::now();
+  time::system_clock::TimePoint systemNow = time::system_clock::now();
+
+  std::vector<iterator> order = m_policy->getEvictionOrder();
+  for (iterator it : order) {
+    uint8_t isUnsolicited = it->isUnsolicited() ? 1 : 0;
+    uint8_t hasStaleTime = it->canStale() ? 1 : 0;
+    int64_t staleTime = 0;
+    if (hasStaleTime) {
+      time::system_clock::TimePoint systemStaleTime = systemNow + (it->getStaleTime() - steadyNow);
+      staleTime = time::duration_cast<time::milliseconds>(
+                    systemStaleTime.time_since_epoch()).count();
+    }
+    Block wire = it->getWire();
+    uint32_t wireLength = static_cast<uint32_t>(wire.size());
+
+    writeSnapshotField(os, isUnsolicited);
+    writeSnapshotField(os, hasStaleTime);
+    writeSnapshotField(os, staleTime);
+    writeSnapshotField(os, wireLength);
+    os.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+  }
+
+  if (!os) {
+    BOOST_THROW_EXCEPTION(Error("Cannot write CS snapshot"));
+  }
+  NFD_LOG_INFO("saved " << order.size() << " entries to snapshot");
+}
+
+size_t
+Cs::loadSnapshot(std::istream& is)
+{
+  char magic[sizeof(SNAPSHOT_MAGIC)];
+  uint32_t version = 0;
+  if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC) ||
+      !readSnapshotField(is, version) || version != SNAPSHOT_VERSION) {
+    BOOST_THROW_EXCEPTION(Error("Invalid CS snapshot header"));
+  }
+
+  time::steady_clock::TimePoint steadyNow = time::steady_clock::now();
+  time::system_clock::TimePoint systemNow = time::system_clock::now();
+
+  // keep the entries that would be evicted last, if free capacity is insufficient;
+  // records that fall out of the window are dropped before being decoded
+  size_t capacity = m_policy->getLimit() > m_table.size() ? m_policy->getLimit() - m_table.size() : 0;
+  std::deque<SnapshotRecord> records;
+  uint8_t isUnsolicited = 0;
+  while (readSnapshotField(is, isUnsolicited)) {
+    SnapshotRecord record;
+    record.isUnsolicited = isUnsolicited != 0;
+    uint8_t hasStaleTime = 0;
+    uint32_t wireLength = 0;
+    if (!readSnapshotField(is, hasStaleTime) || !readSnapshotField(is, record.staleTime) ||
+        !readSnapshotField(is, wireLength)) {
+      BOOST_THROW_EXCEPTION(Error("Truncated CS snapshot record"));
+    }
+    record.hasStaleTime = hasStaleTime != 0;
+    if (wireLength > ndn::MAX_NDN_PACKET_SIZE) {
+      BOOST_THROW_EXCEPTION(Error("CS snapshot record exceeds maximum packet size"));
+    }
+
+    if (capacity == 0) {
+      if (!is.ignore(wireLength) || is.gcount() != static_cast<std::streamsize>(wireLength)) {
+        BOOST_THROW_EXCEPTION(Error("Truncated CS snapshot record"));
+      }
+      continue;
+    }
+
+    // reuse the buffer of the record that falls out of the window
+    shared_ptr<ndn::Buffer> wire;
+    if (records.size() == capacity) {
+      wire = std::move(records.front().wire);
+      records.pop_front();
+      wire->resize(wireLength);
+    }
+    else {
+      wire = make_shared<ndn::Buffer>(wireLength);
+    }
+    if (!is.read(reinterpret_cast<char*>(wire->data()), wireLength)) {
+      BOOST_THROW_EXCEPTION(Error("Truncated CS snapshot record"));
+    }
+    record.wire = std::move(wire);
+    records.push_back(std::move(record));
+  }
+
+  // entries in snapshot order, i.e. eviction order;
+  // each entry keeps the buffer the record was read into, without another copy
+  std::vector<EntryImpl> entries;
+  entries.reserve(records.size());
+  for (SnapshotRecord& record : records) {
+    shared_ptr<Data> data;
+    try {
+      data = make_shared<Data>(Block(ndn::ConstBufferPtr(std::move(record.wire))));
+    }
+    catch (const tlv::Error& e) {
+      BOOST_THROW_EXCEPTION(Error("Malformed Data in CS snapshot: " + std::string(e.what())));
+    }
+
+    entries.push_back(EntryImpl(*data, record.isUnsolicited,
+                                name_tree::computeHash(data->getName())));
+    if (record.hasStaleTime) {
+      time::system_clock::TimePoint systemStaleTime{time::milliseconds(record.staleTime)};
+      entries.back().setStaleTime(steadyNow + (systemStaleTime - systemNow));
+    }
+  }
+
+  // insert into the table in Name order, so that each insertion is next to the hint
+  std::vector<size_t> sorted(entries.size());
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    sorted[i] = i;
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [&entries] (size_t a, size_t b) { return entries[a] < entries[b]; });
+
+  std::vector<iterator> positions(entries.size(), m_table.end());
+  iterator hint = m_table.end();
+  for (size_t i : sorted) {
+    size_t oldSize = m_table.size();
+    iterator it = m_table.insert(hint, entries[i]);
+    if (m_table.size() > oldSize) { // skip duplicates and existing entries
+      positions[i] = it;
+    }
+    hint = std::next(it);
+  }
+
+  // hand the entries to the policy in snapshot order
+  size_t nLoaded = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (positions[i] != m_table.end()) {
+      m_policy->afterInsert(positions[i]);
+      ++nLoaded;
+    }
+  }
+
+  NFD_LOG_INFO("loaded " << nLoaded << " entries from snapshot");
+  return nLoaded;
+}
+
 void
 Cs::dump()
 {
@@ -49,8 +49,11 @@
 #define NFD_DAEMON_TABLE_CS_HPP
 
 #include "cs-policy.hpp"
+#include "cs-admission.hpp"
+#include "cs-disk-store.hpp"
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "name-tree.hpp"
 #include <ndn-cxx/util/signal.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -60,20 +63,49 @@ namespace cs {
 unique_ptr<Policy>
 makeDefaultPolicy();
 
+/** \brief creates a replacement policy by name
+ *  \return the policy, or nullptr if \p policyName is unknown
+ */
+unique_ptr<Policy>
+makePolicy(const std::string& policyName);
+
+/** \brief creates an admission filter by name
+ *  \return the filter, or nullptr if \p filterName is unknown
+ */
+unique_ptr<AdmissionFilter>
+makeAdmissionFilter(const std::string& filterName);
+
 /** \brief represents the ContentStore
  */
 class Cs : noncopyable
 {
 public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
   explicit
   Cs(size_t nMaxPackets = 10, unique_ptr<Policy> policy = makeDefaultPolicy());
 
   /** \brief inserts a Data packet
-   *  \return true
+   *  \return true if the Data is inserted or refreshed;
+   *          false if the Data is not cacheable or is rejected by the admission filter
    */
   bool
   insert(const Data& data, bool isUnsolicited = false);
 
+  /** \brief inserts a Data packet, using precomputed hashes
+   *  \param hashes must be computed from Data Name; its full hash becomes the entry's Name hash
+   */
+  bool
+  insert(const Data& data, const name_tree::HashContext& hashes, bool isUnsolicited = false);
+
   typedef std::function<void(const Interest&, const Data& data)> HitCallback;
   typedef std::function<void(const Interest&)> MissCallback;
 
@@ -83,11 +115,24 @@ public:
    *  \param missCallback a callback if there's no match; must not be empty
    *  \note A lookup invokes either callback exactly once.
    *        The callback may be invoked either before or after find() returns
+   *
+   *  If there's no match in memory and a DiskStore is attached,
+   *  the DiskStore is consulted, and a Data found there is promoted to memory.
    */
   void
   find(const Interest& interest,
        const HitCallback& hitCallback,
-       const MissCallback& missCallback) const;
+       const MissCallback& missCallback);
+
+  /** \brief finds the best matching Data packet in memory, without side effects
+   *  \return the matched entry, or nullptr if there's no match in memory
+   *
+   *  Unlike find(), this does not notify the replacement policy or the admission filter,
+   *  does not update hit/miss counters, and does not consult DiskStore.
+   *  The returned pointer is invalidated by the next insertion or eviction.
+   */
+  const Entry*
+  probe(const Interest& interest) const;
 
   void
   erase(const Name& exactName)
@@ -119,6 +164,36 @@ public:
     return m_policy.get();
   }
 
+  /** \brief changes cs admission filter
+   *  \param filter the admission filter, or nullptr to admit every Data
+   */
+  void
+  setAdmissionFilter(unique_ptr<AdmissionFilter> filter);
+
+  /** \return cs admission filter, or nullptr if every Data is admitted
+   */
+  AdmissionFilter*
+  getAdmissionFilter() const
+  {
+    return m_admissionFilter.get();
+  }
+
+  /** \brief attaches a disk-backed second tier
+   *  \param diskStore the second tier, or nullptr to detach
+   *
+   *  When a DiskStore is attached, solicited Data evicted from memory are written to it.
+   */
+  void
+  setDiskStore(unique_ptr<DiskStore> diskStore);
+
+  /** \return disk-backed second tier, or nullptr if not attached
+   */
+  DiskStore*
+  getDiskStore() const
+  {
+    return m_diskStore.get();
+  }
+
   /** \return number of stored packets
    */
   size_t
@@ -127,6 +202,47 @@ public:
     return m_table.size();
   }
 
+public: // statistics
+  /** \return number of lookups that found a match, in memory or on disk
+   */
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /** \return number of lookups that found no match
+   */
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+public: // snapshot
+  /** \brief writes all entries to a snapshot
+   *
+   *  The snapshot contains Data wire encoding, unsolicited flag, and stale time of each entry.
+   *  Entries are written in the order they would be evicted by the replacement policy.
+   *  \throw Error write failure
+   */
+  void
+  saveSnapshot(std::ostream& os) const;
+
+  /** \brief bulk-loads entries from a snapshot
+   *  \return number of entries loaded
+   *
+   *  Entries are sorted by Name and inserted into the table in order,
+   *  and then handed to the replacement policy in snapshot order,
+   *  so that the policy ordering at the time of saveSnapshot is restored.
+   *  If the snapshot has more entries than free capacity, the entries that would be
+   *  evicted first are skipped without being decoded. Stale times are preserved across restarts.
+   *  AdmissionFilter is bypassed.
+   *  \throw Error snapshot is malformed, or a record exceeds ndn::MAX_NDN_PACKET_SIZE
+   */
+  size_t
+  loadSnapshot(std::istream& is);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
@@ -159,7 +275,23 @@ public: // enumeration
     return boost::make_transform_iterator(m_table.end(), EntryFromEntryImpl());
   }
 
+private: // insert
+  /** \brief inserts a Data packet, bypassing CachingPolicy check
+   *  \param staleTime if not null, the entry is promoted from DiskStore with this stale time,
+   *                   and the admission filter is bypassed because DiskStore has already
+   *                   given the Data up; otherwise, stale time is computed from FreshnessPeriod
+   */
+  bool
+  insertImpl(const Data& data, size_t nameHash, bool isUnsolicited,
+             const time::steady_clock::TimePoint* staleTime);
+
 private: // find
+  /** \brief finds the best matching entry in memory
+   *  \return the match, or m_table.end() if not found
+   */
+  iterator
+  findMatch(const Interest& interest) const;
+
   /** \brief find leftmost match in [first,last)
    *  \return the leftmost match, or last if not found
    */
@@ -178,13 +310,24 @@ private: // find
   iterator
   findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
 
+  /** \brief finds a match in DiskStore, and promotes it to memory
+   *  \return whether a match is found; if true, \p hitCallback has been invoked
+   */
+  bool
+  findInDiskStore(const Interest& interest, const HitCallback& hitCallback);
+
   void
   setPolicyImpl(unique_ptr<Policy>& policy);
 
 private:
   Table m_table;
   unique_ptr<Policy> m_policy;
+  unique_ptr<AdmissionFilter> m_admissionFilter;
+  unique_ptr<DiskStore> m_diskStore;
   ndn::util::signal::ScopedConnection m_beforeEvictConnection;
+
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
 };
 
 } // namespace cs
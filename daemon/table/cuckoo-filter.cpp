@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cuckoo-filter.hpp"
+
+#include <cmath>
+
+namespace nfd {
+
+const size_t CuckooFilter::BUCKET_SIZE = 4;
+const double CuckooFilter::MAX_LOAD = 0.9;
+const size_t CuckooFilter::MAX_KICKS = 500;
+
+CuckooFilter::CuckooFilter(size_t capacity)
+{
+  this->reset(capacity);
+}
+
+void
+CuckooFilter::reset(size_t capacity)
+{
+  // bucket count is a power of two, so that indices are computed by masking
+  size_t minNBuckets = static_cast<size_t>(std::ceil(capacity / (BUCKET_SIZE * MAX_LOAD)));
+  size_t nBuckets = 1;
+  while (nBuckets < minNBuckets) {
+    nBuckets <<= 1;
+  }
+
+  m_slots.assign(nBuckets * BUCKET_SIZE, 0);
+  m_bucketMask = nBuckets - 1;
+  m_size = 0;
+  m_capacity = capacity;
+  m_stash.clear();
+  m_kickCounter = 0;
+}
+
+CuckooFilter::Fingerprint
+CuckooFilter::makeFingerprint(uint64_t key)
+{
+  Fingerprint fp = static_cast<Fingerprint>(key >> 32);
+  return fp == 0 ? 1 : fp;
+}
+
+size_t
+CuckooFilter::getAltIndex(size_t index, Fingerprint fp) const
+{
+  // multiplication by an odd constant spreads fingerprint bits into low bits;
+  // XOR makes this an involution: getAltIndex(getAltIndex(i, fp), fp) == i
+  return (index ^ static_cast<size_t>(fp * 0x5bd1e995U)) & m_bucketMask;
+}
+
+bool
+CuckooFilter::hasInBucket(size_t index, Fingerprint fp) const
+{
+  const Fingerprint* bucket = &m_slots[index * BUCKET_SIZE];
+  return std::find(bucket, bucket + BUCKET_SIZE, fp) != bucket + BUCKET_SIZE;
+}
+
+bool
+CuckooFilter::putInBucket(size_t index, Fingerprint fp)
+{
+  Fingerprint* bucket = &m_slots[index * BUCKET_SIZE];
+  Fingerprint* slot = std::find(bucket, bucket + BUCKET_SIZE, 0);
+  if (slot == bucket + BUCKET_SIZE) {
+    return false;
+  }
+  *slot = fp;
+  return true;
+}
+
+bool
+CuckooFilter::contains(uint64_t key) const
+{
+  Fingerprint fp = makeFingerprint(key);
+  size_t i1 = static_cast<size_t>(key) & m_bucketMask;
+  size_t i2 = this->getAltIndex(i1, fp);
+  if (this->hasInBucket(i1, fp) || this->hasInBucket(i2, fp)) {
+    return true;
+  }
+
+  return std::any_of(m_stash.begin(), m_stash.end(),
+                     [=] (const std::pair<size_t, Fingerprint>& item) {
+                       return item.second == fp && (item.first == i1 || item.first == i2);
+                     });
+}
+
+bool
+CuckooFilter::insert(uint64_t key)
+{
+  if (this->contains(key)) {
+    return false;
+  }
+  ++m_size;
+
+  Fingerprint fp = makeFingerprint(key);
+  size_t index = static_cast<size_t>(key) & m_bucketMask;
+  if (this->putInBucket(index, fp)) {
+    return true;
+  }
+  index = this->getAltIndex(index, fp);
+  if (this->putInBucket(index, fp)) {
+    return true;
+  }
+
+  // both buckets are full: kick a fingerprint to its alternate bucket, and repeat
+  for (size_t nKicks = 0; nKicks < MAX_KICKS; ++nKicks) {
+    std::swap(fp, m_slots[index * BUCKET_SIZE + (m_kickCounter++ % BUCKET_SIZE)]);
+    index = this->getAltIndex(index, fp);
+    if (this->putInBucket(index, fp)) {
+      return true;
+    }
+  }
+
+  m_stash.emplace_back(index, fp);
+  return true;
+}
+
+} // namespace nfd
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CUCKOO_FILTER_HPP
+#define NFD_DAEMON_TABLE_CUCKOO_FILTER_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief a fixed-size cuckoo filter of 64-bit keys
+ *
+ *  A key is stored as a 32-bit fingerprint in one of two candidate buckets of BUCKET_SIZE
+ *  slots. The alternate bucket is derived from the current bucket and the fingerprint,
+ *  so that a fingerprint can be relocated without knowing its key.
+ *  Keys must be well-distributed hashes: low bits select the bucket, and high bits
+ *  form the fingerprint.
+ *
+ *  contains() may return false positives, with probability about
+ *  2 * BUCKET_SIZE / 2^32 per lookup, but never false negatives.
+ *  Keys cannot be erased individually; the filter is cleared as a whole.
+ */
+class CuckooFilter
+{
+public:
+  /** \brief constructs a filter sized to hold \p capacity keys
+   */
+  explicit
+  CuckooFilter(size_t capacity = 0);
+
+  /** \brief determines if \p key may have been inserted
+   */
+  bool
+  contains(uint64_t key) const;
+
+  /** \brief inserts \p key
+   *
+   *  The key is inserted even when the filter is over capacity: if no slot can be
+   *  freed by relocation, its fingerprint goes to a small overflow stash.
+   *  \return false if \p key was already present, and nothing is inserted
+   */
+  bool
+  insert(uint64_t key);
+
+  /** \brief erases all keys, and resizes the filter to hold \p capacity keys
+   */
+  void
+  reset(size_t capacity);
+
+  /** \return number of inserted keys
+   */
+  size_t
+  size() const;
+
+  /** \return number of keys the filter is sized for
+   */
+  size_t
+  getCapacity() const;
+
+  /** \return number of fingerprint slots, excluding the stash
+   */
+  size_t
+  getNSlots() const;
+
+public:
+  static const size_t BUCKET_SIZE;
+
+  /// maximum fraction of slots occupied when the filter holds getCapacity() keys
+  static const double MAX_LOAD;
+
+  /// maximum relocations attempted by an insertion before using the stash
+  static const size_t MAX_KICKS;
+
+private:
+  typedef uint32_t Fingerprint;
+
+  static Fingerprint
+  makeFingerprint(uint64_t key);
+
+  size_t
+  getAltIndex(size_t index, Fingerprint fp) const;
+
+  bool
+  hasInBucket(size_t index, Fingerprint fp) const;
+
+  bool
+  putInBucket(size_t index, Fingerprint fp);
+
+private:
+  /// slots of all buckets; 0 means empty slot
+  std::vector<Fingerprint> m_slots;
+  size_t m_bucketMask;
+  size_t m_size;
+  size_t m_capacity;
+  /// fingerprints that could not be placed, with one of their bucket indices
+  std::vector<std::pair<size_t, Fingerprint>> m_stash;
+  /// picks the slot to kick out; varies across insertions to avoid relocation cycles
+  size_t m_kickCounter;
+};
+
+inline size_t
+CuckooFilter::size() const
+{
+  return m_size;
+}
+
+inline size_t
+CuckooFilter::getCapacity() const
+{
+  return m_capacity;
+}
+
+inline size_t
+CuckooFilter::getNSlots() const
+{
+  return m_slots.size();
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CUCKOO_FILTER_HPP
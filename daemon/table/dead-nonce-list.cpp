@@ -24,6 +24,7 @@
  */
 
 #include "dead-nonce-list.hpp"
+#include "name-tree.hpp"
 #include "core/city-hash.hpp"
 #include "core/logger.hpp"
 
@@ -33,40 +34,33 @@ namespace nfd {
 
 const time::nanoseconds DeadNonceList::DEFAULT_LIFETIME = time::seconds(6);
 const time::nanoseconds DeadNonceList::MIN_LIFETIME = time::milliseconds(1);
+const size_t DeadNonceList::ROTATIONS_PER_LIFETIME = 5;
+const size_t DeadNonceList::N_GENERATIONS = ROTATIONS_PER_LIFETIME + 1;
 const size_t DeadNonceList::INITIAL_CAPACITY = (1 << 7);
 const size_t DeadNonceList::MIN_CAPACITY = (1 << 3);
 const size_t DeadNonceList::MAX_CAPACITY = (1 << 24);
-const DeadNonceList::Entry DeadNonceList::MARK = 0;
-const size_t DeadNonceList::EXPECTED_MARK_COUNT = 5;
 const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
-const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
 DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
+  , m_current(0)
+  , m_rotateInterval(m_lifetime / ROTATIONS_PER_LIFETIME)
   , m_capacity(INITIAL_CAPACITY)
-  , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
-  , m_adjustCapacityInterval(m_lifetime)
 {
   if (m_lifetime < MIN_LIFETIME) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
-  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
-  }
+  m_generations.resize(N_GENERATIONS, Generation(1, CuckooFilter(this->getGenerationCapacity())));
 
-  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
+  m_rotateEvent = scheduler::schedule(m_rotateInterval,
+                                      bind(&DeadNonceList::onRotateTimer, this));
 }
 
 DeadNonceList::~DeadNonceList()
 {
-  scheduler::cancel(m_markEvent);
-  scheduler::cancel(m_adjustCapacityEvent);
+  scheduler::cancel(m_rotateEvent);
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
@@ -77,95 +71,133 @@ DeadNonceList::~DeadNonceList()
                    "CAPACITY_DOWN must be able to decrease from MAX_CAPACITY");
   BOOST_ASSERT_MSG(CAPACITY_UP > 1.0, "CAPACITY_UP must adjust up");
   BOOST_ASSERT_MSG(CAPACITY_DOWN < 1.0, "CAPACITY_DOWN must adjust down");
-  static_assert(EVICT_LIMIT >= 1, "EVICT_LIMIT must be at least 1");
 }
 
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  size_t n = 0;
+  for (const Generation& generation : m_generations) {
+    n += DeadNonceList::getGenerationSize(generation);
+  }
+  return n;
+}
+
+size_t
+DeadNonceList::getGenerationSize(const Generation& generation)
+{
+  size_t n = 0;
+  for (const CuckooFilter& filter : generation) {
+    n += filter.size();
+  }
+  return n;
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  return this->has(name_tree::computeHash(name), name.size(), nonce);
+}
+
+bool
+DeadNonceList::has(size_t nameHash, size_t nComponents, uint32_t nonce) const
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nComponents, nonce);
+  for (const Generation& generation : m_generations) {
+    for (const CuckooFilter& filter : generation) {
+      if (filter.contains(entry)) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  this->add(name_tree::computeHash(name), name.size(), nonce);
+}
 
-  this->evictEntries();
+void
+DeadNonceList::add(size_t nameHash, size_t nComponents, uint32_t nonce)
+{
+  const CuckooFilter& filter = m_generations[m_current].back();
+  if (filter.size() >= filter.getCapacity()) {
+    this->grow();
+  }
+
+  Entry entry = DeadNonceList::makeEntry(nameHash, nComponents, nonce);
+  m_generations[m_current].back().insert(entry);
 }
 
 DeadNonceList::Entry
-DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
+DeadNonceList::makeEntry(size_t nameHash, size_t nComponents, uint32_t nonce)
 {
-  Block nameWire = name.wireEncode();
-  return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
-                            static_cast<uint64_t>(nonce));
+  // name hash is an XOR of component hashes: mixing in the component count separates Names
+  // whose repeated components cancel out, and mixing spreads the bits that are used as
+  // cuckoo filter bucket index and fingerprint
+  uint64_t nameKey = Hash128to64(uint128(static_cast<uint64_t>(nameHash),
+                                         static_cast<uint64_t>(nComponents)));
+  return Hash128to64(uint128(nameKey, static_cast<uint64_t>(nonce)));
 }
 
 size_t
-DeadNonceList::countMarks() const
+DeadNonceList::getGenerationCapacity() const
 {
-  return m_ht.count(MARK);
+  return (m_capacity + ROTATIONS_PER_LIFETIME - 1) / ROTATIONS_PER_LIFETIME;
 }
 
 void
-DeadNonceList::mark()
+DeadNonceList::rotate()
 {
-  m_queue.push_back(MARK);
-  size_t nMarks = this->countMarks();
-  m_actualMarkCounts.insert(nMarks);
+  m_current = (m_current + 1) % N_GENERATIONS;
+  Generation& generation = m_generations[m_current];
+  generation.resize(1);
+  generation.front().reset(this->getGenerationCapacity());
+}
 
-  NFD_LOG_TRACE("mark nMarks=" << nMarks);
+void
+DeadNonceList::grow()
+{
+  if (m_capacity >= MAX_CAPACITY) {
+    NFD_LOG_TRACE("grow generation-full at MAX_CAPACITY, rotate early");
+    this->rotate();
+    return;
+  }
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_capacity = std::min(MAX_CAPACITY, static_cast<size_t>(m_capacity * CAPACITY_UP));
+  m_generations[m_current].emplace_back(this->getGenerationCapacity());
+  NFD_LOG_TRACE("grow generation-full capacity=" << m_capacity <<
+                " nFilters=" << m_generations[m_current].size());
+}
+
+void
+DeadNonceList::onRotateTimer()
+{
+  this->adjustCapacity();
+  this->rotate();
+
+  m_rotateEvent = scheduler::schedule(m_rotateInterval,
+                                      bind(&DeadNonceList::onRotateTimer, this));
 }
 
 void
 DeadNonceList::adjustCapacity()
 {
-  std::pair<std::multiset<size_t>::iterator, std::multiset<size_t>::iterator> equalRange =
-    m_actualMarkCounts.equal_range(EXPECTED_MARK_COUNT);
+  // the generations other than the current one cover the last lifetime
+  size_t nEntries = this->size() - DeadNonceList::getGenerationSize(m_generations[m_current]);
 
-  if (equalRange.second == m_actualMarkCounts.begin()) {
-    // all counts are above expected count, adjust down
+  if (nEntries < m_capacity * CAPACITY_DOWN) {
     m_capacity = std::max(MIN_CAPACITY,
                           static_cast<size_t>(m_capacity * CAPACITY_DOWN));
     NFD_LOG_TRACE("adjustCapacity DOWN capacity=" << m_capacity);
   }
-  else if (equalRange.first == m_actualMarkCounts.end()) {
-    // all counts are below expected count, adjust up
+  else if (nEntries > m_capacity) {
     m_capacity = std::min(MAX_CAPACITY,
                           static_cast<size_t>(m_capacity * CAPACITY_UP));
     NFD_LOG_TRACE("adjustCapacity UP capacity=" << m_capacity);
   }
-
-  m_actualMarkCounts.clear();
-
-  this->evictEntries();
-
-  m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
-                                              bind(&DeadNonceList::adjustCapacity, this));
-}
-
-void
-DeadNonceList::evictEntries()
-{
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
-  if (nOverCapacity <= 0) // not over capacity
-    return;
-
-  for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
-  }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
 } // namespace nfd
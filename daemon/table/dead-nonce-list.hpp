@@ -27,9 +27,7 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "common.hpp"
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
+#include "cuckoo-filter.hpp"
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -40,16 +38,32 @@ namespace nfd {
  *  When a Nonce is erased (dead) from PIT entry, the Nonce and the Interest Name is added to
  *  Dead Nonce List, and kept for a duration in which most loops are expected to have occured.
  *
- *  To reduce memory usage, the Interest Name and Nonce are stored as a 64-bit hash.
+ *  To reduce memory usage, the Interest Name and Nonce are stored as a 32-bit fingerprint
+ *  in a cuckoo filter, using about 5 to 10 bytes per entry.
  *  There could be false positives (non-looping Interest could be considered looping),
  *  but the probability is small, and the error is recoverable when consumer retransmits
  *  with a different Nonce.
  *
- *  To reduce memory usage, entries do not have associated timestamps. Instead,
- *  lifetime of entries is controlled by dynamically adjusting the capacity of the container.
- *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
- *  The number of MARKs stored in the container reflects the lifetime of entries,
- *  because MARKs are inserted at fixed intervals.
+ *  To reduce memory usage, entries do not have associated timestamps. Instead, entries
+ *  are recorded in one of N_GENERATIONS cuckoo filters. Every lifetime/ROTATIONS_PER_LIFETIME,
+ *  the oldest filter is cleared, and becomes the current filter that receives new entries.
+ *  Thus, every entry is kept for at least lifetime, and at most lifetime*N_GENERATIONS/
+ *  ROTATIONS_PER_LIFETIME.
+ *
+ *  Each filter is sized for capacity/ROTATIONS_PER_LIFETIME entries. The capacity is adjusted
+ *  to the number of entries recorded during the last lifetime. If the current generation
+ *  fills before the next rotation, capacity is increased, and another filter of the new size
+ *  is added to the current generation, so that no entry is dropped before its lifetime ends.
+ *  Only when capacity is already MAX_CAPACITY does the list rotate early instead, which
+ *  bounds memory usage at the cost of shortening the lifetime of the oldest entries.
+ *
+ *  An entry is keyed by the Name hash, the number of Name components, and the Nonce.
+ *  The Name hash is name_tree::computeHash, an XOR of per-component hashes, which is reused
+ *  from NameTree so that the Name is not hashed again. It ignores the order of components,
+ *  and repeated components cancel out; mixing in the number of components keeps Names such as
+ *  /A/A/B and /B apart, but Names that are permutations of each other (e.g. /A/B and /B/A)
+ *  still share a key. Like a fingerprint collision, this can only cause a false positive,
+ *  which is recovered when the consumer retransmits with a different Nonce.
  */
 class DeadNonceList : noncopyable
 {
@@ -72,13 +86,27 @@ public:
   bool
   has(const Name& name, uint32_t nonce) const;
 
+  /** \brief determines if name+nonce exists
+   *  \param nameHash name_tree::computeHash of the name, such as name_tree::Entry::getHash()
+   *  \param nComponents number of components in the name
+   *  \return true if name+nonce exists
+   */
+  bool
+  has(size_t nameHash, size_t nComponents, uint32_t nonce) const;
+
   /** \brief records name+nonce
    */
   void
   add(const Name& name, uint32_t nonce);
 
+  /** \brief records name+nonce
+   *  \param nameHash name_tree::computeHash of the name, such as name_tree::Entry::getHash()
+   *  \param nComponents number of components in the name
+   */
+  void
+  add(size_t nameHash, size_t nComponents, uint32_t nonce);
+
   /** \return number of stored Nonces
-   *  \note The return value does not contain non-Nonce entries in the index, if any.
    */
   size_t
   size() const;
@@ -88,48 +116,54 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
-private: // Entry and Index
+private:
   typedef uint64_t Entry;
 
-  static Entry
-  makeEntry(const Name& name, uint32_t nonce);
+  /** \brief filters of a generation
+   *
+   *  The last filter receives new entries. Others are added when the generation fills early.
+   */
+  typedef std::vector<CuckooFilter> Generation;
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
+  static Entry
+  makeEntry(size_t nameHash, size_t nComponents, uint32_t nonce);
 
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
+  /** \return number of entries in \p generation
+   */
+  static size_t
+  getGenerationSize(const Generation& generation);
 
-private: // actual lifetime estimation and capacity control
-  /** \return number of MARKs in the index
+  /** \return capacity of each generation
    */
   size_t
-  countMarks() const;
+  getGenerationCapacity() const;
 
-  /** \brief add a MARK, then record number of MARKs in m_actualMarkCounts
+  /** \brief clears the oldest generation, and makes it the current generation
    */
   void
-  mark();
+  rotate();
 
-  /** \brief adjust capacity according to m_actualMarkCounts
+  /** \brief makes room in the current generation when it is full
    *
-   *  If all counts are above EXPECTED_MARK_COUNT, reduce capacity to m_capacity * CAPACITY_DOWN.
-   *  If all counts are below EXPECTED_MARK_COUNT, increase capacity to m_capacity * CAPACITY_UP.
+   *  Capacity is increased, and a filter of the new generation capacity is added to the
+   *  current generation. If capacity is at MAX_CAPACITY, the list rotates early instead.
    */
   void
-  adjustCapacity();
+  grow();
 
-  /** \brief evict some entries if index is over capacity
+  /** \brief adjusts capacity, rotates, and schedules the next rotation
    */
   void
-  evictEntries();
+  onRotateTimer();
+
+  /** \brief adjust capacity according to the number of entries in completed generations
+   *
+   *  If there are fewer than m_capacity * CAPACITY_DOWN, reduce capacity to
+   *  m_capacity * CAPACITY_DOWN.
+   *  If there are more than m_capacity, increase capacity to m_capacity * CAPACITY_UP.
+   */
+  void
+  adjustCapacity();
 
 public:
   /// default entry lifetime
@@ -138,22 +172,28 @@ public:
   /// minimum entry lifetime
   static const time::nanoseconds MIN_LIFETIME;
 
+  /// number of generation rotations during a lifetime
+  static const size_t ROTATIONS_PER_LIFETIME;
+
+  /// number of generations
+  static const size_t N_GENERATIONS;
+
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
 
-PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
+  /// generations, used as a ring
+  std::vector<Generation> m_generations;
 
-  // ---- current capacity and hard limits
+  /// index of the current generation
+  size_t m_current;
 
-  /** \brief current capacity of index
-   *
-   *  The index size is maintained to be near this capacity.
-   *
-   *  The capacity is adjusted so that every Entry is expected to be kept for m_lifetime.
-   *  This is achieved by mark() and adjustCapacity().
+  time::nanoseconds m_rotateInterval;
+
+  scheduler::EventId m_rotateEvent;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // capacity control
+
+  /** \brief current capacity, i.e. expected number of entries in a lifetime
    */
   size_t m_capacity;
 
@@ -171,44 +211,9 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
    */
   static const size_t MAX_CAPACITY;
 
-  // ---- actual entry lifetime estimation
-
-  /** \brief the MARK for capacity
-   *
-   *  The MARK doesn't have a distinct type.
-   *  Entry is a hash. The hash function should have non-invertible property,
-   *  so it's unlikely for a usual Entry to have collision with the MARK.
-   */
-  static const Entry MARK;
-
-  /** \brief expected number of MARKs in the index
-   */
-  static const size_t EXPECTED_MARK_COUNT;
-
-  /** \brief number of MARKs in the index after each MARK insertion
-   *
-   *  adjustCapacity uses this to determine whether and how to adjust capcity,
-   *  and then clears this list.
-   */
-  std::multiset<size_t> m_actualMarkCounts;
-
-  time::nanoseconds m_markInterval;
-
-  scheduler::EventId m_markEvent;
-
-  // ---- capacity adjustments
-
   static const double CAPACITY_UP;
 
   static const double CAPACITY_DOWN;
-
-  time::nanoseconds m_adjustCapacityInterval;
-
-  scheduler::EventId m_adjustCapacityEvent;
-
-  /** \brief maximum number of entries to evict at each operation if index is over capacity
-   */
-  static const size_t EVICT_LIMIT;
 };
 
 inline const time::nanoseconds&
@@ -24,38 +24,60 @@
  */
 
 #include "fib-entry.hpp"
+#include "fib.hpp"
+#include "name-tree-entry.hpp"
 
 namespace nfd {
 namespace fib {
 
+Entry::Entry()
+  : m_fib(nullptr)
+{
+}
+
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
+  , m_fib(nullptr)
+{
+}
+
+Name
+Entry::getPrefix() const
 {
+  if (m_nameTreeEntry != nullptr) {
+    return m_nameTreeEntry->getPrefix();
+  }
+  return m_prefix;
 }
 
 NextHopList::iterator
-Entry::findNextHop(Face& face)
+Entry::findNextHop(FaceId faceId)
 {
   return std::find_if(m_nextHops.begin(), m_nextHops.end(),
-                      [&face] (const NextHop& nexthop) {
-                        return nexthop.getFace().get() == &face;
+                      [faceId] (const NextHop& nexthop) {
+                        return nexthop.getFaceId() == faceId;
                       });
 }
 
 bool
 Entry::hasNextHop(shared_ptr<Face> face) const
 {
-  return const_cast<Entry*>(this)->findNextHop(*face) != m_nextHops.end();
+  return face->getId() != INVALID_FACEID &&
+         const_cast<Entry*>(this)->findNextHop(face->getId()) != m_nextHops.end();
 }
 
 void
 Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
 {
-  auto it = this->findNextHop(*face);
+  BOOST_ASSERT(face->getId() != INVALID_FACEID);
+  auto it = this->findNextHop(face->getId());
   if (it == m_nextHops.end()) {
-    m_nextHops.push_back(fib::NextHop(face));
+    m_nextHops.push_back(fib::NextHop(face->getId()));
     it = m_nextHops.end();
     --it;
+    if (m_fib != nullptr) {
+      m_fib->indexNextHop(*this, it->getFaceId());
+    }
   }
   // now it refers to the NextHop for face
 
@@ -67,8 +89,19 @@ Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
 void
 Entry::removeNextHop(shared_ptr<Face> face)
 {
-  auto it = this->findNextHop(*face);
+  if (face->getId() != INVALID_FACEID) {
+    this->removeNextHop(face->getId());
+  }
+}
+
+void
+Entry::removeNextHop(FaceId faceId)
+{
+  auto it = this->findNextHop(faceId);
   if (it != m_nextHops.end()) {
+    if (m_fib != nullptr) {
+      m_fib->unindexNextHop(*this, it->getFaceId());
+    }
     m_nextHops.erase(it);
   }
 }
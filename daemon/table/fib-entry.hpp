@@ -27,16 +27,20 @@
 #define NFD_DAEMON_TABLE_FIB_ENTRY_HPP
 
 #include "fib-nexthop.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 
 class NameTree;
+class Fib;
 namespace name_tree {
 class Entry;
 }
 
 namespace fib {
 
+class Snapshot;
+
 /** \class NextHopList
  *  \brief represents a collection of nexthops
  *
@@ -44,8 +48,10 @@ namespace fib {
  *    iterator<NextHop> begin()
  *    iterator<NextHop> end()
  *    size_t size()
+ *
+ *  Up to four nexthops are stored inline in the FIB entry.
  */
-typedef std::vector<fib::NextHop> NextHopList;
+typedef SmallVector<fib::NextHop, 4> NextHopList;
 
 /** \class Entry
  *  \brief represents a FIB entry
@@ -53,10 +59,21 @@ typedef std::vector<fib::NextHop> NextHopList;
 class Entry : noncopyable
 {
 public:
+  /** \brief constructs an entry whose prefix is read from the NameTree entry it is attached to
+   */
+  Entry();
+
+  /** \brief constructs an entry with \p prefix, which is used until it is attached to NameTree
+   */
   explicit
   Entry(const Name& prefix);
 
-  const Name&
+  /** \return Name prefix of this entry
+   *
+   *  While the entry is attached to NameTree, the prefix is not stored in the entry
+   *  but obtained from the NameTree entry.
+   */
+  Name
   getPrefix() const;
 
   const NextHopList&
@@ -77,7 +94,7 @@ public:
   /** \brief adds a NextHop record
    *
    *  If a NextHop record for face already exists, its cost is updated.
-   *  \note shared_ptr is passed by value because this function will take shared ownership
+   *  \pre face has a FaceId, i.e. it has been added to FaceTable
    */
   void
   addNextHop(shared_ptr<Face> face, uint64_t cost);
@@ -95,28 +112,33 @@ private:
   /** @note This method is non-const because normal iterator is needed by callers.
    */
   NextHopList::iterator
-  findNextHop(Face& face);
+  findNextHop(FaceId faceId);
+
+  /** \brief removes the NextHop record for \p faceId, if any
+   */
+  void
+  removeNextHop(FaceId faceId);
 
   /// sorts the nexthop list
   void
   sortNextHops();
 
 private:
-  Name m_prefix;
+  Name m_prefix; // empty while attached to NameTree
   NextHopList m_nextHops;
 
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
+
+  /// the Fib that indexes nexthops of this entry, nullptr if not in a Fib
+  Fib* m_fib;
+
   friend class nfd::NameTree;
+  friend class nfd::Fib;
   friend class nfd::name_tree::Entry;
+  friend class Snapshot;
 };
 
 
-inline const Name&
-Entry::getPrefix() const
-{
-  return m_prefix;
-}
-
 inline const NextHopList&
 Entry::getNextHops() const
 {
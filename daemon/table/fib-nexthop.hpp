@@ -34,15 +34,20 @@ namespace fib {
 
 /** \class NextHop
  *  \brief represents a nexthop record in FIB entry
+ *
+ *  NextHop stores the FaceId, not the face. The face is resolved with FaceTable::find,
+ *  which returns nullptr after the face is removed, because the FaceId of a removed face
+ *  never refers to another face. Thus NextHop does not keep the face alive, and
+ *  inspecting a NextHop does not touch any reference count.
  */
 class NextHop
 {
 public:
   explicit
-  NextHop(shared_ptr<Face> face);
+  NextHop(FaceId faceId);
 
-  const shared_ptr<Face>&
-  getFace() const;
+  FaceId
+  getFaceId() const;
 
   void
   setCost(uint64_t cost);
@@ -51,10 +56,28 @@ public:
   getCost() const;
 
 private:
-  shared_ptr<Face> m_face;
+  FaceId m_faceId;
   uint64_t m_cost;
 };
 
+inline FaceId
+NextHop::getFaceId() const
+{
+  return m_faceId;
+}
+
+inline void
+NextHop::setCost(uint64_t cost)
+{
+  m_cost = cost;
+}
+
+inline uint64_t
+NextHop::getCost() const
+{
+  return m_cost;
+}
+
 } // namespace fib
 } // namespace nfd
 
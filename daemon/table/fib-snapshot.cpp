@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fib-snapshot.hpp"
+
+namespace nfd {
+namespace fib {
+
+static const uint32_t INVALID_RECORD = std::numeric_limits<uint32_t>::max();
+
+/// bits in a LengthFilter per prefix of that length
+static const size_t FILTER_BITS_PER_PREFIX = 16;
+
+static inline size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+void
+Snapshot::LengthFilter::reset(size_t nPrefixes)
+{
+  if (nPrefixes == 0) {
+    m_words.clear();
+    m_mask = 0;
+    return;
+  }
+  size_t nBits = roundUpToPowerOfTwo(std::max<size_t>(64, nPrefixes * FILTER_BITS_PER_PREFIX));
+  m_words.assign(nBits / 64, 0);
+  m_mask = nBits - 1;
+}
+
+void
+Snapshot::LengthFilter::add(size_t hash)
+{
+  uint64_t h = static_cast<uint64_t>(hash);
+  size_t bit1 = static_cast<size_t>(h) & m_mask;
+  size_t bit2 = static_cast<size_t>((h >> 32) ^ (h >> 7)) & m_mask;
+  m_words[bit1 / 64] |= uint64_t(1) << (bit1 % 64);
+  m_words[bit2 / 64] |= uint64_t(1) << (bit2 % 64);
+}
+
+bool
+Snapshot::LengthFilter::mayContain(size_t hash) const
+{
+  if (m_words.empty()) {
+    return false;
+  }
+  uint64_t h = static_cast<uint64_t>(hash);
+  size_t bit1 = static_cast<size_t>(h) & m_mask;
+  size_t bit2 = static_cast<size_t>((h >> 32) ^ (h >> 7)) & m_mask;
+  return (m_words[bit1 / 64] >> (bit1 % 64) & 1) != 0 &&
+         (m_words[bit2 / 64] >> (bit2 % 64) & 1) != 0;
+}
+
+Snapshot::Snapshot()
+{
+  this->prepareIndex();
+}
+
+Snapshot::Snapshot(const std::vector<std::pair<shared_ptr<Entry>, size_t>>& entries)
+{
+  BOOST_ASSERT(entries.size() < INVALID_RECORD);
+  m_records.reserve(entries.size());
+  for (const auto& item : entries) {
+    this->appendRecord(item.first, item.second);
+  }
+
+  this->prepareIndex();
+  for (uint32_t i = 0; i < m_records.size(); ++i) {
+    this->indexRecord(i);
+  }
+}
+
+bool
+Snapshot::isLive(const Record& record)
+{
+  shared_ptr<Entry> entry = record.entry.lock();
+  return entry != nullptr && entry->m_fib != nullptr;
+}
+
+void
+Snapshot::appendRecord(const shared_ptr<Entry>& entry, size_t hash)
+{
+  Name prefix = entry->getPrefix();
+  Record record;
+  record.entry = entry;
+  record.hash = hash;
+  record.prefixLen = static_cast<uint32_t>(prefix.size());
+  record.wireOffset = static_cast<uint32_t>(m_wires.size());
+  for (const name::Component& component : prefix) {
+    m_wires.insert(m_wires.end(), component.wire(), component.wire() + component.size());
+  }
+  record.wireLength = static_cast<uint32_t>(m_wires.size() - record.wireOffset);
+  m_records.push_back(record);
+}
+
+void
+Snapshot::appendRecord(const Snapshot& other, const Record& record)
+{
+  // components are copied from the other snapshot, without building the Name
+  const uint8_t* wire = other.m_wires.data() + record.wireOffset;
+  Record copy = record;
+  copy.wireOffset = static_cast<uint32_t>(m_wires.size());
+  m_wires.insert(m_wires.end(), wire, wire + record.wireLength);
+  m_records.push_back(copy);
+}
+
+void
+Snapshot::prepareIndex()
+{
+  BOOST_ASSERT(m_records.size() < INVALID_RECORD);
+
+  std::vector<size_t> nPrefixesByLength;
+  for (const Record& record : m_records) {
+    if (nPrefixesByLength.size() <= record.prefixLen) {
+      nPrefixesByLength.resize(record.prefixLen + 1, 0);
+    }
+    ++nPrefixesByLength[record.prefixLen];
+  }
+
+  m_filters.resize(nPrefixesByLength.size());
+  for (size_t len = 0; len < nPrefixesByLength.size(); ++len) {
+    m_filters[len].reset(nPrefixesByLength[len]);
+  }
+
+  // load factor at most 0.5
+  m_slots.assign(roundUpToPowerOfTwo(std::max<size_t>(2, m_records.size() * 2)), INVALID_RECORD);
+  m_slotMask = m_slots.size() - 1;
+}
+
+void
+Snapshot::indexRecord(uint32_t i)
+{
+  const Record& record = m_records[i];
+  m_filters[record.prefixLen].add(record.hash);
+  size_t slot = record.hash & m_slotMask;
+  while (m_slots[slot] != INVALID_RECORD) {
+    slot = (slot + 1) & m_slotMask;
+  }
+  m_slots[slot] = i;
+}
+
+bool
+Snapshot::matches(const Record& record, const Name& name) const
+{
+  const uint8_t* wire = m_wires.data() + record.wireOffset;
+  const uint8_t* wireEnd = wire + record.wireLength;
+  for (size_t i = 0; i < record.prefixLen; ++i) {
+    const name::Component& component = name.get(i);
+    if (static_cast<size_t>(wireEnd - wire) < component.size() ||
+        !std::equal(component.wire(), component.wire() + component.size(), wire)) {
+      return false;
+    }
+    wire += component.size();
+  }
+  return wire == wireEnd;
+}
+
+shared_ptr<Entry>
+Snapshot::findLongestPrefixMatch(const Name& name, const name_tree::HashContext& hashes,
+                                 size_t minPrefixLen) const
+{
+  BOOST_ASSERT(hashes.size() == name.size());
+
+  for (int len = static_cast<int>(std::min(name.size() + 1, m_filters.size())) - 1;
+       len >= static_cast<int>(minPrefixLen); --len) {
+    size_t hash = hashes.getHash(len);
+    if (!m_filters[len].mayContain(hash)) {
+      continue;
+    }
+
+    for (size_t slot = hash & m_slotMask; m_slots[slot] != INVALID_RECORD;
+         slot = (slot + 1) & m_slotMask) {
+      const Record& record = m_records[m_slots[slot]];
+      if (record.hash == hash && record.prefixLen == static_cast<uint32_t>(len) &&
+          this->matches(record, name)) {
+        // records of erased entries are skipped, so that a shorter prefix may match
+        shared_ptr<Entry> entry = record.entry.lock();
+        if (entry != nullptr && entry->m_fib != nullptr) {
+          return entry;
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+
+Snapshot::Builder::Builder(shared_ptr<const Snapshot> base, const EntryMap& entries)
+  : m_snapshot(make_shared<Snapshot>())
+  , m_base(base)
+  , m_basePos(0)
+  , m_entryIt(entries.begin())
+  , m_entryEnd(entries.end())
+  , m_indexPos(0)
+  , m_stage(STAGE_COPY_BASE)
+{
+  m_snapshot->m_records.reserve((base == nullptr ? 0 : base->size()) + entries.size());
+}
+
+bool
+Snapshot::Builder::build(size_t nSteps)
+{
+  for (; nSteps > 0 && m_stage != STAGE_DONE; --nSteps) {
+    switch (m_stage) {
+    case STAGE_COPY_BASE:
+      if (m_base == nullptr || m_basePos == m_base->m_records.size()) {
+        m_stage = STAGE_ADD_ENTRIES;
+        break;
+      }
+      // records of erased entries are dropped
+      if (isLive(m_base->m_records[m_basePos])) {
+        m_snapshot->appendRecord(*m_base, m_base->m_records[m_basePos]);
+      }
+      ++m_basePos;
+      break;
+    case STAGE_ADD_ENTRIES:
+      if (m_entryIt == m_entryEnd) {
+        m_base.reset();
+        m_snapshot->prepareIndex();
+        m_stage = STAGE_INDEX;
+        break;
+      }
+      {
+        shared_ptr<Entry> entry = m_entryIt->second.lock();
+        if (entry != nullptr && entry->m_fib != nullptr) {
+          m_snapshot->appendRecord(entry, m_entryIt->first);
+        }
+      }
+      ++m_entryIt;
+      break;
+    case STAGE_INDEX:
+      if (m_indexPos == m_snapshot->m_records.size()) {
+        m_stage = STAGE_DONE;
+        break;
+      }
+      m_snapshot->indexRecord(m_indexPos++);
+      break;
+    case STAGE_DONE:
+      break;
+    }
+  }
+  return m_stage == STAGE_DONE;
+}
+
+shared_ptr<const Snapshot>
+Snapshot::Builder::getSnapshot() const
+{
+  BOOST_ASSERT(m_stage == STAGE_DONE);
+  return m_snapshot;
+}
+
+} // namespace fib
+} // namespace nfd
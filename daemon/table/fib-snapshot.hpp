@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_FIB_SNAPSHOT_HPP
+#define NFD_DAEMON_TABLE_FIB_SNAPSHOT_HPP
+
+#include "fib-entry.hpp"
+#include "name-tree.hpp"
+
+namespace nfd {
+namespace fib {
+
+/** \brief an immutable longest prefix match structure compiled from FIB entries
+ *
+ *  Prefixes are kept in a flat open-addressing hash table, keyed by their NameTree hash.
+ *  The Name components of all prefixes are stored back to back in a single buffer.
+ *  A small Bloom filter per prefix length allows a lookup to skip most lengths
+ *  without probing the hash table.
+ *
+ *  A Snapshot never changes after construction. It refers to FIB entries by weak pointers,
+ *  and skips entries that have been erased from FIB, so an old snapshot stays valid
+ *  while FIB changes; entries inserted after compilation must be looked up elsewhere.
+ */
+class Snapshot : noncopyable
+{
+public:
+  /** \brief FIB entries keyed by the NameTree hash of their prefixes
+   */
+  typedef std::unordered_multimap<size_t, weak_ptr<Entry>> EntryMap;
+
+  class Builder;
+
+  /** \brief constructs an empty snapshot
+   */
+  Snapshot();
+
+  /** \brief compiles a snapshot
+   *  \param entries FIB entries, each with the NameTree hash of its prefix
+   */
+  explicit
+  Snapshot(const std::vector<std::pair<shared_ptr<Entry>, size_t>>& entries);
+
+  /** \brief performs a longest prefix match
+   *  \param hashes must be computed from \p name
+   *  \param minPrefixLen only prefixes with at least this many components are considered
+   *  \return matched entry, or nullptr if no prefix of \p name is in the snapshot
+   */
+  shared_ptr<Entry>
+  findLongestPrefixMatch(const Name& name, const name_tree::HashContext& hashes,
+                         size_t minPrefixLen = 0) const;
+
+  /** \return number of prefixes, including those of erased entries
+   */
+  size_t
+  size() const;
+
+private:
+  struct Record
+  {
+    weak_ptr<Entry> entry;
+    size_t hash;
+    uint32_t prefixLen;
+    uint32_t wireOffset; ///< offset of the first component in m_wires
+    uint32_t wireLength; ///< total size of the components
+  };
+
+  /** \brief a Bloom filter of prefix hashes of one prefix length
+   */
+  class LengthFilter
+  {
+  public:
+    void
+    reset(size_t nPrefixes);
+
+    void
+    add(size_t hash);
+
+    bool
+    mayContain(size_t hash) const;
+
+  private:
+    std::vector<uint64_t> m_words;
+    size_t m_mask = 0; ///< number of bits minus one
+  };
+
+  /** \return whether \p record refers to an entry that is still in FIB
+   */
+  static bool
+  isLive(const Record& record);
+
+  bool
+  matches(const Record& record, const Name& name) const;
+
+  void
+  appendRecord(const shared_ptr<Entry>& entry, size_t hash);
+
+  void
+  appendRecord(const Snapshot& other, const Record& record);
+
+  /** \brief sizes the hash table and filters for the appended records
+   */
+  void
+  prepareIndex();
+
+  void
+  indexRecord(uint32_t i);
+
+private:
+  std::vector<Record> m_records;
+  std::vector<uint8_t> m_wires;
+  std::vector<uint32_t> m_slots; ///< index into m_records, or INVALID_RECORD for an empty slot
+  size_t m_slotMask;
+  std::vector<LengthFilter> m_filters; ///< indexed by prefix length
+};
+
+/** \brief compiles a Snapshot in bounded steps
+ *
+ *  The new snapshot contains the live entries of a base snapshot and the live entries
+ *  of an EntryMap. Work is divided into steps of one record each, so that compiling
+ *  a large FIB can be interleaved with packet processing.
+ */
+class Snapshot::Builder : noncopyable
+{
+public:
+  /** \param base snapshot whose live entries are carried over, may be nullptr
+   *  \param entries entries to add; must not be changed until the snapshot is complete
+   */
+  Builder(shared_ptr<const Snapshot> base, const EntryMap& entries);
+
+  /** \brief performs up to \p nSteps steps
+   *  \return whether the snapshot is complete
+   */
+  bool
+  build(size_t nSteps);
+
+  /** \return the compiled snapshot
+   *  \pre build() has returned true
+   */
+  shared_ptr<const Snapshot>
+  getSnapshot() const;
+
+private:
+  enum Stage {
+    STAGE_COPY_BASE,
+    STAGE_ADD_ENTRIES,
+    STAGE_INDEX,
+    STAGE_DONE
+  };
+
+  shared_ptr<Snapshot> m_snapshot;
+  shared_ptr<const Snapshot> m_base;
+  size_t m_basePos;
+  EntryMap::const_iterator m_entryIt;
+  EntryMap::const_iterator m_entryEnd;
+  uint32_t m_indexPos;
+  Stage m_stage;
+};
+
+inline size_t
+Snapshot::size() const
+{
+  return m_records.size();
+}
+
+} // namespace fib
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_FIB_SNAPSHOT_HPP
@@ -35,6 +35,14 @@ namespace nfd {
 
 const shared_ptr<fib::Entry> Fib::s_emptyEntry = make_shared<fib::Entry>(Name());
 
+static const size_t DEFAULT_LPM_CACHE_SIZE = 1024;
+
+const size_t Fib::REMOVAL_CHUNK_SIZE = 1024;
+
+const time::nanoseconds Fib::SNAPSHOT_DELAY = time::milliseconds(100);
+
+const size_t Fib::SNAPSHOT_CHUNK_SIZE = 1024;
+
 // http://en.cppreference.com/w/cpp/concept/ForwardIterator
 BOOST_CONCEPT_ASSERT((boost::ForwardIterator<Fib::const_iterator>));
 // boost::ForwardIterator follows SGI standard http://www.sgi.com/tech/stl/ForwardIterator.html,
@@ -46,33 +54,156 @@ static_assert(std::is_default_constructible<Fib::const_iterator>::value,
 BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Fib::const_iterator>));
 #endif // HAVE_IS_DEFAULT_CONSTRUCTIBLE
 
+static inline bool
+predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
+{
+  return static_cast<bool>(entry.getFibEntry());
+}
+
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_generation(1)
+  , m_snapshot(make_shared<fib::Snapshot>())
+  , m_snapshotGeneration(1)
+  , m_isSnapshotScheduled(false)
 {
+  m_lpmCacheCounters.nHits = 0;
+  m_lpmCacheCounters.nMisses = 0;
+  m_lpmCacheCounters.nInvalidations = 0;
+  this->setLpmCacheSize(DEFAULT_LPM_CACHE_SIZE);
 }
 
 Fib::~Fib()
 {
+  // entries may outlive this Fib
+  auto&& enumerable = m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry);
+  for (const name_tree::Entry& nte : enumerable) {
+    nte.getFibEntry()->m_fib = nullptr;
+  }
 }
 
-static inline bool
-predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
+shared_ptr<fib::Entry>
+Fib::findLongestPrefixMatch(const Name& prefix) const
 {
-  return static_cast<bool>(entry.getFibEntry());
+  return this->findLongestPrefixMatch(prefix, name_tree::HashContext(prefix));
 }
 
 shared_ptr<fib::Entry>
-Fib::findLongestPrefixMatch(const Name& prefix) const
+Fib::findLongestPrefixMatch(const Name& prefix, const name_tree::HashContext& hashes) const
 {
-  shared_ptr<name_tree::Entry> nameTreeEntry =
-    m_nameTree.findLongestPrefixMatch(prefix, &predicate_NameTreeEntry_hasFibEntry);
-  if (static_cast<bool>(nameTreeEntry)) {
-    return nameTreeEntry->getFibEntry();
+  if (m_lpmCache.empty()) {
+    return this->findLongestPrefixMatchUncached(prefix, hashes);
+  }
+
+  size_t hash = hashes.getFullHash();
+  LpmCacheSlot& slot = m_lpmCache[hash % m_lpmCache.size()];
+  const uint8_t* nameWire = hashes.getNameWire();
+  if (slot.generation == m_generation && slot.hash == hash &&
+      slot.nameWire.size() == hashes.getNameWireSize() &&
+      std::equal(slot.nameWire.begin(), slot.nameWire.end(), nameWire)) {
+    ++m_lpmCacheCounters.nHits;
+    if (slot.entry == nullptr) {
+      return s_emptyEntry;
+    }
+    return m_nameTree.get(*slot.entry)->getFibEntry();
+  }
+
+  ++m_lpmCacheCounters.nMisses;
+  shared_ptr<fib::Entry> entry = this->findLongestPrefixMatchUncached(prefix, hashes);
+  slot.generation = m_generation;
+  slot.hash = hash;
+  slot.nameWire.assign(nameWire, nameWire + hashes.getNameWireSize());
+  slot.entry = entry == s_emptyEntry ? nullptr : entry.get();
+  return entry;
+}
+
+shared_ptr<fib::Entry>
+Fib::findLongestPrefixMatchUncached(const Name& prefix,
+                                    const name_tree::HashContext& hashes) const
+{
+  // entries inserted since the snapshot was compiled
+  shared_ptr<fib::Entry> newEntry;
+  size_t minPrefixLen = 0;
+  if (!m_newEntries.empty() || !m_compilingEntries.empty()) {
+    for (int len = static_cast<int>(prefix.size()); len >= 0; --len) {
+      newEntry = this->findInEntryMap(m_newEntries, prefix, hashes, len);
+      if (newEntry == nullptr) {
+        newEntry = this->findInEntryMap(m_compilingEntries, prefix, hashes, len);
+      }
+      if (newEntry != nullptr) {
+        minPrefixLen = len + 1;
+        break;
+      }
+    }
+  }
+
+  shared_ptr<fib::Entry> entry = m_snapshot->findLongestPrefixMatch(prefix, hashes, minPrefixLen);
+  if (entry != nullptr) {
+    return entry;
+  }
+  if (newEntry != nullptr) {
+    return newEntry;
   }
   return s_emptyEntry;
 }
 
+shared_ptr<fib::Entry>
+Fib::findInEntryMap(const fib::Snapshot::EntryMap& entries, const Name& prefix,
+                    const name_tree::HashContext& hashes, size_t prefixLen) const
+{
+  if (entries.empty()) {
+    return nullptr;
+  }
+
+  auto range = entries.equal_range(hashes.getHash(prefixLen));
+  for (auto it = range.first; it != range.second; ++it) {
+    shared_ptr<fib::Entry> entry = it->second.lock();
+    if (entry != nullptr && entry->m_fib == this &&
+        entry->m_nameTreeEntry->matches(prefix, prefixLen)) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+void
+Fib::rebuildSnapshot()
+{
+  if (m_snapshotBuilder == nullptr && m_compilingEntries.empty()) {
+    // erased entries are dropped from the old snapshot, and inserted entries are added
+    m_compilingEntries.swap(m_newEntries);
+    m_snapshotBuilder.reset(new fib::Snapshot::Builder(m_snapshot, m_compilingEntries));
+    m_snapshotGeneration = m_generation;
+  }
+
+  if (m_snapshotBuilder != nullptr) {
+    if (m_snapshotBuilder->build(SNAPSHOT_CHUNK_SIZE)) {
+      m_snapshot = m_snapshotBuilder->getSnapshot();
+      m_snapshotBuilder.reset();
+    }
+  }
+  else {
+    // the installed snapshot contains these entries
+    auto it = m_compilingEntries.begin();
+    for (size_t i = 0; i < SNAPSHOT_CHUNK_SIZE && it != m_compilingEntries.end(); ++i) {
+      it = m_compilingEntries.erase(it);
+    }
+  }
+
+  if (m_snapshotBuilder != nullptr || !m_compilingEntries.empty()) {
+    m_snapshotEvent = scheduler::schedule(time::seconds(0), bind(&Fib::rebuildSnapshot, this));
+    return;
+  }
+
+  m_isSnapshotScheduled = false;
+  if (m_generation != m_snapshotGeneration) {
+    // FIB has changed during the rebuild
+    m_isSnapshotScheduled = true;
+    m_snapshotEvent = scheduler::schedule(SNAPSHOT_DELAY, bind(&Fib::rebuildSnapshot, this));
+  }
+}
+
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const
 {
@@ -123,18 +254,28 @@ Fib::insert(const Name& prefix)
   shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
-  entry = make_shared<fib::Entry>(prefix);
+  entry = make_shared<fib::Entry>();
+  entry->m_fib = this;
   nameTreeEntry->setFibEntry(entry);
+  m_newEntries.insert(std::make_pair(nameTreeEntry->getHash(), entry));
   ++m_nItems;
+  this->bumpGeneration();
   return std::make_pair(entry, true);
 }
 
 void
 Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
 {
+  fib::Entry& entry = *nameTreeEntry->getFibEntry();
+  for (const fib::NextHop& nexthop : entry.getNextHops()) {
+    this->unindexNextHop(entry, nexthop.getFaceId());
+  }
+  entry.m_fib = nullptr;
+
   nameTreeEntry->setFibEntry(shared_ptr<fib::Entry>());
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
   --m_nItems;
+  this->bumpGeneration();
 }
 
 void
@@ -158,21 +299,91 @@ Fib::erase(const fib::Entry& entry)
 void
 Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
 {
-  std::list<fib::Entry*> toErase;
+  FaceId faceId = face->getId();
+  if (faceId == INVALID_FACEID || m_faceIndex.count(faceId) == 0) {
+    return;
+  }
+  m_pendingRemovals.push_back(faceId);
+  this->processPendingNextHopRemovals();
+}
 
-  auto&& enumerable = m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry);
-  for (const name_tree::Entry& nte : enumerable) {
-    shared_ptr<fib::Entry> entry = nte.getFibEntry();
-    entry->removeNextHop(face);
-    if (!entry->hasNextHops()) {
-      toErase.push_back(entry.get());
-      // entry needs to be erased, but we must wait until the enumeration ends,
-      // because otherwise NameTree iterator would be invalidated
+void
+Fib::processPendingNextHopRemovals()
+{
+  size_t budget = REMOVAL_CHUNK_SIZE;
+  std::vector<fib::Entry*> chunk;
+  while (!m_pendingRemovals.empty() && budget > 0) {
+    FaceId faceId = m_pendingRemovals.front();
+    auto it = m_faceIndex.find(faceId);
+    if (it == m_faceIndex.end()) {
+      m_pendingRemovals.pop_front();
+      continue;
+    }
+
+    chunk.clear();
+    for (fib::Entry* entry : it->second) {
+      chunk.push_back(entry);
+      if (chunk.size() == budget) {
+        break;
+      }
     }
+    budget -= chunk.size();
+    // 'it' is invalidated below, because removeNextHop updates the index
+
+    for (fib::Entry* entry : chunk) {
+      entry->removeNextHop(faceId);
+      if (!entry->hasNextHops()) {
+        this->erase(*entry);
+      }
+    }
+  }
+
+  if (!m_pendingRemovals.empty()) {
+    m_removalEvent = scheduler::schedule(time::seconds(0),
+                                         bind(&Fib::processPendingNextHopRemovals, this));
+  }
+}
+
+void
+Fib::indexNextHop(fib::Entry& entry, FaceId faceId)
+{
+  BOOST_ASSERT(faceId != INVALID_FACEID);
+  m_faceIndex[faceId].insert(&entry);
+}
+
+void
+Fib::unindexNextHop(fib::Entry& entry, FaceId faceId)
+{
+  auto it = m_faceIndex.find(faceId);
+  if (it == m_faceIndex.end()) {
+    return;
+  }
+  it->second.erase(&entry);
+  if (it->second.empty()) {
+    m_faceIndex.erase(it);
   }
+}
+
+void
+Fib::setLpmCacheSize(size_t nSlots)
+{
+  LpmCacheSlot emptySlot;
+  emptySlot.generation = 0;
+  emptySlot.hash = 0;
+  emptySlot.entry = nullptr;
+  m_lpmCache.assign(nSlots, emptySlot);
+}
+
+void
+Fib::bumpGeneration()
+{
+  ++m_generation;
+  ++m_lpmCacheCounters.nInvalidations;
 
-  for (fib::Entry* entry : toErase) {
-    this->erase(*entry);
+  // later changes in this batch share one rebuild
+  if (!m_isSnapshotScheduled) {
+    m_isSnapshotScheduled = true;
+    m_snapshotEvent = scheduler::schedule(SNAPSHOT_DELAY, bind(&Fib::rebuildSnapshot, this));
   }
 }
 
@@ -27,7 +27,11 @@
 #define NFD_DAEMON_TABLE_FIB_HPP
 
 #include "fib-entry.hpp"
+#include "fib-snapshot.hpp"
 #include "name-tree.hpp"
+#include "core/scheduler.hpp"
+
+#include <deque>
 
 namespace nfd {
 
@@ -57,6 +61,12 @@ public: // lookup
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const Name& prefix) const;
 
+  /** \brief performs a longest prefix match, using precomputed hashes
+   *  \param hashes must be computed from \p prefix, e.g. Forwarder::getHashContext
+   */
+  shared_ptr<fib::Entry>
+  findLongestPrefixMatch(const Name& prefix, const name_tree::HashContext& hashes) const;
+
   /// performs a longest prefix match
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const pit::Entry& pitEntry) const;
@@ -68,6 +78,57 @@ public: // lookup
   shared_ptr<fib::Entry>
   findExactMatch(const Name& prefix) const;
 
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // snapshot
+  /** \brief returns the compiled lookup structure of FIB, never nullptr
+   *
+   *  findLongestPrefixMatch(const Name&) performs lookups on this snapshot instead of
+   *  NameTree, so that its performance does not depend on PIT and CS entries in NameTree.
+   *  The snapshot stays in use after FIB changes: it skips erased entries, and entries
+   *  inserted since it was compiled are looked up in a small hash table beside it.
+   *  A FIB change schedules a rebuild after SNAPSHOT_DELAY, so that a batch of changes
+   *  costs one rebuild. The rebuild is divided into chunks of SNAPSHOT_CHUNK_SIZE entries,
+   *  which are interleaved with packet processing.
+   */
+  shared_ptr<const fib::Snapshot>
+  getSnapshot() const;
+
+  /// delay between a FIB change and the snapshot rebuild
+  static const time::nanoseconds SNAPSHOT_DELAY;
+
+  /// maximum number of entries processed by one step of the snapshot rebuild
+  static const size_t SNAPSHOT_CHUNK_SIZE;
+
+public: // longest prefix match cache
+  /** \brief counters of the longest prefix match cache
+   */
+  struct LpmCacheCounters
+  {
+    /// lookups answered from the cache
+    uint64_t nHits;
+    /// lookups that performed a NameTree longest prefix match
+    uint64_t nMisses;
+    /// FIB changes that invalidated all cached results
+    uint64_t nInvalidations;
+  };
+
+  /** \brief sets the number of slots in the longest prefix match cache
+   *
+   *  findLongestPrefixMatch(const Name&) remembers its result in a direct-mapped cache,
+   *  indexed by the hash of the Name. Cached results are tagged with a FIB generation,
+   *  which is incremented whenever a FIB entry is inserted or erased, so that results
+   *  computed before a FIB change are never returned.
+   *
+   *  \param nSlots number of slots; 0 disables the cache
+   */
+  void
+  setLpmCacheSize(size_t nSlots);
+
+  size_t
+  getLpmCacheSize() const;
+
+  const LpmCacheCounters&
+  getLpmCacheCounters() const;
+
 public: // mutation
   /** \brief inserts a FIB entry for prefix
    *  If an entry for exact same prefix exists, that entry is returned.
@@ -87,11 +148,28 @@ public: // mutation
    *  This is usually invoked when face goes away.
    *  Removing the last NextHop in a FIB entry will erase the FIB entry.
    *
+   *  FIB keeps an index from FaceId to the entries that have a NextHop for that face,
+   *  so this takes time proportional to the number of routes through \p face.
+   *  At most REMOVAL_CHUNK_SIZE entries are processed before this function returns;
+   *  remaining entries are processed in subsequent chunks scheduled on the event loop,
+   *  so that a face with many routes does not block packet processing.
+   *
+   *  NextHops of a removed face are not used in the meantime, because its FaceId no longer
+   *  resolves in FaceTable. If \p face has no FaceId, it has no NextHop, and nothing is done.
+   *
    *  \todo change parameter type to Face&
    */
   void
   removeNextHopFromAllEntries(shared_ptr<Face> face);
 
+  /** \return whether some NextHop removals are deferred to a subsequent chunk
+   */
+  bool
+  hasPendingNextHopRemovals() const;
+
+  /// maximum number of entries processed in one chunk of removeNextHopFromAllEntries
+  static const size_t REMOVAL_CHUNK_SIZE;
+
 public: // enumeration
   class const_iterator;
 
@@ -149,10 +227,83 @@ private:
   void
   erase(shared_ptr<name_tree::Entry> nameTreeEntry);
 
+  /** \brief processes one chunk of deferred NextHop removals
+   */
+  void
+  processPendingNextHopRemovals();
+
+  /** \brief records that \p entry has a NextHop for \p faceId
+   *  \note called by fib::Entry
+   */
+  void
+  indexNextHop(fib::Entry& entry, FaceId faceId);
+
+  /** \brief records that \p entry no longer has a NextHop for \p faceId
+   *  \note called by fib::Entry
+   */
+  void
+  unindexNextHop(fib::Entry& entry, FaceId faceId);
+
+  shared_ptr<fib::Entry>
+  findLongestPrefixMatchUncached(const Name& prefix, const name_tree::HashContext& hashes) const;
+
+  /** \return an entry in \p entries whose prefix is the first \p prefixLen components
+   *          of \p prefix, or nullptr
+   */
+  shared_ptr<fib::Entry>
+  findInEntryMap(const fib::Snapshot::EntryMap& entries, const Name& prefix,
+                 const name_tree::HashContext& hashes, size_t prefixLen) const;
+
+  /** \brief invalidates all cached longest prefix match results, and schedules a snapshot
+   *         rebuild
+   */
+  void
+  bumpGeneration();
+
+  /** \brief performs one step of the snapshot rebuild, and schedules the next one
+   */
+  void
+  rebuildSnapshot();
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief a slot in the longest prefix match cache
+   *
+   *  The slot stores a plain pointer to the matched entry. It is never dereferenced
+   *  after the entry is erased, because erasing bumps the FIB generation.
+   */
+  struct LpmCacheSlot
+  {
+    uint64_t generation; ///< 0 indicates an empty slot
+    size_t hash;
+    std::vector<uint8_t> nameWire; ///< TLV of the looked up Name, to rule out hash collisions
+    fib::Entry* entry; ///< matched entry, nullptr indicates no match
+  };
+
+  uint64_t m_generation;
+  shared_ptr<const fib::Snapshot> m_snapshot;
+  /// entries inserted since the snapshot rebuild in progress has started
+  fib::Snapshot::EntryMap m_newEntries;
+  /// entries being added to the snapshot, cleared after the new snapshot is installed
+  fib::Snapshot::EntryMap m_compilingEntries;
+  unique_ptr<fib::Snapshot::Builder> m_snapshotBuilder;
+  /// generation from which the snapshot in progress is compiled
+  uint64_t m_snapshotGeneration;
+  scheduler::ScopedEventId m_snapshotEvent;
+  bool m_isSnapshotScheduled;
+  mutable std::vector<LpmCacheSlot> m_lpmCache;
+  mutable LpmCacheCounters m_lpmCacheCounters;
+
+  /// FaceId => entries that have a NextHop for the face
+  std::unordered_map<FaceId, std::unordered_set<fib::Entry*>> m_faceIndex;
+  /// FaceIds of faces whose NextHops are being removed in chunks
+  std::deque<FaceId> m_pendingRemovals;
+  scheduler::ScopedEventId m_removalEvent;
+
+  friend class fib::Entry;
+
   /** \brief The empty FIB entry.
    *
    *  This entry has no nexthops.
@@ -168,6 +319,30 @@ Fib::size() const
   return m_nItems;
 }
 
+inline shared_ptr<const fib::Snapshot>
+Fib::getSnapshot() const
+{
+  return m_snapshot;
+}
+
+inline bool
+Fib::hasPendingNextHopRemovals() const
+{
+  return !m_pendingRemovals.empty();
+}
+
+inline size_t
+Fib::getLpmCacheSize() const
+{
+  return m_lpmCache.size();
+}
+
+inline const Fib::LpmCacheCounters&
+Fib::getLpmCacheCounters() const
+{
+  return m_lpmCacheCounters;
+}
+
 inline Fib::const_iterator
 Fib::end() const
 {
@@ -23,15 +23,30 @@
  **/
 
 #include "measurements-entry.hpp"
+#include "name-tree-entry.hpp"
 
 namespace nfd {
 namespace measurements {
 
+Entry::Entry()
+  : m_expiry(time::steady_clock::TimePoint::min())
+{
+}
+
 Entry::Entry(const Name& name)
   : m_name(name)
   , m_expiry(time::steady_clock::TimePoint::min())
 {
 }
 
+Name
+Entry::getName() const
+{
+  if (m_nameTreeEntry != nullptr) {
+    return m_nameTreeEntry->getPrefix();
+  }
+  return m_name;
+}
+
 } // namespace measurements
 } // namespace nfd
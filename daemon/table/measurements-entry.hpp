@@ -28,7 +28,6 @@
 
 #include "common.hpp"
 #include "strategy-info-host.hpp"
-#include "core/scheduler.hpp"
 
 namespace nfd {
 
@@ -48,18 +47,25 @@ namespace measurements {
 class Entry : public StrategyInfoHost, noncopyable
 {
 public:
+  /** \brief constructs an entry whose Name is read from the NameTree entry it is attached to
+   */
+  Entry();
+
   explicit
   Entry(const Name& name);
 
-  const Name&
+  /** \return Name prefix of this entry
+   *
+   *  While the entry is attached to NameTree, the Name is obtained from the NameTree entry.
+   */
+  Name
   getName() const;
 
 private:
-  Name m_name;
+  Name m_name; // empty while attached to NameTree
 
 private: // lifetime
   time::steady_clock::TimePoint m_expiry;
-  scheduler::EventId m_cleanup;
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
 
   friend class nfd::NameTree;
@@ -67,12 +73,6 @@ private: // lifetime
   friend class nfd::Measurements;
 };
 
-inline const Name&
-Entry::getName() const
-{
-  return m_name;
-}
-
 } // namespace measurements
 } // namespace nfd
 
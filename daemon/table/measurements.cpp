@@ -32,9 +32,12 @@ namespace nfd {
 
 using measurements::Entry;
 
+const size_t Measurements::SWEEP_CHUNK_SIZE = 1024;
+
 Measurements::Measurements(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_nextSweep(time::steady_clock::TimePoint::max())
 {
 }
 
@@ -45,13 +48,15 @@ Measurements::get(name_tree::Entry& nte)
   if (entry != nullptr)
     return entry;
 
-  entry = make_shared<Entry>(nte.getPrefix());
+  entry = make_shared<Entry>();
   nte.setMeasurementsEntry(entry);
   ++m_nItems;
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = scheduler::schedule(getInitialLifetime(),
-                                         bind(&Measurements::cleanup, this, ref(*entry)));
+  this->insertIntoBucket(entry);
+  if (m_buckets.begin()->first < m_nextSweep) {
+    this->scheduleSweep();
+  }
 
   return entry;
 }
@@ -80,13 +85,11 @@ Measurements::get(const pit::Entry& pitEntry)
 shared_ptr<Entry>
 Measurements::getParent(const Entry& child)
 {
-  if (child.getName().size() == 0) { // the root entry
-    return nullptr;
-  }
-
   shared_ptr<name_tree::Entry> nteChild = m_nameTree.get(child);
   shared_ptr<name_tree::Entry> nte = nteChild->getParent();
-  BOOST_ASSERT(nte != nullptr);
+  if (nte == nullptr) { // the root entry
+    return nullptr;
+  }
   return this->get(*nte);
 }
 
@@ -131,36 +134,76 @@ Measurements::findExactMatch(const Name& name) const
 }
 
 void
-Measurements::extendLifetime(Entry& entry,
-                             const time::nanoseconds& lifetime)
+Measurements::cleanup(Entry& entry)
 {
   shared_ptr<name_tree::Entry> nte = m_nameTree.get(entry);
-  if (nte == nullptr ||
-      nte->getMeasurementsEntry().get() != &entry) {
-    // entry is already gone; it is a dangling reference
-    return;
+  if (nte != nullptr) {
+    nte->setMeasurementsEntry(nullptr);
+    m_nameTree.eraseEntryIfEmpty(nte);
+    m_nItems--;
   }
+}
 
-  time::steady_clock::TimePoint expiry = time::steady_clock::now() + lifetime;
-  if (entry.m_expiry >= expiry) {
-    // has longer lifetime, not extending
-    return;
+static time::steady_clock::TimePoint
+computeSweepDeadline(const time::steady_clock::TimePoint& expiry)
+{
+  int64_t interval = Measurements::getSweepInterval().count();
+  int64_t sinceEpoch = time::duration_cast<time::nanoseconds>(expiry.time_since_epoch()).count();
+  int64_t nIntervals = sinceEpoch / interval + (sinceEpoch % interval > 0 ? 1 : 0);
+  return time::steady_clock::TimePoint(time::nanoseconds(nIntervals * interval));
+}
+
+void
+Measurements::insertIntoBucket(shared_ptr<Entry> entry)
+{
+  time::steady_clock::TimePoint deadline = computeSweepDeadline(entry->m_expiry);
+  m_buckets[deadline].push_back(entry);
+}
+
+void
+Measurements::sweep()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  size_t budget = SWEEP_CHUNK_SIZE;
+  while (!m_buckets.empty() && m_buckets.begin()->first <= now && budget > 0) {
+    std::vector<shared_ptr<Entry>>& bucket = m_buckets.begin()->second;
+    while (!bucket.empty() && budget > 0) {
+      shared_ptr<Entry> entry = bucket.back();
+      bucket.pop_back();
+      --budget;
+
+      if (entry->m_nameTreeEntry == nullptr) {
+        // entry is already gone
+        continue;
+      }
+      if (entry->m_expiry <= now) {
+        this->cleanup(*entry);
+      }
+      else {
+        // lifetime has been extended; the new bucket is later than the current bucket
+        this->insertIntoBucket(entry);
+      }
+    }
+    if (bucket.empty()) {
+      m_buckets.erase(m_buckets.begin());
+    }
   }
 
-  scheduler::cancel(entry.m_cleanup);
-  entry.m_expiry = expiry;
-  entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
+  this->scheduleSweep();
 }
 
 void
-Measurements::cleanup(Entry& entry)
+Measurements::scheduleSweep()
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.get(entry);
-  if (nte != nullptr) {
-    nte->setMeasurementsEntry(nullptr);
-    m_nameTree.eraseEntryIfEmpty(nte);
-    m_nItems--;
+  if (m_buckets.empty()) {
+    m_nextSweep = time::steady_clock::TimePoint::max();
+    m_sweepEvent.cancel();
+    return;
   }
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  m_nextSweep = std::max(m_buckets.begin()->first, now);
+  m_sweepEvent = scheduler::schedule(m_nextSweep - now, bind(&Measurements::sweep, this));
 }
 
 } // namespace nfd
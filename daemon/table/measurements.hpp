@@ -28,6 +28,7 @@
 
 #include "measurements-entry.hpp"
 #include "name-tree.hpp"
+#include "core/scheduler.hpp"
 
 namespace nfd {
 
@@ -124,10 +125,22 @@ public:
   /** \brief extend lifetime of an entry
    *
    *  The entry will be kept until at least now()+lifetime.
+   *  This only updates the expiry timestamp of the entry; the entry is erased
+   *  by the sweeper after it expires.
    */
   void
   extendLifetime(measurements::Entry& entry, const time::nanoseconds& lifetime);
 
+  /** \brief granularity of the expiry index
+   *
+   *  An expired entry is erased within this duration after its expiry.
+   */
+  static time::nanoseconds
+  getSweepInterval();
+
+  /// maximum number of entries examined in one chunk of the sweeper
+  static const size_t SWEEP_CHUNK_SIZE;
+
   size_t
   size() const;
 
@@ -135,6 +148,25 @@ private:
   void
   cleanup(measurements::Entry& entry);
 
+  /** \brief add \p entry to the expiry bucket of its expiry timestamp
+   */
+  void
+  insertIntoBucket(shared_ptr<measurements::Entry> entry);
+
+  /** \brief erase expired entries in due buckets, and move extended entries to later buckets
+   *
+   *  At most SWEEP_CHUNK_SIZE entries are examined before this function returns;
+   *  if more entries are due, the sweep continues in a subsequent chunk
+   *  scheduled on the event loop.
+   */
+  void
+  sweep();
+
+  /** \brief schedule the sweeper at the deadline of the earliest bucket
+   */
+  void
+  scheduleSweep();
+
   shared_ptr<measurements::Entry>
   get(name_tree::Entry& nte);
 
@@ -147,6 +179,19 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+
+  /** \brief coarse expiry index
+   *
+   *  Each entry is in the bucket whose deadline is the first multiple of
+   *  getSweepInterval() at or after its expiry when it was indexed.
+   *  An entry whose lifetime has been extended since then is moved to a later bucket
+   *  when the sweeper reaches it, so that extendLifetime does not touch this index.
+   */
+  typedef std::map<time::steady_clock::TimePoint,
+                   std::vector<shared_ptr<measurements::Entry>>> ExpiryBuckets;
+  ExpiryBuckets m_buckets;
+  time::steady_clock::TimePoint m_nextSweep;
+  scheduler::ScopedEventId m_sweepEvent;
 };
 
 inline time::nanoseconds
@@ -155,6 +200,21 @@ Measurements::getInitialLifetime()
   return time::seconds(4);
 }
 
+inline time::nanoseconds
+Measurements::getSweepInterval()
+{
+  return time::seconds(1);
+}
+
+inline void
+Measurements::extendLifetime(measurements::Entry& entry, const time::nanoseconds& lifetime)
+{
+  time::steady_clock::TimePoint expiry = time::steady_clock::now() + lifetime;
+  if (entry.m_expiry < expiry) {
+    entry.m_expiry = expiry;
+  }
+}
+
 inline size_t
 Measurements::size() const
 {
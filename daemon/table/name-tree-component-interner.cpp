@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "name-tree-component-interner.hpp"
+
+namespace nfd {
+namespace name_tree {
+
+const ComponentInterner::Id ComponentInterner::INVALID_ID = std::numeric_limits<Id>::max();
+
+ComponentInterner::Id
+ComponentInterner::find(const name::Component& component, size_t hash) const
+{
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (m_slots[it->second].component == component) {
+      return it->second;
+    }
+  }
+  return INVALID_ID;
+}
+
+ComponentInterner::Id
+ComponentInterner::acquire(const name::Component& component, size_t hash)
+{
+  Id id = this->find(component, hash);
+  if (id != INVALID_ID) {
+    ++m_slots[id].refCount;
+    return id;
+  }
+
+  if (m_freeIds.empty()) {
+    BOOST_ASSERT(m_slots.size() < INVALID_ID);
+    id = static_cast<Id>(m_slots.size());
+    m_slots.push_back(Slot());
+  }
+  else {
+    id = m_freeIds.back();
+    m_freeIds.pop_back();
+  }
+
+  Slot& slot = m_slots[id];
+  // copy into a new buffer, rather than sharing the buffer of the packet it came from
+  slot.component = name::Component(Block(component.wire(), component.size()));
+  slot.hash = hash;
+  slot.refCount = 1;
+  m_index.emplace(hash, id);
+  return id;
+}
+
+void
+ComponentInterner::release(Id id)
+{
+  BOOST_ASSERT(id < m_slots.size() && m_slots[id].refCount > 0);
+  Slot& slot = m_slots[id];
+  if (--slot.refCount > 0) {
+    return;
+  }
+
+  auto range = m_index.equal_range(slot.hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == id) {
+      m_index.erase(it);
+      break;
+    }
+  }
+  slot.component = name::Component();
+  m_freeIds.push_back(id);
+}
+
+} // namespace name_tree
+} // namespace nfd
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_NAME_TREE_COMPONENT_INTERNER_HPP
+#define NFD_DAEMON_TABLE_NAME_TREE_COMPONENT_INTERNER_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+namespace name_tree {
+
+/** \brief maps Name components to compact IDs
+ *
+ *  Each distinct component is stored once, in its own buffer, and identified by an Id.
+ *  An interned component is reference counted: acquire() increments the count,
+ *  and release() decrements it. A component whose count drops to zero is forgotten,
+ *  and its Id may be reused.
+ *
+ *  Components are looked up by their hash, as computed by NameTree, so that
+ *  a caller holding a HashContext never hashes a component again.
+ */
+class ComponentInterner : noncopyable
+{
+public:
+  typedef uint32_t Id;
+
+  /// an Id that refers to no component
+  static const Id INVALID_ID;
+
+  /** \brief finds the Id of \p component, without acquiring it
+   *  \param hash hash of \p component
+   *  \return Id, or INVALID_ID if \p component is not interned
+   */
+  Id
+  find(const name::Component& component, size_t hash) const;
+
+  /** \brief interns \p component, and increments its reference count
+   *  \param hash hash of \p component
+   *  \return Id of \p component
+   */
+  Id
+  acquire(const name::Component& component, size_t hash);
+
+  /** \brief decrements reference count of \p id, and forgets the component at zero
+   */
+  void
+  release(Id id);
+
+  /** \return the interned component of \p id
+   *
+   *  The returned component has its own buffer, so that Names built from interned
+   *  components do not keep packet buffers alive.
+   */
+  const name::Component&
+  get(Id id) const;
+
+  /** \return reference count of \p id
+   */
+  size_t
+  getRefCount(Id id) const;
+
+  /** \return number of interned components
+   */
+  size_t
+  size() const;
+
+private:
+  struct Slot
+  {
+    name::Component component;
+    size_t hash;
+    size_t refCount;
+  };
+
+  std::vector<Slot> m_slots;
+  std::vector<Id> m_freeIds;
+  std::unordered_multimap<size_t, Id> m_index;
+};
+
+inline const name::Component&
+ComponentInterner::get(Id id) const
+{
+  BOOST_ASSERT(id < m_slots.size() && m_slots[id].refCount > 0);
+  return m_slots[id].component;
+}
+
+inline size_t
+ComponentInterner::getRefCount(Id id) const
+{
+  BOOST_ASSERT(id < m_slots.size());
+  return m_slots[id].refCount;
+}
+
+inline size_t
+ComponentInterner::size() const
+{
+  return m_index.size();
+}
+
+} // namespace name_tree
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_NAME_TREE_COMPONENT_INTERNER_HPP
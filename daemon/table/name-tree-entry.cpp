@@ -47,11 +47,60 @@ Node::~Node()
 Entry::Entry(const Name& name)
   : m_hash(0)
   , m_prefix(name)
+  , m_componentId(ComponentInterner::INVALID_ID)
+  , m_effectiveStrategy(nullptr)
+  , m_strategyGeneration(0)
 {
 }
 
 Entry::~Entry()
 {
+  // the component stays interned while the entry exists, even after it is erased
+  // from NameTree, so that getPrefix() still works
+  if (m_componentId != ComponentInterner::INVALID_ID) {
+    m_interner->release(m_componentId);
+  }
+}
+
+bool
+Entry::matches(const Name& name, size_t prefixLen) const
+{
+  BOOST_ASSERT(prefixLen <= name.size());
+
+  // compare one component per interned ancestor, up to an entry that has its Name
+  const Entry* entry = this;
+  while (entry->m_prefix.empty() && entry->m_componentId != ComponentInterner::INVALID_ID) {
+    if (prefixLen == 0 ||
+        entry->m_interner->get(entry->m_componentId) != name.get(prefixLen - 1)) {
+      return false;
+    }
+    --prefixLen;
+    entry = entry->m_parent.get();
+  }
+
+  // isPrefixOf() is used to avoid making a copy of the name
+  return entry->m_prefix.size() == prefixLen && entry->m_prefix.isPrefixOf(name);
+}
+
+Name
+Entry::getPrefix() const
+{
+  if (m_componentId == ComponentInterner::INVALID_ID) {
+    return m_prefix;
+  }
+
+  std::vector<ComponentInterner::Id> ids;
+  const Entry* entry = this;
+  while (entry->m_prefix.empty() && entry->m_componentId != ComponentInterner::INVALID_ID) {
+    ids.push_back(entry->m_componentId);
+    entry = entry->m_parent.get();
+  }
+
+  Name prefix = entry->m_prefix;
+  for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+    prefix.append(m_interner->get(*it));
+  }
+  return prefix;
 }
 
 bool
@@ -72,10 +121,14 @@ Entry::setFibEntry(shared_ptr<fib::Entry> fibEntry)
   }
 
   if (static_cast<bool>(m_fibEntry)) {
+    // a detached entry keeps its own copy of the prefix
+    m_fibEntry->m_prefix = this->getPrefix();
     m_fibEntry->m_nameTreeEntry.reset();
   }
   m_fibEntry = fibEntry;
   if (static_cast<bool>(m_fibEntry)) {
+    // an attached entry reads its prefix from this entry
+    m_fibEntry->m_prefix.clear();
     m_fibEntry->m_nameTreeEntry = this->shared_from_this();
   }
 }
@@ -87,6 +140,15 @@ Entry::insertPitEntry(shared_ptr<pit::Entry> pitEntry)
   BOOST_ASSERT(!static_cast<bool>(pitEntry->m_nameTreeEntry));
 
   m_pitEntries.push_back(pitEntry);
+  m_pitSelectorHashes.push_back(pitEntry->getSelectorHash());
+
+  // the entry without selectors occupies the first slot
+  if (pitEntry->getSelectorHash() == 0 && m_pitEntries.size() > 1) {
+    BOOST_ASSERT(m_pitSelectorHashes.front() != 0);
+    std::swap(m_pitEntries.front(), m_pitEntries.back());
+    std::swap(m_pitSelectorHashes.front(), m_pitSelectorHashes.back());
+  }
+
   pitEntry->m_nameTreeEntry = this->shared_from_this();
 }
 
@@ -100,8 +162,13 @@ Entry::erasePitEntry(shared_ptr<pit::Entry> pitEntry)
     std::find(m_pitEntries.begin(), m_pitEntries.end(), pitEntry);
   BOOST_ASSERT(it != m_pitEntries.end());
 
+  // swap with the last: this keeps the entry without selectors first, because the last
+  // is never that entry unless it is also the erased one
+  size_t pos = it - m_pitEntries.begin();
   *it = m_pitEntries.back();
   m_pitEntries.pop_back();
+  m_pitSelectorHashes[pos] = m_pitSelectorHashes.back();
+  m_pitSelectorHashes.pop_back();
   pitEntry->m_nameTreeEntry.reset();
 }
 
@@ -113,10 +180,12 @@ Entry::setMeasurementsEntry(shared_ptr<measurements::Entry> measurementsEntry)
   }
 
   if (static_cast<bool>(m_measurementsEntry)) {
+    m_measurementsEntry->m_name = this->getPrefix();
     m_measurementsEntry->m_nameTreeEntry.reset();
   }
   m_measurementsEntry = measurementsEntry;
   if (static_cast<bool>(m_measurementsEntry)) {
+    m_measurementsEntry->m_name.clear();
     m_measurementsEntry->m_nameTreeEntry = this->shared_from_this();
   }
 }
@@ -129,10 +198,12 @@ Entry::setStrategyChoiceEntry(shared_ptr<strategy_choice::Entry> strategyChoiceE
   }
 
   if (static_cast<bool>(m_strategyChoiceEntry)) {
+    m_strategyChoiceEntry->m_prefix = this->getPrefix();
     m_strategyChoiceEntry->m_nameTreeEntry.reset();
   }
   m_strategyChoiceEntry = strategyChoiceEntry;
   if (static_cast<bool>(m_strategyChoiceEntry)) {
+    m_strategyChoiceEntry->m_prefix.clear();
     m_strategyChoiceEntry->m_nameTreeEntry = this->shared_from_this();
   }
 }
@@ -31,10 +31,12 @@
 #include "table/pit-entry.hpp"
 #include "table/measurements-entry.hpp"
 #include "table/strategy-choice-entry.hpp"
+#include "table/name-tree-component-interner.hpp"
 
 namespace nfd {
 
 class NameTree;
+class StrategyChoice;
 
 namespace name_tree {
 
@@ -70,7 +72,12 @@ public:
 
   ~Entry();
 
-  const Name&
+  /** \return Name prefix of this entry
+   *
+   *  The Name of an interned entry is built from the component Ids of the entry and its
+   *  ancestors on every call, and is not stored.
+   */
+  Name
   getPrefix() const;
 
   void
@@ -94,6 +101,20 @@ public:
   bool
   isEmpty() const;
 
+  /** \return Id of the last component of the prefix in NameTree's ComponentInterner,
+   *          or ComponentInterner::INVALID_ID if the component is not interned
+   */
+  ComponentInterner::Id
+  getComponentId() const;
+
+  /** \return whether the prefix of this entry equals the first \p prefixLen components
+   *          of \p name
+   *
+   *  An interned entry is compared without building its Name.
+   */
+  bool
+  matches(const Name& name, size_t prefixLen) const;
+
 public: // attached table entries
   void
   setFibEntry(shared_ptr<fib::Entry> fibEntry);
@@ -113,6 +134,13 @@ public: // attached table entries
   const std::vector<shared_ptr<pit::Entry> >&
   getPitEntries() const;
 
+  /** \return selector hashes of PIT entries, in the same order as getPitEntries()
+   *
+   *  If there is a PIT entry without selectors (selector hash 0), it is always the first.
+   */
+  const std::vector<size_t>&
+  getPitSelectorHashes() const;
+
   void
   setMeasurementsEntry(shared_ptr<measurements::Entry> measurementsEntry);
 
@@ -130,27 +158,32 @@ private:
   // 1. m_hash is compared before m_prefix is compared
   // 2. fast hash table resize support
   size_t m_hash;
+  // An interned entry leaves m_prefix empty; getPrefix() builds it from
+  // the component Ids of itself and its ancestors.
   Name m_prefix;
+  ComponentInterner::Id m_componentId;
+  shared_ptr<ComponentInterner> m_interner; // set if m_componentId is valid
   shared_ptr<Entry> m_parent;     // Pointing to the parent entry.
   std::vector<shared_ptr<Entry> > m_children; // Children pointers.
   shared_ptr<fib::Entry> m_fibEntry;
   std::vector<shared_ptr<pit::Entry> > m_pitEntries;
+  std::vector<size_t> m_pitSelectorHashes;
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  // effective strategy cached by StrategyChoice,
+  // valid only if m_strategyGeneration equals the generation of StrategyChoice
+  mutable fw::Strategy* m_effectiveStrategy;
+  mutable uint32_t m_strategyGeneration;
+
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
 
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
+  friend class nfd::StrategyChoice;
 };
 
-inline const Name&
-Entry::getPrefix() const
-{
-  return m_prefix;
-}
-
 inline size_t
 Entry::getHash() const
 {
@@ -163,6 +196,12 @@ Entry::setHash(size_t hash)
   m_hash = hash;
 }
 
+inline ComponentInterner::Id
+Entry::getComponentId() const
+{
+  return m_componentId;
+}
+
 inline shared_ptr<Entry>
 Entry::getParent() const
 {
@@ -205,6 +244,12 @@ Entry::getPitEntries() const
   return m_pitEntries;
 }
 
+inline const std::vector<size_t>&
+Entry::getPitSelectorHashes() const
+{
+  return m_pitSelectorHashes;
+}
+
 inline shared_ptr<measurements::Entry>
 Entry::getMeasurementsEntry() const
 {
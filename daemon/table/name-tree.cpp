@@ -111,6 +111,50 @@ computeHashSet(const Name& prefix)
   return hashValueSet;
 }
 
+HashContext::HashContext()
+  : m_nameWire(nullptr)
+  , m_nameWireSize(0)
+{
+  m_hashes.push_back(0);
+}
+
+HashContext::HashContext(const Name& name)
+{
+  this->reset(name);
+}
+
+void
+HashContext::reset(const Name& name)
+{
+  const Block& nameWire = name.wireEncode();
+  m_buffer = nameWire.getBuffer();
+  m_nameWire = nameWire.wire();
+  m_nameWireSize = nameWire.size();
+
+  m_hashes.clear();
+  m_hashes.push_back(0);
+  for (const name::Component& component : name) {
+    const char* wireFormat = reinterpret_cast<const char*>(component.wire());
+    size_t hashUpdate = CityHash::compute(wireFormat, component.size());
+    m_hashes.push_back(m_hashes.back() ^ hashUpdate);
+  }
+}
+
+bool
+HashContext::matches(const Name& name) const
+{
+  if (m_nameWire == nullptr) {
+    return false;
+  }
+
+  const Block& nameWire = name.wireEncode();
+  // a Name decoded from the packet shares its wire buffer with the context;
+  // the buffer is kept alive by the context, so its address cannot be reused by another Name
+  return nameWire.size() == m_nameWireSize &&
+         (nameWire.wire() == m_nameWire ||
+          std::equal(nameWire.begin(), nameWire.end(), m_nameWire));
+}
+
 } // namespace name_tree
 
 NameTree::NameTree(size_t nBuckets)
@@ -122,6 +166,8 @@ NameTree::NameTree(size_t nBuckets)
   , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
   , m_shrinkFactor(0.5)     // reduce the number of buckets by half
   , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
+  , m_interner(make_shared<name_tree::ComponentInterner>())
+  , m_isInterning(false)
 {
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
                                           static_cast<double>(m_nBuckets));
@@ -150,14 +196,25 @@ NameTree::~NameTree()
 
 // insert() is a private function, and called by only lookup()
 std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+NameTree::insert(const Name& name, size_t prefixLen, size_t hashValue,
+                 const shared_ptr<name_tree::Entry>& parent)
 {
-  NFD_LOG_TRACE("insert " << prefix);
+  NFD_LOG_TRACE("insert " << name << " prefixLen=" << prefixLen);
 
-  size_t hashValue = name_tree::computeHash(prefix);
   size_t loc = hashValue % m_nBuckets;
 
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
+  NFD_LOG_TRACE("hash value = " << hashValue << "  location = " << loc);
+
+  // With interning, an entry is identified by its parent and the Id of its last component.
+  // The component hash is recovered from the prefix hashes, which are XOR of component hashes.
+  size_t componentHash = 0;
+  name_tree::ComponentInterner::Id componentId = name_tree::ComponentInterner::INVALID_ID;
+  if (m_isInterning && prefixLen > 0)
+    {
+      BOOST_ASSERT(static_cast<bool>(parent));
+      componentHash = hashValue ^ parent->getHash();
+      componentId = m_interner->find(name.get(prefixLen - 1), componentHash);
+    }
 
   // Check if this Name has been stored
   name_tree::Node* node = m_buckets[loc];
@@ -165,17 +222,28 @@ NameTree::insert(const Name& prefix)
 
   for (node = m_buckets[loc]; node != 0; node = node->m_next)
     {
-      if (static_cast<bool>(node->m_entry))
+      const shared_ptr<name_tree::Entry>& entry = node->m_entry;
+      if (static_cast<bool>(entry) && hashValue == entry->getHash())
         {
-          if (prefix == node->m_entry->m_prefix)
+          if (entry->m_componentId != name_tree::ComponentInterner::INVALID_ID &&
+              componentId != name_tree::ComponentInterner::INVALID_ID)
             {
-              return std::make_pair(node->m_entry, false); // false: old entry
+              // both are interned: an integer compare decides
+              if (entry->m_componentId == componentId && entry->m_parent == parent)
+                {
+                  return std::make_pair(entry, false); // false: old entry
+                }
+            }
+          // either side has no component Id, e.g. interning has been turned off
+          else if (entry->matches(name, prefixLen))
+            {
+              return std::make_pair(entry, false); // false: old entry
             }
         }
       nodePrev = node;
     }
 
-  NFD_LOG_TRACE("Did not find " << prefix << ", need to insert it to the table");
+  NFD_LOG_TRACE("Did not find prefix, need to insert it to the table");
 
   // If no bucket is empty occupied, we need to create a new node, and it is
   // linked from nodePrev
@@ -192,7 +260,18 @@ NameTree::insert(const Name& prefix)
     }
 
   // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
+  shared_ptr<name_tree::Entry> entry;
+  if (m_isInterning && prefixLen > 0)
+    {
+      // the entry stores only the component Id; its Name is built on demand by getPrefix()
+      entry = make_shared<name_tree::Entry>(Name());
+      entry->m_componentId = m_interner->acquire(name.get(prefixLen - 1), componentHash);
+      entry->m_interner = m_interner;
+    }
+  else
+    {
+      entry = make_shared<name_tree::Entry>(name.getPrefix(prefixLen));
+    }
   entry->setHash(hashValue);
   node->m_entry = entry; // link the Entry to its Node
   entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
@@ -203,18 +282,24 @@ NameTree::insert(const Name& prefix)
 // Name Prefix Lookup. Create Name Tree Entry if not found
 shared_ptr<name_tree::Entry>
 NameTree::lookup(const Name& prefix)
+{
+  return this->lookup(prefix, name_tree::HashContext(prefix));
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::lookup(const Name& prefix, const name_tree::HashContext& hashes)
 {
   NFD_LOG_TRACE("lookup " << prefix);
+  BOOST_ASSERT(hashes.size() == prefix.size());
 
   shared_ptr<name_tree::Entry> entry;
   shared_ptr<name_tree::Entry> parent;
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
-      Name temp = prefix.getPrefix(i);
-
       // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
+      std::pair<shared_ptr<name_tree::Entry>, bool> ret =
+        insert(prefix, i, hashes.getHash(i), parent);
       entry = ret.first;
 
       if (ret.second == true)
@@ -241,10 +326,17 @@ NameTree::lookup(const Name& prefix)
 // Exact Match
 shared_ptr<name_tree::Entry>
 NameTree::findExactMatch(const Name& prefix) const
+{
+  return this->findExactMatch(prefix, name_tree::HashContext(prefix));
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::findExactMatch(const Name& prefix, const name_tree::HashContext& hashes) const
 {
   NFD_LOG_TRACE("findExactMatch " << prefix);
+  BOOST_ASSERT(hashes.size() == prefix.size());
 
-  size_t hashValue = name_tree::computeHash(prefix);
+  size_t hashValue = hashes.getFullHash();
   size_t loc = hashValue % m_nBuckets;
 
   NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue <<
@@ -258,7 +350,7 @@ NameTree::findExactMatch(const Name& prefix) const
       entry = node->m_entry;
       if (static_cast<bool>(entry))
         {
-          if (hashValue == entry->getHash() && prefix == entry->getPrefix())
+          if (hashValue == entry->getHash() && entry->matches(prefix, prefix.size()))
             {
               return entry;
             }
@@ -273,18 +365,24 @@ NameTree::findExactMatch(const Name& prefix) const
 // Longest Prefix Match
 shared_ptr<name_tree::Entry>
 NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelector& entrySelector) const
+{
+  return this->findLongestPrefixMatch(prefix, name_tree::HashContext(prefix), entrySelector);
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::HashContext& hashes,
+                                 const name_tree::EntrySelector& entrySelector) const
 {
   NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
+  BOOST_ASSERT(hashes.size() == prefix.size());
 
   shared_ptr<name_tree::Entry> entry;
-  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
-
   size_t hashValue = 0;
   size_t loc = 0;
 
   for (int i = static_cast<int>(prefix.size()); i >= 0; i--)
     {
-      hashValue = hashValueSet[i];
+      hashValue = hashes.getHash(i);
       loc = hashValue % m_nBuckets;
 
       name_tree::Node* node = 0;
@@ -293,9 +391,8 @@ NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelec
           entry = node->m_entry;
           if (static_cast<bool>(entry))
             {
-              // isPrefixOf() is used to avoid making a copy of the name
               if (hashValue == entry->getHash() &&
-                  entry->getPrefix().isPrefixOf(prefix) &&
+                  entry->matches(prefix, i) &&
                   entrySelector(*entry))
                 {
                   return entry;
@@ -550,12 +647,12 @@ NameTree::dump(std::ostream& output) const
           // if the Entry exist, dump its information
           if (static_cast<bool>(entry))
             {
-              output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
+              output << "Bucket" << i << "\t" << entry->getPrefix().toUri() << endl;
               output << "\t\tHash " << entry->m_hash << endl;
 
               if (static_cast<bool>(entry->m_parent))
                 {
-                  output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
+                  output << "\t\tparent->" << entry->m_parent->getPrefix().toUri();
                 }
               else
                 {
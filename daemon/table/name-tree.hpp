@@ -28,6 +28,7 @@
 
 #include "common.hpp"
 #include "name-tree-entry.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 namespace name_tree {
@@ -45,6 +46,67 @@ computeHash(const Name& prefix);
 std::vector<size_t>
 computeHashSet(const Name& prefix);
 
+/** \brief hashes of every prefix of a packet's Name, computed once per packet
+ *
+ *  getHash(i) equals computeHash(name.getPrefix(i)).
+ *  NameTree based tables accept a HashContext in place of hashing the Name again.
+ *  The forwarding pipelines keep one context per Forwarder and recompute it in place
+ *  for each packet (see Forwarder::getHashContext), so that no allocation is needed
+ *  for a Name of up to 16 components.
+ */
+class HashContext : noncopyable
+{
+public:
+  /** \brief constructs an empty context, which must be reset before use
+   */
+  HashContext();
+
+  explicit
+  HashContext(const Name& name);
+
+  /** \brief recomputes the context from \p name, reusing storage
+   */
+  void
+  reset(const Name& name);
+
+  /** \return whether this context is computed from \p name
+   */
+  bool
+  matches(const Name& name) const;
+
+  /** \return number of components in the Name
+   */
+  size_t
+  size() const;
+
+  /** \return hash of the prefix of \p prefixLen components
+   */
+  size_t
+  getHash(size_t prefixLen) const;
+
+  /** \return hash of the whole Name
+   */
+  size_t
+  getFullHash() const;
+
+  /** \return start of the wire encoding of the Name
+   *  \note The context shares the wire buffer of the Name, and does not copy it.
+   */
+  const uint8_t*
+  getNameWire() const;
+
+  /** \return size of the wire encoding of the Name
+   */
+  size_t
+  getNameWireSize() const;
+
+private:
+  ndn::ConstBufferPtr m_buffer; ///< keeps the Name wire encoding alive
+  const uint8_t* m_nameWire;
+  size_t m_nameWireSize;
+  SmallVector<size_t, 16> m_hashes;
+};
+
 /// a predicate to accept or reject an Entry in find operations
 typedef function<bool (const Entry& entry)> EntrySelector;
 
@@ -107,6 +169,28 @@ public: // information
   void
   dump(std::ostream& output) const;
 
+public: // component interning
+  /** \brief enables or disables interning of Name components
+   *
+   *  When enabled, a new entry stores the Id of its last component in a ComponentInterner
+   *  instead of a Name. Together with the parent pointer, which every entry has anyway,
+   *  this is the Id sequence of the prefix. The Name of an interned entry is built on each
+   *  getPrefix() call and is not stored. FIB, StrategyChoice and Measurements entries
+   *  do not store a Name while attached to NameTree, but read it from their NameTree entry.
+   *  lookup() compares component Ids instead of Name components.
+   *
+   *  Entries created while interning is disabled remain usable, and vice versa;
+   *  they are compared by Name components.
+   */
+  void
+  setComponentInterning(bool isEnabled);
+
+  bool
+  isComponentInterning() const;
+
+  const name_tree::ComponentInterner&
+  getComponentInterner() const;
+
 public: // mutation
   /**
    * \brief Look for the Name Tree Entry that contains this name prefix.
@@ -121,6 +205,13 @@ public: // mutation
   shared_ptr<name_tree::Entry>
   lookup(const Name& prefix);
 
+  /** \brief Look for the Name Tree Entry that contains this name prefix,
+   *         using precomputed hashes.
+   *  \param hashes must be computed from \p prefix
+   */
+  shared_ptr<name_tree::Entry>
+  lookup(const Name& prefix, const name_tree::HashContext& hashes);
+
   /**
    * \brief Delete a Name Tree Entry if this entry is empty.
    * \param entry The entry to be deleted if empty.
@@ -138,11 +229,11 @@ public: // shortcut access
   get(const fib::Entry& fibEntry) const;
 
   /// get NameTree entry from attached PIT entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const pit::Entry& pitEntry) const;
 
   /// get NameTree entry from attached Measurements entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const measurements::Entry& measurementsEntry) const;
 
   /// get NameTree entry from attached StrategyChoice entry
@@ -158,6 +249,12 @@ public: // matching
   shared_ptr<name_tree::Entry>
   findExactMatch(const Name& prefix) const;
 
+  /** \brief Exact match lookup, using precomputed hashes
+   *  \param hashes must be computed from \p prefix
+   */
+  shared_ptr<name_tree::Entry>
+  findExactMatch(const Name& prefix, const name_tree::HashContext& hashes) const;
+
   /**
    * \brief Longest prefix matching for the given name
    * \details Starts from the full name string, reduce the number of name component
@@ -168,6 +265,14 @@ public: // matching
                          const name_tree::EntrySelector& entrySelector =
                          name_tree::AnyEntry()) const;
 
+  /** \brief Longest prefix matching, using precomputed hashes
+   *  \param hashes must be computed from \p prefix
+   */
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const Name& prefix, const name_tree::HashContext& hashes,
+                         const name_tree::EntrySelector& entrySelector =
+                         name_tree::AnyEntry()) const;
+
   shared_ptr<name_tree::Entry>
   findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
                          const name_tree::EntrySelector& entrySelector =
@@ -315,19 +420,60 @@ private:
   name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
+  shared_ptr<name_tree::ComponentInterner> m_interner;
+  bool                          m_isInterning;
 
   /**
    * \brief Create a Name Tree Entry if it does not exist, or return the existing
    * Name Tree Entry address.
    * \details Called by lookup() only.
+   * \param name the Name whose prefix is inserted
+   * \param prefixLen number of components in the prefix
+   * \param hashValue hash of the prefix
+   * \param parent entry of the prefix with prefixLen-1 components, null if prefixLen is 0
    * \return The first item is the Name Tree Entry address, the second item is
    * a bool value indicates whether this is an old entry (false) or a new
    * entry (true).
    */
   std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
+  insert(const Name& name, size_t prefixLen, size_t hashValue,
+         const shared_ptr<name_tree::Entry>& parent);
 };
 
+namespace name_tree {
+
+inline size_t
+HashContext::size() const
+{
+  return m_hashes.size() - 1;
+}
+
+inline size_t
+HashContext::getHash(size_t prefixLen) const
+{
+  return m_hashes[prefixLen];
+}
+
+inline size_t
+HashContext::getFullHash() const
+{
+  return m_hashes.back();
+}
+
+inline const uint8_t*
+HashContext::getNameWire() const
+{
+  return m_nameWire;
+}
+
+inline size_t
+HashContext::getNameWireSize() const
+{
+  return m_nameWireSize;
+}
+
+} // namespace name_tree
+
 inline NameTree::const_iterator::~const_iterator()
 {
 }
@@ -344,19 +490,37 @@ NameTree::getNBuckets() const
   return m_nBuckets;
 }
 
+inline void
+NameTree::setComponentInterning(bool isEnabled)
+{
+  m_isInterning = isEnabled;
+}
+
+inline bool
+NameTree::isComponentInterning() const
+{
+  return m_isInterning;
+}
+
+inline const name_tree::ComponentInterner&
+NameTree::getComponentInterner() const
+{
+  return *m_interner;
+}
+
 inline shared_ptr<name_tree::Entry>
 NameTree::get(const fib::Entry& fibEntry) const
 {
   return fibEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const pit::Entry& pitEntry) const
 {
   return pitEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const measurements::Entry& measurementsEntry) const
 {
   return measurementsEntry.m_nameTreeEntry;
@@ -24,6 +24,7 @@
  */
 
 #include "pit-entry.hpp"
+#include "core/city-hash.hpp"
 #include <algorithm>
 
 namespace nfd {
@@ -32,8 +33,29 @@ namespace pit {
 const Name Entry::LOCALHOST_NAME("ndn:/localhost");
 const Name Entry::LOCALHOP_NAME("ndn:/localhop");
 
+size_t
+computeSelectorHash(const ndn::Selectors& selectors)
+{
+  if (selectors.empty()) {
+    return 0;
+  }
+
+  // Selectors equality is wire equality, so equal selectors hash equally
+  const Block& wire = selectors.wireEncode();
+  size_t hash = static_cast<size_t>(CityHash64(reinterpret_cast<const char*>(wire.wire()),
+                                               wire.size()));
+  return hash == 0 ? 1 : hash;
+}
+
 Entry::Entry(const Interest& interest)
-  : m_interest(interest.shared_from_this())
+  : m_isStraggler(false)
+  , m_isSatisfied(false)
+  , m_dataFreshnessPeriod(-1)
+  , m_interest(interest.shared_from_this())
+  , m_selectorHash(computeSelectorHash(interest.getSelectors()))
+  , m_inFaceId(INVALID_FACEID)
+  , m_prevInserted(nullptr)
+  , m_nextInserted(nullptr)
 {
 }
 
@@ -133,8 +155,7 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
     [&face] (const InRecord& inRecord) { return inRecord.getFace() == face; });
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    it = m_inRecords.emplace(face);
   }
 
   it->update(interest);
@@ -160,8 +181,7 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
     [&face] (const OutRecord& outRecord) { return outRecord.getFace() == face; });
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    it = m_outRecords.emplace(face);
   }
 
   it->update(interest);
@@ -28,11 +28,14 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
+#include "pit-record-collection.hpp"
 #include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
 
 namespace nfd {
 
 class NameTree;
+class Pit;
 
 namespace name_tree {
 class Entry;
@@ -41,12 +44,16 @@ class Entry;
 namespace pit {
 
 /** \brief represents an unordered collection of InRecords
+ *
+ *  Two in-records are stored inline; more spill to the heap.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef RecordCollection< InRecord, 2>  InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *
+ *  Two out-records are stored inline; more spill to the heap.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef RecordCollection<OutRecord, 2> OutRecordCollection;
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -62,9 +69,17 @@ enum DuplicateNonceWhere {
   DUPLICATE_NONCE_OUT_OTHER = (1 << 3)
 };
 
+/** \brief computes a hash of Interest selectors
+ *  \return 0 if \p selectors is empty; otherwise a nonzero value,
+ *          which is the same for equal selectors
+ */
+size_t
+computeSelectorHash(const ndn::Selectors& selectors);
+
 /** \brief represents a PIT entry
  */
-class Entry : public StrategyInfoHost, noncopyable
+class Entry : public StrategyInfoHost, public enable_shared_from_this<Entry>,
+              public TimerWheelHook<Entry>, noncopyable
 {
 public:
   explicit
@@ -78,6 +93,12 @@ public:
   const Name&
   getName() const;
 
+  /** \return hash of Interest selectors
+   *  \sa computeSelectorHash
+   */
+  size_t
+  getSelectorHash() const;
+
   /** \brief decides whether Interest can be forwarded to face
    *
    *  \return true if OutRecord of this face does not exist or has expired,
@@ -164,11 +185,20 @@ public: // OutRecord
   hasUnexpiredOutRecords() const;
 
 public:
-  scheduler::EventId m_unsatisfyTimer;
-  scheduler::EventId m_stragglerTimer;
+  /** \brief whether the expiry timer serves as the straggler timer
+   *
+   *  If false, the expiry timer serves as the unsatisfy timer.
+   */
+  bool m_isStraggler;
+
+  /** \brief parameters of Interest finalize pipeline when the straggler timer fires
+   */
+  bool m_isSatisfied;
+  time::milliseconds m_dataFreshnessPeriod;
 
 private:
   shared_ptr<const Interest> m_interest;
+  size_t m_selectorHash;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
 
@@ -177,8 +207,14 @@ private:
 
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
 
+  // admission control, managed by Pit
+  FaceId m_inFaceId;
+  Entry* m_prevInserted;
+  Entry* m_nextInserted;
+
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+  friend class nfd::Pit;
 };
 
 inline const Interest&
@@ -187,6 +223,12 @@ Entry::getInterest() const
   return *m_interest;
 }
 
+inline size_t
+Entry::getSelectorHash() const
+{
+  return m_selectorHash;
+}
+
 inline const InRecordCollection&
 Entry::getInRecords() const
 {
@@ -0,0 +1,329 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
+#define NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
+
+#include "common.hpp"
+
+#include <deque>
+#include <iterator>
+#include <type_traits>
+
+namespace nfd {
+namespace pit {
+
+/** \brief an unordered collection of face records with inline storage
+ *  \tparam T record type
+ *  \tparam N number of records stored inline
+ *
+ *  Most PIT entries have one or two in-records and out-records.
+ *  The first \p N records are stored in slots inside the collection itself,
+ *  so that they share cache lines with the PIT entry and need no heap allocation.
+ *  Further records spill into a std::deque of slots, which is allocated on first use.
+ *
+ *  A record never moves once inserted: erasing a record vacates its slot,
+ *  and a later insertion reuses the first vacant slot.
+ *  Therefore, like std::list, iterators and references to a record stay valid
+ *  until that record is erased, so strategies may keep them across insertions.
+ *  end() is also stable.
+ */
+template<typename T, size_t N>
+class RecordCollection : noncopyable
+{
+private:
+  struct Slot
+  {
+    Slot()
+      : isOccupied(false)
+    {
+    }
+
+    T*
+    get()
+    {
+      return reinterpret_cast<T*>(&storage);
+    }
+
+    const T*
+    get() const
+    {
+      return reinterpret_cast<const T*>(&storage);
+    }
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    bool isOccupied;
+  };
+
+  static const size_t NPOS = std::numeric_limits<size_t>::max();
+
+public:
+  /** \brief forward iterator over occupied slots
+   */
+  template<bool IsConst>
+  class Iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+    typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+    typedef typename std::conditional<IsConst, const RecordCollection*,
+                                      RecordCollection*>::type CollectionPointer;
+
+    Iterator()
+      : m_collection(nullptr)
+      , m_index(NPOS)
+    {
+    }
+
+    Iterator(CollectionPointer collection, size_t index)
+      : m_collection(collection)
+      , m_index(index)
+    {
+    }
+
+    /** \brief converts iterator to const_iterator
+     */
+    template<bool IsOtherConst,
+             typename = typename std::enable_if<IsConst && !IsOtherConst>::type>
+    Iterator(const Iterator<IsOtherConst>& other)
+      : m_collection(other.m_collection)
+      , m_index(other.m_index)
+    {
+    }
+
+    reference
+    operator*() const
+    {
+      return *m_collection->getSlot(m_index).get();
+    }
+
+    pointer
+    operator->() const
+    {
+      return m_collection->getSlot(m_index).get();
+    }
+
+    Iterator&
+    operator++()
+    {
+      m_index = m_collection->findOccupied(m_index + 1);
+      return *this;
+    }
+
+    Iterator
+    operator++(int)
+    {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    template<bool IsOtherConst>
+    bool
+    operator==(const Iterator<IsOtherConst>& other) const
+    {
+      return m_index == other.m_index;
+    }
+
+    template<bool IsOtherConst>
+    bool
+    operator!=(const Iterator<IsOtherConst>& other) const
+    {
+      return m_index != other.m_index;
+    }
+
+  private:
+    CollectionPointer m_collection;
+    size_t m_index;
+
+    template<bool> friend class Iterator;
+    friend class RecordCollection;
+  };
+
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+
+  RecordCollection()
+    : m_size(0)
+  {
+  }
+
+  ~RecordCollection()
+  {
+    this->clear();
+  }
+
+  iterator
+  begin()
+  {
+    return iterator(this, this->findOccupied(0));
+  }
+
+  const_iterator
+  begin() const
+  {
+    return const_iterator(this, this->findOccupied(0));
+  }
+
+  iterator
+  end()
+  {
+    return iterator(this, NPOS);
+  }
+
+  const_iterator
+  end() const
+  {
+    return const_iterator(this, NPOS);
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  /** \brief constructs a record in the first vacant slot
+   *  \return iterator to the new record
+   */
+  template<typename... Args>
+  iterator
+  emplace(Args&&... args)
+  {
+    size_t index = this->findVacant();
+    Slot& slot = this->getSlot(index);
+    new (&slot.storage) T(std::forward<Args>(args)...);
+    slot.isOccupied = true;
+    ++m_size;
+    return iterator(this, index);
+  }
+
+  /** \brief destroys a record and vacates its slot
+   *  \return iterator to the next record
+   */
+  iterator
+  erase(const_iterator pos)
+  {
+    BOOST_ASSERT(pos.m_collection == this);
+    Slot& slot = this->getSlot(pos.m_index);
+    BOOST_ASSERT(slot.isOccupied);
+    slot.get()->~T();
+    slot.isOccupied = false;
+    --m_size;
+    return iterator(this, this->findOccupied(pos.m_index + 1));
+  }
+
+  /** \brief destroys all records, and releases spilled slots
+   */
+  void
+  clear()
+  {
+    for (size_t i = 0, nSlots = this->getNSlots(); i < nSlots; ++i) {
+      Slot& slot = this->getSlot(i);
+      if (slot.isOccupied) {
+        slot.get()->~T();
+        slot.isOccupied = false;
+      }
+    }
+    m_overflow.reset();
+    m_size = 0;
+  }
+
+private:
+  size_t
+  getNSlots() const
+  {
+    return N + (m_overflow == nullptr ? 0 : m_overflow->size());
+  }
+
+  Slot&
+  getSlot(size_t index)
+  {
+    return index < N ? m_inline[index] : (*m_overflow)[index - N];
+  }
+
+  const Slot&
+  getSlot(size_t index) const
+  {
+    return index < N ? m_inline[index] : (*m_overflow)[index - N];
+  }
+
+  /** \return index of first occupied slot at or after \p index, or NPOS
+   */
+  size_t
+  findOccupied(size_t index) const
+  {
+    for (size_t nSlots = this->getNSlots(); index < nSlots; ++index) {
+      if (this->getSlot(index).isOccupied) {
+        return index;
+      }
+    }
+    return NPOS;
+  }
+
+  /** \return index of first vacant slot, appending a slot if none is vacant
+   */
+  size_t
+  findVacant()
+  {
+    size_t nSlots = this->getNSlots();
+    if (m_size < nSlots) {
+      for (size_t index = 0; index < nSlots; ++index) {
+        if (!this->getSlot(index).isOccupied) {
+          return index;
+        }
+      }
+    }
+
+    if (m_overflow == nullptr) {
+      m_overflow.reset(new std::deque<Slot>);
+    }
+    // deque::emplace_back does not move existing slots
+    m_overflow->emplace_back();
+    return nSlots;
+  }
+
+private:
+  Slot m_inline[N];
+  unique_ptr<std::deque<Slot>> m_overflow;
+  size_t m_size;
+};
+
+template<typename T, size_t N>
+const size_t RecordCollection<T, N>::NPOS;
+
+} // namespace pit
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
@@ -54,6 +54,14 @@ BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Pit::const_iterator>));
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_timerWheel(bind(&Pit::expire, this, _1))
+  , m_limit(std::numeric_limits<size_t>::max())
+  , m_overloadPolicy(pit::OVERLOAD_REJECT)
+  , m_faceQuota(std::numeric_limits<size_t>::max())
+  , m_nRejected(0)
+  , m_nEvicted(0)
+  , m_oldest(nullptr)
+  , m_newest(nullptr)
 {
 }
 
@@ -61,41 +69,118 @@ Pit::~Pit()
 {
 }
 
+static bool
+hasPitEntries(const name_tree::Entry& nameTreeEntry)
+{
+  return nameTreeEntry.hasPitEntries();
+}
+
+/** \brief finds the PIT entry for \p interest among those attached to \p nameTreeEntry
+ *  \param selectorHash computeSelectorHash(interest.getSelectors())
+ *
+ *  All PIT entries on a NameTree entry share the Interest Name, so only selectors
+ *  need to be compared, and only on a selector hash hit.
+ */
+static shared_ptr<pit::Entry>
+findEntry(const name_tree::Entry& nameTreeEntry, const Interest& interest, size_t selectorHash)
+{
+  const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry.getPitEntries();
+  const std::vector<size_t>& selectorHashes = nameTreeEntry.getPitSelectorHashes();
+
+  if (selectorHash == 0) {
+    if (!selectorHashes.empty() && selectorHashes.front() == 0) {
+      return pitEntries.front();
+    }
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < selectorHashes.size(); ++i) {
+    if (selectorHashes[i] == selectorHash &&
+        pitEntries[i]->getInterest().getSelectors() == interest.getSelectors()) {
+      return pitEntries[i];
+    }
+  }
+  return nullptr;
+}
+
+std::pair<shared_ptr<pit::Entry>, bool>
+Pit::insert(const Interest& interest, FaceId inFaceId)
+{
+  return this->insert(interest, inFaceId, name_tree::HashContext(interest.getName()));
+}
+
 std::pair<shared_ptr<pit::Entry>, bool>
-Pit::insert(const Interest& interest)
+Pit::insert(const Interest& interest, FaceId inFaceId, const name_tree::HashContext& hashes)
 {
+  BOOST_ASSERT(hashes.matches(interest.getName()));
+  size_t selectorHash = pit::computeSelectorHash(interest.getSelectors());
+
+  if (!this->canAdmit(inFaceId)) {
+    // an Interest that joins an existing entry needs no admission
+    shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.findExactMatch(interest.getName(), hashes);
+    if (nameTreeEntry != nullptr) {
+      shared_ptr<pit::Entry> existing = findEntry(*nameTreeEntry, interest, selectorHash);
+      if (existing != nullptr) {
+        return { existing, false };
+      }
+    }
+
+    // make room before lookup(), because eviction may erase NameTree entries
+    if (!this->makeRoom(inFaceId)) {
+      ++m_nRejected;
+      return { nullptr, false };
+    }
+  }
+
   // first lookup() the Interest Name in the NameTree, which will creates all
   // the intermedia nodes, starting from the shortest prefix.
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName());
+  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName(), hashes);
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
-  const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry->getPitEntries();
-
   // then check if this Interest is already in the PIT entries
-  auto it = std::find_if(pitEntries.begin(), pitEntries.end(),
-                         [&interest] (const shared_ptr<pit::Entry>& entry) {
-                           return entry->getInterest().getName() == interest.getName() &&
-                                  entry->getInterest().getSelectors() == interest.getSelectors();
-                         });
-  if (it != pitEntries.end()) {
-    return { *it, false };
+  shared_ptr<pit::Entry> existing = findEntry(*nameTreeEntry, interest, selectorHash);
+  if (existing != nullptr) {
+    return { existing, false };
   }
 
   shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
+
+  entry->m_inFaceId = inFaceId;
+  if (inFaceId != INVALID_FACEID) {
+    ++m_faceUsages[inFaceId];
+  }
+
+  entry->m_prevInserted = m_newest;
+  if (m_newest != nullptr) {
+    m_newest->m_nextInserted = entry.get();
+  }
+  else {
+    m_oldest = entry.get();
+  }
+  m_newest = entry.get();
+
   return { entry, true };
 }
 
 pit::DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(),
-    [] (const name_tree::Entry& entry) { return entry.hasPitEntries(); });
+  return this->findAllDataMatches(data, name_tree::HashContext(data.getName()));
+}
 
+pit::DataMatchResult
+Pit::findAllDataMatches(const Data& data, const name_tree::HashContext& hashes) const
+{
+  BOOST_ASSERT(hashes.matches(data.getName()));
   pit::DataMatchResult matches;
-  for (const name_tree::Entry& nte : ntMatches) {
-    for (const shared_ptr<pit::Entry>& pitEntry : nte.getPitEntries()) {
+  // walk from the longest prefix up through parents, rather than via NameTree's
+  // findAllMatches, whose iterators are heap-allocated
+  for (shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(data.getName(),
+         hashes, &hasPitEntries);
+       nte != nullptr; nte = nte->getParent()) {
+    for (const shared_ptr<pit::Entry>& pitEntry : nte->getPitEntries()) {
       if (pitEntry->getInterest().matchesData(data))
         matches.emplace_back(pitEntry);
     }
@@ -110,12 +195,10 @@ Pit::findAllDataMatches(const Data& data) const
 pit::DataMatchResult
 Pit::findAllDataMatchesByName(const Name& name)
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(name,
-    [] (const name_tree::Entry& entry) { return entry.hasPitEntries(); });
-
   pit::DataMatchResult matches;
-  for (const name_tree::Entry& nte : ntMatches) {
-    for (const shared_ptr<pit::Entry>& pitEntry : nte.getPitEntries()) {
+  for (shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(name, &hasPitEntries);
+       nte != nullptr; nte = nte->getParent()) {
+    for (const shared_ptr<pit::Entry>& pitEntry : nte->getPitEntries()) {
       if (pitEntry->getInterest().getName().equals(name)) {
         matches.emplace_back(pitEntry);
       }
@@ -131,10 +214,128 @@ Pit::erase(shared_ptr<pit::Entry> pitEntry)
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(*pitEntry);
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
+  m_timerWheel.cancel(*pitEntry);
   nameTreeEntry->erasePitEntry(pitEntry);
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
 
   --m_nItems;
+
+  if (pitEntry->m_inFaceId != INVALID_FACEID) {
+    auto usage = m_faceUsages.find(pitEntry->m_inFaceId);
+    BOOST_ASSERT(usage != m_faceUsages.end());
+    if (--usage->second == 0) {
+      m_faceUsages.erase(usage);
+    }
+  }
+
+  pit::Entry* prev = pitEntry->m_prevInserted;
+  pit::Entry* next = pitEntry->m_nextInserted;
+  (prev == nullptr ? m_oldest : prev->m_nextInserted) = next;
+  (next == nullptr ? m_newest : next->m_prevInserted) = prev;
+  pitEntry->m_prevInserted = pitEntry->m_nextInserted = nullptr;
+}
+
+void
+Pit::setLimit(size_t nMaxEntries)
+{
+  m_limit = nMaxEntries;
+}
+
+void
+Pit::setOverloadPolicy(pit::OverloadPolicy policy)
+{
+  m_overloadPolicy = policy;
+}
+
+void
+Pit::setFaceQuota(size_t nMaxEntriesPerFace)
+{
+  m_faceQuota = nMaxEntriesPerFace;
+}
+
+size_t
+Pit::getFaceUsage(FaceId faceId) const
+{
+  auto usage = m_faceUsages.find(faceId);
+  return usage == m_faceUsages.end() ? 0 : usage->second;
+}
+
+bool
+Pit::canAdmit(FaceId inFaceId) const
+{
+  if (m_nItems >= m_limit) {
+    return false;
+  }
+
+  return inFaceId == INVALID_FACEID ||
+         m_faceQuota == std::numeric_limits<size_t>::max() ||
+         this->getFaceUsage(inFaceId) < m_faceQuota;
+}
+
+bool
+Pit::makeRoom(FaceId inFaceId)
+{
+  if (inFaceId != INVALID_FACEID && this->getFaceUsage(inFaceId) >= m_faceQuota) {
+    return false;
+  }
+
+  if (m_nItems < m_limit) {
+    return true;
+  }
+
+  if (m_overloadPolicy == pit::OVERLOAD_REJECT) {
+    return false;
+  }
+
+  // usually one eviction suffices, unless the limit has been lowered
+  while (m_nItems >= m_limit) {
+    shared_ptr<pit::Entry> victim = this->pickVictim();
+    if (victim == nullptr) {
+      // limit is zero
+      return false;
+    }
+
+    ++m_nEvicted;
+    this->emitSignal(beforeEvict, victim);
+    if (victim->m_nameTreeEntry != nullptr) {
+      this->erase(victim);
+    }
+  }
+
+  return true;
+}
+
+shared_ptr<pit::Entry>
+Pit::pickVictim() const
+{
+  pit::Entry* victim = nullptr;
+  if (m_overloadPolicy == pit::OVERLOAD_EVICT_SOONEST_EXPIRING) {
+    victim = m_timerWheel.findSoonest();
+  }
+  if (victim == nullptr) {
+    // no timer is armed, fall back to insertion order
+    victim = m_oldest;
+  }
+
+  return victim == nullptr ? nullptr : victim->shared_from_this();
+}
+
+void
+Pit::setExpiryTimer(pit::Entry& pitEntry, const time::nanoseconds& after)
+{
+  m_timerWheel.arm(pitEntry, after);
+}
+
+void
+Pit::cancelExpiryTimer(pit::Entry& pitEntry)
+{
+  m_timerWheel.cancel(pitEntry);
+}
+
+void
+Pit::expire(const shared_ptr<pit::Entry>& pitEntry)
+{
+  this->emitSignal(onExpire, pitEntry);
 }
 
 Pit::const_iterator
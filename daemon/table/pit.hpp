@@ -28,6 +28,8 @@
 
 #include "name-tree.hpp"
 #include "pit-entry.hpp"
+#include "pit-timer-wheel.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 namespace pit {
@@ -38,8 +40,26 @@ namespace pit {
  *  This type shall support:
  *    iterator<shared_ptr<pit::Entry>> begin()
  *    iterator<shared_ptr<pit::Entry>> end()
+ *
+ *  A Data packet rarely matches more than a few PIT entries,
+ *  so matches are kept inline and the common case does not allocate.
+ */
+typedef SmallVector<shared_ptr<pit::Entry>, 4> DataMatchResult;
+
+/** \brief indicates what Pit::insert does when PIT is full
+ */
+enum OverloadPolicy {
+  /// reject the new entry
+  OVERLOAD_REJECT,
+  /// evict the entry that was inserted earliest
+  OVERLOAD_EVICT_OLDEST,
+  /// evict the entry whose expiry timer fires soonest
+  OVERLOAD_EVICT_SOONEST_EXPIRING
+};
+
+/** \brief maps FaceId to the number of PIT entries created by Interests from that face
  */
-typedef std::vector<shared_ptr<pit::Entry>> DataMatchResult;
+typedef std::unordered_map<FaceId, size_t> FaceUsageMap;
 
 } // namespace pit
 
@@ -61,10 +81,20 @@ public:
   /** \brief inserts a PIT entry for Interest
    *
    *  If an entry for exact same name and selectors exists, that entry is returned.
-   *  \return the entry, and true for new entry, false for existing entry
+   *  Otherwise, a new entry must be admitted by the capacity limit and the face quota.
+   *  \param inFaceId face from which the Interest is received;
+   *                  INVALID_FACEID is not subject to face quota
+   *  \return the entry, and true for new entry, false for existing entry;
+   *          or nullptr and false if a new entry is not admitted
    */
   std::pair<shared_ptr<pit::Entry>, bool>
-  insert(const Interest& interest);
+  insert(const Interest& interest, FaceId inFaceId = INVALID_FACEID);
+
+  /** \brief inserts a PIT entry for Interest, using precomputed hashes
+   *  \param hashes must be computed from Interest Name
+   */
+  std::pair<shared_ptr<pit::Entry>, bool>
+  insert(const Interest& interest, FaceId inFaceId, const name_tree::HashContext& hashes);
 
   /** \brief performs a Data match
    *  \return an iterable of all PIT entries matching data
@@ -72,6 +102,12 @@ public:
   pit::DataMatchResult
   findAllDataMatches(const Data& data) const;
 
+  /** \brief performs a Data match, using precomputed hashes
+   *  \param hashes must be computed from Data Name
+   */
+  pit::DataMatchResult
+  findAllDataMatches(const Data& data, const name_tree::HashContext& hashes) const;
+
   /** \brief performs a Data match
    *  \return an iterable of all PIT entries matching data
    */
@@ -84,6 +120,88 @@ public:
   void
   erase(shared_ptr<pit::Entry> pitEntry);
 
+public: // expiry timer
+  /** \brief arms the expiry timer of \p pitEntry to fire after \p after
+   *
+   *  Each entry has one expiry timer, which serves as either the unsatisfy timer
+   *  or the straggler timer. Arming it replaces a previously armed timer.
+   *  The timer is disarmed when the entry is erased.
+   */
+  void
+  setExpiryTimer(pit::Entry& pitEntry, const time::nanoseconds& after);
+
+  /** \brief disarms the expiry timer of \p pitEntry
+   */
+  void
+  cancelExpiryTimer(pit::Entry& pitEntry);
+
+  /** \brief signals when the expiry timer of a PIT entry fires
+   *
+   *  Entries expire in batches: all entries due on a tick are emitted together.
+   */
+  signal::Signal<Pit, shared_ptr<pit::Entry>> onExpire;
+
+public: // admission control
+  /** \brief changes capacity (in number of entries)
+   *
+   *  If PIT has more entries than the new capacity, no entry is erased immediately.
+   *  Subsequent insertions evict or are rejected according to overload policy.
+   */
+  void
+  setLimit(size_t nMaxEntries);
+
+  /** \return capacity (in number of entries)
+   */
+  size_t
+  getLimit() const;
+
+  /** \brief changes what happens to a new entry when PIT is full
+   */
+  void
+  setOverloadPolicy(pit::OverloadPolicy policy);
+
+  pit::OverloadPolicy
+  getOverloadPolicy() const;
+
+  /** \brief changes the maximum number of entries created by Interests from each face
+   *
+   *  A new entry is rejected if its incoming face has reached the quota.
+   *  Entries are never evicted to make room for a face over its quota.
+   */
+  void
+  setFaceQuota(size_t nMaxEntriesPerFace);
+
+  size_t
+  getFaceQuota() const;
+
+  /** \return number of entries created by Interests from \p faceId
+   */
+  size_t
+  getFaceUsage(FaceId faceId) const;
+
+  /** \return number of entries created by Interests from each face;
+   *          faces without entries are omitted
+   */
+  const pit::FaceUsageMap&
+  getFaceUsages() const;
+
+  /** \return number of new entries rejected by capacity limit or face quota
+   */
+  uint64_t
+  getNRejected() const;
+
+  /** \return number of entries evicted to make room for new entries
+   */
+  uint64_t
+  getNEvicted() const;
+
+  /** \brief signals before an entry is evicted to make room for a new entry
+   *
+   *  A handler may finalize and erase the entry. Otherwise, the entry is erased
+   *  after the signal returns.
+   */
+  signal::Signal<Pit, shared_ptr<pit::Entry>> beforeEvict;
+
 public: // enumeration
   class const_iterator;
 
@@ -140,9 +258,44 @@ public: // enumeration
     size_t m_iPitEntry;
   };
 
+private:
+  void
+  expire(const shared_ptr<pit::Entry>& pitEntry);
+
+  /** \return true if a new entry from \p inFaceId is within capacity and face quota
+   */
+  bool
+  canAdmit(FaceId inFaceId) const;
+
+  /** \brief evicts an entry if PIT is full and overload policy permits
+   *  \return true if a new entry from \p inFaceId can be admitted afterwards
+   */
+  bool
+  makeRoom(FaceId inFaceId);
+
+  /** \return the entry to evict according to overload policy, or nullptr if PIT is empty
+   */
+  shared_ptr<pit::Entry>
+  pickVictim() const;
+
+  DECLARE_SIGNAL_EMIT(onExpire)
+  DECLARE_SIGNAL_EMIT(beforeEvict)
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  pit::TimerWheel m_timerWheel;
+
+  size_t m_limit;
+  pit::OverloadPolicy m_overloadPolicy;
+  size_t m_faceQuota;
+  pit::FaceUsageMap m_faceUsages;
+  uint64_t m_nRejected;
+  uint64_t m_nEvicted;
+
+  /// entries in insertion order, linked through pit::Entry
+  pit::Entry* m_oldest;
+  pit::Entry* m_newest;
 };
 
 inline size_t
@@ -151,6 +304,42 @@ Pit::size() const
   return m_nItems;
 }
 
+inline size_t
+Pit::getLimit() const
+{
+  return m_limit;
+}
+
+inline pit::OverloadPolicy
+Pit::getOverloadPolicy() const
+{
+  return m_overloadPolicy;
+}
+
+inline size_t
+Pit::getFaceQuota() const
+{
+  return m_faceQuota;
+}
+
+inline const pit::FaceUsageMap&
+Pit::getFaceUsages() const
+{
+  return m_faceUsages;
+}
+
+inline uint64_t
+Pit::getNRejected() const
+{
+  return m_nRejected;
+}
+
+inline uint64_t
+Pit::getNEvicted() const
+{
+  return m_nEvicted;
+}
+
 inline Pit::const_iterator
 Pit::end() const
 {
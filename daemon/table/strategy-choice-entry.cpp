@@ -26,16 +26,31 @@
 #include "strategy-choice-entry.hpp"
 #include "core/logger.hpp"
 #include "fw/strategy.hpp"
+#include "name-tree-entry.hpp"
 
 namespace nfd {
 namespace strategy_choice {
 
+Entry::Entry()
+  : m_strategy(nullptr)
+{
+}
+
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
   , m_strategy(nullptr)
 {
 }
 
+Name
+Entry::getPrefix() const
+{
+  if (m_nameTreeEntry != nullptr) {
+    return m_nameTreeEntry->getPrefix();
+  }
+  return m_prefix;
+}
+
 const Name&
 Entry::getStrategyName() const
 {
@@ -45,9 +45,17 @@ namespace strategy_choice {
 class Entry : noncopyable
 {
 public:
+  /** \brief constructs an entry whose prefix is read from the NameTree entry it is attached to
+   */
+  Entry();
+
   Entry(const Name& prefix);
 
-  const Name&
+  /** \return Name prefix of this entry
+   *
+   *  While the entry is attached to NameTree, the prefix is obtained from the NameTree entry.
+   */
+  Name
   getPrefix() const;
 
   const Name&
@@ -60,7 +68,7 @@ public:
   setStrategy(fw::Strategy& strategy);
 
 private:
-  Name m_prefix;
+  Name m_prefix; // empty while attached to NameTree
   fw::Strategy* m_strategy;
 
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
@@ -69,12 +77,6 @@ private:
 };
 
 
-inline const Name&
-Entry::getPrefix() const
-{
-  return m_prefix;
-}
-
 inline fw::Strategy&
 Entry::getStrategy() const
 {
@@ -36,9 +36,21 @@ using fw::Strategy;
 
 NFD_LOG_INIT("StrategyChoice");
 
+static uint32_t
+allocateGeneration()
+{
+  static uint32_t lastGeneration = 0;
+  if (++lastGeneration == 0) {
+    // 0 is the generation of a NameTree entry that has never been cached
+    ++lastGeneration;
+  }
+  return lastGeneration;
+}
+
 StrategyChoice::StrategyChoice(NameTree& nameTree, shared_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_generation(allocateGeneration())
 {
   this->setDefaultStrategy(defaultStrategy);
 }
@@ -110,7 +122,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   if (!static_cast<bool>(entry)) {
     oldStrategy = &this->findEffectiveStrategy(prefix);
-    entry = make_shared<Entry>(prefix);
+    entry = make_shared<Entry>();
     nte->setStrategyChoiceEntry(entry);
     ++m_nItems;
     NFD_LOG_TRACE("insert(" << prefix << ") new entry " << strategy->getName());
@@ -165,47 +177,47 @@ StrategyChoice::get(const Name& prefix) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(prefix,
-    [] (const name_tree::Entry& entry) {
-      return static_cast<bool>(entry.getStrategyChoiceEntry());
-    });
-
-  BOOST_ASSERT(static_cast<bool>(nte));
-  return nte->getStrategyChoiceEntry()->getStrategy();
-}
-
-Strategy&
-StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
-{
-  shared_ptr<strategy_choice::Entry> entry = nte->getStrategyChoiceEntry();
-  if (static_cast<bool>(entry))
-    return entry->getStrategy();
-
-  nte = m_nameTree.findLongestPrefixMatch(nte,
-    [] (const name_tree::Entry& entry) {
-      return static_cast<bool>(entry.getStrategyChoiceEntry());
-    });
-
-  BOOST_ASSERT(static_cast<bool>(nte));
-  return nte->getStrategyChoiceEntry()->getStrategy();
+  return this->findEffectiveStrategy(prefix, name_tree::HashContext(prefix));
 }
 
 Strategy&
-StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
+StrategyChoice::findEffectiveStrategy(const Name& prefix,
+                                      const name_tree::HashContext& hashes) const
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.get(pitEntry);
+  // the longest existing NameTree entry has the same effective strategy as prefix,
+  // because every StrategyChoice entry is attached to a NameTree entry
+  shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(prefix, hashes);
 
   BOOST_ASSERT(static_cast<bool>(nte));
-  return this->findEffectiveStrategy(nte);
+  return this->findEffectiveStrategy(*nte);
 }
 
 Strategy&
-StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
+StrategyChoice::computeEffectiveStrategy(const name_tree::Entry& nte) const
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.get(measurementsEntry);
+  // walk up until an entry with valid cache or a StrategyChoice entry
+  std::vector<const name_tree::Entry*> path;
+  const name_tree::Entry* current = &nte;
+  Strategy* strategy = nullptr;
+  while (true) {
+    BOOST_ASSERT(current != nullptr);
+    if (current->m_strategyGeneration == m_generation) {
+      strategy = current->m_effectiveStrategy;
+      break;
+    }
+    path.push_back(current);
+    if (static_cast<bool>(current->m_strategyChoiceEntry)) {
+      strategy = &current->m_strategyChoiceEntry->getStrategy();
+      break;
+    }
+    current = current->m_parent.get();
+  }
 
-  BOOST_ASSERT(static_cast<bool>(nte));
-  return this->findEffectiveStrategy(nte);
+  for (const name_tree::Entry* entry : path) {
+    entry->m_effectiveStrategy = strategy;
+    entry->m_strategyGeneration = m_generation;
+  }
+  return *strategy;
 }
 
 void
@@ -216,7 +228,7 @@ StrategyChoice::setDefaultStrategy(shared_ptr<Strategy> strategy)
   // don't use .insert here, because it will invoke findEffectiveStrategy
   // which expects an existing root entry
   shared_ptr<name_tree::Entry> nte = m_nameTree.lookup(Name());
-  shared_ptr<Entry> entry = make_shared<Entry>(Name());
+  shared_ptr<Entry> entry = make_shared<Entry>();
   nte->setStrategyChoiceEntry(entry);
   ++m_nItems;
   NFD_LOG_INFO("setDefaultStrategy " << strategy->getName());
@@ -256,7 +268,7 @@ StrategyChoice::changeStrategy(strategy_choice::Entry& entry,
                << " from " << oldStrategy.getName()
                << " to " << newStrategy.getName());
 
-  // reset StrategyInfo on a portion of NameTree,
+  // reset StrategyInfo and cached effective strategy on a portion of NameTree,
   // where entry's effective strategy is covered by the changing StrategyChoice entry
   const name_tree::Entry* rootNte = m_nameTree.get(entry).get();
   auto&& ntChanged = m_nameTree.partialEnumerate(entry.getPrefix(),
@@ -271,6 +283,7 @@ StrategyChoice::changeStrategy(strategy_choice::Entry& entry,
     });
   for (const name_tree::Entry& nte : ntChanged) {
     clearStrategyInfo(nte);
+    nte.m_strategyGeneration = 0;
   }
 }
 
@@ -89,10 +89,22 @@ public: // Strategy Choice table
   get(const Name& prefix) const;
 
 public: // effective strategy
-  /// get effective strategy for prefix
+  /** \brief get effective strategy for prefix
+   *
+   *  The effective strategy of every NameTree entry is cached on that entry.
+   *  A cached value is valid when it carries the generation of this table;
+   *  insert and erase invalidate the cache only within the affected subtree,
+   *  so that a lookup on a valid entry costs one load and one compare.
+   */
   fw::Strategy&
   findEffectiveStrategy(const Name& prefix) const;
 
+  /** \brief get effective strategy for prefix, using precomputed hashes
+   *  \param hashes must be computed from \p prefix
+   */
+  fw::Strategy&
+  findEffectiveStrategy(const Name& prefix, const name_tree::HashContext& hashes) const;
+
   /// get effective strategy for pitEntry
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
@@ -160,12 +172,25 @@ private:
                  fw::Strategy& newStrategy);
 
   fw::Strategy&
-  findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const;
+  findEffectiveStrategy(const name_tree::Entry& nte) const;
+
+  /** \brief determine effective strategy of \p nte, and cache it on \p nte
+   *         and on its ancestors whose cached value is invalid
+   */
+  fw::Strategy&
+  computeEffectiveStrategy(const name_tree::Entry& nte) const;
 
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief identifies cached effective strategy written by this table
+   *
+   *  Each StrategyChoice instance has a distinct nonzero generation,
+   *  so that a cached value written by another instance is never trusted.
+   */
+  uint32_t m_generation;
+
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
 };
@@ -176,6 +201,33 @@ StrategyChoice::size() const
   return m_nItems;
 }
 
+inline fw::Strategy&
+StrategyChoice::findEffectiveStrategy(const name_tree::Entry& nte) const
+{
+  if (nte.m_strategyGeneration == m_generation) {
+    return *nte.m_effectiveStrategy;
+  }
+  return this->computeEffectiveStrategy(nte);
+}
+
+inline fw::Strategy&
+StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
+{
+  const shared_ptr<name_tree::Entry>& nte = m_nameTree.get(pitEntry);
+
+  BOOST_ASSERT(static_cast<bool>(nte));
+  return this->findEffectiveStrategy(*nte);
+}
+
+inline fw::Strategy&
+StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
+{
+  const shared_ptr<name_tree::Entry>& nte = m_nameTree.get(measurementsEntry);
+
+  BOOST_ASSERT(static_cast<bool>(nte));
+  return this->findEffectiveStrategy(*nte);
+}
+
 inline StrategyChoice::const_iterator
 StrategyChoice::end() const
 {
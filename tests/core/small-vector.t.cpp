@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/small-vector.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestSmallVector, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(InlineAndSpill)
+{
+  SmallVector<shared_ptr<int>, 2> vec;
+  BOOST_CHECK(vec.empty());
+  BOOST_CHECK(vec.isInline());
+
+  shared_ptr<int> item = make_shared<int>(0);
+  vec.push_back(item);
+  vec.push_back(make_shared<int>(1));
+  BOOST_CHECK_EQUAL(vec.size(), 2);
+  BOOST_CHECK(vec.isInline());
+  BOOST_CHECK_EQUAL(item.use_count(), 2);
+
+  // grow beyond inline capacity, passing an existing element
+  vec.push_back(vec[0]);
+  BOOST_CHECK_EQUAL(vec.size(), 3);
+  BOOST_CHECK(!vec.isInline());
+  BOOST_CHECK_GE(vec.capacity(), 3);
+  BOOST_CHECK_EQUAL(vec[2], item);
+  BOOST_CHECK_EQUAL(*vec[1], 1);
+  BOOST_CHECK_EQUAL(item.use_count(), 3);
+
+  int sum = 0;
+  for (const shared_ptr<int>& p : vec) {
+    sum += *p;
+  }
+  BOOST_CHECK_EQUAL(sum, 1);
+
+  vec.pop_back();
+  BOOST_CHECK_EQUAL(item.use_count(), 2);
+  vec.clear();
+  BOOST_CHECK(vec.empty());
+  BOOST_CHECK_EQUAL(item.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(CopyMove)
+{
+  shared_ptr<int> item = make_shared<int>(7);
+
+  SmallVector<shared_ptr<int>, 2> small;
+  small.push_back(item);
+
+  SmallVector<shared_ptr<int>, 2> large;
+  for (int i = 0; i < 5; ++i) {
+    large.push_back(item);
+  }
+  BOOST_CHECK_EQUAL(item.use_count(), 7);
+
+  SmallVector<shared_ptr<int>, 2> smallCopy(small);
+  BOOST_CHECK_EQUAL(smallCopy.size(), 1);
+  BOOST_CHECK_EQUAL(item.use_count(), 8);
+
+  SmallVector<shared_ptr<int>, 2> smallMoved(std::move(small));
+  BOOST_CHECK_EQUAL(smallMoved.size(), 1);
+  BOOST_CHECK(small.empty());
+  BOOST_CHECK_EQUAL(item.use_count(), 8);
+
+  const shared_ptr<int>* largeData = large.begin();
+  SmallVector<shared_ptr<int>, 2> largeMoved(std::move(large));
+  BOOST_CHECK_EQUAL(largeMoved.size(), 5);
+  BOOST_CHECK(largeMoved.begin() == largeData); // heap buffer is taken over
+  BOOST_CHECK(large.empty());
+  BOOST_CHECK(large.isInline());
+  BOOST_CHECK_EQUAL(item.use_count(), 8);
+
+  smallCopy = largeMoved;
+  BOOST_CHECK_EQUAL(smallCopy.size(), 5);
+  BOOST_CHECK_EQUAL(item.use_count(), 12);
+
+  largeMoved = std::move(smallMoved);
+  BOOST_CHECK_EQUAL(largeMoved.size(), 1);
+  BOOST_CHECK_EQUAL(item.use_count(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  shared_ptr<int> item = make_shared<int>(7);
+  SmallVector<shared_ptr<int>, 2> vec;
+  for (int i = 0; i < 4; ++i) {
+    vec.push_back(make_shared<int>(i));
+  }
+  vec[2] = item;
+
+  SmallVector<shared_ptr<int>, 2>::iterator it = vec.erase(vec.begin() + 1);
+  BOOST_CHECK_EQUAL(vec.size(), 3);
+  BOOST_CHECK(it == vec.begin() + 1);
+  BOOST_CHECK_EQUAL(*vec[0], 0);
+  BOOST_CHECK_EQUAL(*vec[1], 7);
+  BOOST_CHECK_EQUAL(*vec[2], 3);
+  BOOST_CHECK_EQUAL(item.use_count(), 2);
+
+  it = vec.erase(vec.end() - 1);
+  BOOST_CHECK(it == vec.end());
+  vec.erase(vec.begin() + 1);
+  BOOST_CHECK_EQUAL(vec.size(), 1);
+  BOOST_CHECK_EQUAL(item.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
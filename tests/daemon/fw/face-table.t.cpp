@@ -146,6 +146,79 @@ BOOST_AUTO_TEST_CASE(Enumerate)
   BOOST_CHECK(hasFace2);
 }
 
+BOOST_AUTO_TEST_CASE(ReuseSlot)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+  shared_ptr<Face> face3 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  faceTable.add(face2);
+  BOOST_CHECK_EQUAL(face1->getId(), FACEID_RESERVED_MAX + 1);
+  FaceId oldId1 = face1->getId();
+  BOOST_CHECK_EQUAL(faceTable.get(oldId1), face1);
+
+  face1->close();
+  BOOST_CHECK(faceTable.get(oldId1) == nullptr);
+
+  BOOST_CHECK_EQUAL(face2->getId(), FACEID_RESERVED_MAX + 2);
+
+  // face3 takes the slot of face1, with a FaceId that differs from any previous FaceId:
+  // the slot index is kept in low bits, and the generation is in high bits
+  faceTable.add(face3);
+  BOOST_CHECK_NE(face3->getId(), oldId1);
+  BOOST_CHECK_EQUAL(face3->getId(), (1 << 23) + FACEID_RESERVED_MAX + 1);
+  BOOST_CHECK_NE(face3->getId(), face2->getId());
+  BOOST_CHECK(faceTable.get(oldId1) == nullptr);
+  BOOST_CHECK_EQUAL(faceTable.get(face3->getId()), face3);
+  BOOST_CHECK_EQUAL(faceTable.get(face2->getId()), face2);
+  BOOST_CHECK(faceTable.find(oldId1) == nullptr);
+  BOOST_CHECK_EQUAL(faceTable.find(face3->getId()), face3.get());
+  BOOST_CHECK_EQUAL(faceTable.size(), 2);
+
+  // enumeration is in slot order
+  std::vector<FaceId> ids;
+  for (const shared_ptr<Face>& face : faceTable) {
+    ids.push_back(face->getId());
+  }
+  BOOST_REQUIRE_EQUAL(ids.size(), 2);
+  BOOST_CHECK_EQUAL(ids[0], face3->getId());
+  BOOST_CHECK_EQUAL(ids[1], face2->getId());
+
+  BOOST_CHECK(faceTable.get(INVALID_FACEID) == nullptr);
+  BOOST_CHECK(faceTable.get(1000000) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(DenseFaceIds)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 300; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    faceTable.add(faces.back());
+    BOOST_CHECK_EQUAL(faces.back()->getId(), FACEID_RESERVED_MAX + 1 + i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RetireSlot)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+
+  std::set<FaceId> usedIds;
+  for (int i = 0; i < 600; ++i) {
+    shared_ptr<Face> face = make_shared<DummyFace>();
+    faceTable.add(face);
+    BOOST_CHECK(usedIds.insert(face->getId()).second);
+    face->close();
+  }
+  BOOST_CHECK_EQUAL(faceTable.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -121,6 +121,58 @@ BOOST_AUTO_TEST_CASE(CsMatched)
   BOOST_CHECK_EQUAL(pit.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CsMatchedSharded)
+{
+  LimitedIo limitedIo;
+  auto afterOp = bind(&LimitedIo::afterOp, &limitedIo);
+  Forwarder forwarder;
+  forwarder.getCs().setLimit(40);
+  forwarder.setCsShards(4);
+  ShardedCs* shardedCs = forwarder.getShardedCs();
+  BOOST_REQUIRE(shardedCs != nullptr);
+  BOOST_CHECK_EQUAL(shardedCs->getLimit(), 40);
+
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  face1->afterSend.connect(afterOp);
+  face2->afterSend.connect(afterOp);
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  Fib& fib = forwarder.getFib();
+  shared_ptr<fib::Entry> fibEntry = fib.insert(Name("ndn:/A")).first;
+  fibEntry->addNextHop(face2, 0);
+
+  shared_ptr<Interest> interest1 = makeInterest("ndn:/A/B");
+  interest1->setInterestLifetime(time::seconds(4));
+  shared_ptr<Data> dataAB = makeData("ndn:/A/B");
+
+  g_io.post([&] { face1->receiveInterest(*interest1); });
+  BOOST_CHECK_EQUAL(limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(face2->m_sentInterests.size(), 1);
+
+  g_io.post([&] { face2->receiveData(*dataAB); });
+  BOOST_CHECK_EQUAL(limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(face1->m_sentDatas.size(), 1);
+
+  // Data is cached in its shard, not in the unsharded CS
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 0);
+  BOOST_CHECK_EQUAL(shardedCs->size(), 1);
+  BOOST_CHECK_EQUAL(shardedCs->getShard(shardedCs->getShardIndex(dataAB->getName())).size(), 1);
+
+  limitedIo.run(LimitedIo::UNLIMITED_OPS, time::milliseconds(500));
+
+  shared_ptr<Interest> interest2 = makeInterest("ndn:/A/B");
+  interest2->setInterestLifetime(time::seconds(4));
+  face1->receiveInterest(*interest2);
+  limitedIo.run(LimitedIo::UNLIMITED_OPS, time::milliseconds(5));
+  // Interest matching the sharded ContentStore should not be forwarded
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), 1);
+  BOOST_REQUIRE_EQUAL(face1->m_sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(face1->m_sentDatas[1].getIncomingFaceId(), FACEID_CONTENT_STORE);
+  BOOST_CHECK_EQUAL(shardedCs->getNHits(), 1);
+}
+
 class ScopeLocalhostIncomingTestForwarder : public Forwarder
 {
 public:
@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/load-balancer-strategy.hpp"
+#include "strategy-tester.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+typedef StrategyTester<fw::LoadBalancerStrategy> LoadBalancerStrategyTester;
+
+class LoadBalancerStrategyFixture : public UnitTestTimeFixture
+{
+protected:
+  LoadBalancerStrategyFixture()
+    : strategy(make_shared<LoadBalancerStrategyTester>(ref(forwarder)))
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+    , face4(make_shared<DummyFace>())
+  {
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+    forwarder.addFace(face3);
+    forwarder.addFace(face4);
+
+    StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+    strategyChoice.install(strategy);
+    strategyChoice.insert(Name(), strategy->getName());
+
+    fibEntry = forwarder.getFib().insert("ndn:/P").first;
+  }
+
+  /** \brief let strategy process a new Interest from face4
+   *  \return upstream face, or nullptr if the Interest is not forwarded
+   */
+  shared_ptr<Face>
+  forward(const Name& name)
+  {
+    shared_ptr<Interest> interest = makeInterest(name);
+    shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(face4, *interest);
+
+    size_t nSent = strategy->m_sendInterestHistory.size();
+    strategy->afterReceiveInterest(*face4, *interest, fibEntry, pitEntry);
+    if (strategy->m_sendInterestHistory.size() == nSent) {
+      return nullptr;
+    }
+    return strategy->m_sendInterestHistory.back().get<1>();
+  }
+
+  /** \brief forward the first segment of \p nObjects objects
+   *  \return number of objects forwarded to each upstream
+   */
+  std::map<shared_ptr<Face>, int>
+  distribute(int nObjects)
+  {
+    std::map<shared_ptr<Face>, int> counts;
+    for (int i = 0; i < nObjects; ++i) {
+      ++counts[this->forward(Name("ndn:/P").appendNumber(i).appendSegment(0))];
+    }
+    return counts;
+  }
+
+protected:
+  Forwarder forwarder;
+  shared_ptr<LoadBalancerStrategyTester> strategy;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+  shared_ptr<DummyFace> face4;
+  shared_ptr<fib::Entry> fibEntry;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwLoadBalancerStrategy, LoadBalancerStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(Affinity)
+{
+  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(face3, 10);
+
+  std::map<shared_ptr<Face>, int> counts;
+  for (int i = 0; i < 300; ++i) {
+    Name object = Name("ndn:/P").appendNumber(i);
+    shared_ptr<Face> upstream = this->forward(Name(object).appendSegment(0));
+    BOOST_REQUIRE(upstream != nullptr);
+    ++counts[upstream];
+
+    // every segment of an object goes to the same upstream
+    for (int seg = 1; seg < 4; ++seg) {
+      BOOST_CHECK_EQUAL(this->forward(Name(object).appendSegment(seg)), upstream);
+    }
+  }
+
+  // objects are spread across upstreams
+  BOOST_CHECK_GT(counts[face1], 50);
+  BOOST_CHECK_GT(counts[face2], 50);
+  BOOST_CHECK_GT(counts[face3], 50);
+}
+
+BOOST_AUTO_TEST_CASE(HashPrefixLength)
+{
+  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(face3, 10);
+
+  strategy->setHashPrefixLength(1);
+  BOOST_CHECK_EQUAL(strategy->getHashPrefixLength(), 1);
+
+  std::map<shared_ptr<Face>, int> counts = this->distribute(50);
+  BOOST_CHECK_EQUAL(counts.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveNextHop)
+{
+  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(face3, 10);
+
+  std::vector<shared_ptr<Face>> before;
+  for (int i = 0; i < 100; ++i) {
+    before.push_back(this->forward(Name("ndn:/P").appendNumber(i).appendSegment(0)));
+  }
+
+  fibEntry->removeNextHop(face3);
+
+  // only objects on the removed upstream are moved
+  for (int i = 0; i < 100; ++i) {
+    shared_ptr<Face> after = this->forward(Name("ndn:/P").appendNumber(i).appendSegment(1));
+    if (before[i] != face3) {
+      BOOST_CHECK_EQUAL(after, before[i]);
+    }
+    else {
+      BOOST_CHECK(after == face1 || after == face2);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LowestCost)
+{
+  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(face3, 5);
+
+  std::map<shared_ptr<Face>, int> counts = this->distribute(50);
+  BOOST_CHECK_EQUAL(counts[face3], 50);
+
+  fibEntry->removeNextHop(face3);
+  counts = this->distribute(100);
+  BOOST_CHECK_EQUAL(counts.size(), 2);
+  BOOST_CHECK_GT(counts[face1], 0);
+  BOOST_CHECK_GT(counts[face2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(NoNextHop)
+{
+  fibEntry->addNextHop(face4, 10);
+
+  BOOST_CHECK(this->forward("ndn:/P/A") == nullptr);
+  BOOST_CHECK_EQUAL(strategy->m_rejectPendingInterestHistory.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(NoRoute)
+{
+  shared_ptr<Interest> interest = makeInterest("ndn:/Q/A");
+  shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(face4, *interest);
+
+  // nothing matches, so this is the empty entry, which is not in NameTree
+  shared_ptr<fib::Entry> noRoute = forwarder.getFib().findLongestPrefixMatch("ndn:/Q/A");
+  BOOST_REQUIRE(noRoute->getNextHops().empty());
+
+  strategy->afterReceiveInterest(*face4, *interest, noRoute, pitEntry);
+  BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory.size(), 0);
+  BOOST_CHECK_EQUAL(strategy->m_rejectPendingInterestHistory.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RttWeight)
+{
+  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(face3, 10);
+
+  shared_ptr<LoadBalancerStrategy::MtInfo> mi = forwarder.getMeasurements().get(*fibEntry)
+    ->getOrCreateStrategyInfo<LoadBalancerStrategy::MtInfo>();
+  mi->addRtt(face1->getId(), time::milliseconds(10));
+  mi->addRtt(face2->getId(), time::milliseconds(10));
+  mi->addRtt(face3->getId(), time::milliseconds(200));
+
+  std::map<shared_ptr<Face>, int> counts = this->distribute(400);
+  BOOST_CHECK_LT(counts[face3] * 3, counts[face1]);
+  BOOST_CHECK_LT(counts[face3] * 3, counts[face2]);
+}
+
+BOOST_AUTO_TEST_CASE(MeasureRtt)
+{
+  fibEntry->addNextHop(face1, 10);
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/P/A/%00");
+  shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(face4, *interest);
+  strategy->afterReceiveInterest(*face4, *interest, fibEntry, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy->m_sendInterestHistory.size(), 1);
+
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(50));
+  shared_ptr<Data> data = makeData("ndn:/P/A/%00");
+  strategy->beforeSatisfyInterest(pitEntry, *face1, *data);
+
+  shared_ptr<LoadBalancerStrategy::MtInfo> mi = forwarder.getMeasurements().get(*fibEntry)
+    ->getStrategyInfo<LoadBalancerStrategy::MtInfo>();
+  BOOST_REQUIRE(mi != nullptr);
+  BOOST_CHECK_CLOSE(mi->getSrtt(face1->getId()), 50000.0, 1.0);
+  BOOST_CHECK_EQUAL(mi->getSrtt(face2->getId()), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(Retransmit)
+{
+  fibEntry->addNextHop(face1, 10);
+  fibEntry->addNextHop(face2, 10);
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/P/A/%00");
+  shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(face4, *interest);
+  strategy->afterReceiveInterest(*face4, *interest, fibEntry, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy->m_sendInterestHistory.size(), 1);
+  shared_ptr<Face> first = strategy->m_sendInterestHistory.back().get<1>();
+
+  // retransmission within suppression interval is suppressed
+  strategy->afterReceiveInterest(*face4, *interest, fibEntry, pitEntry);
+  BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory.size(), 1);
+
+  // retransmission goes to the other upstream
+  this->advanceClocks(time::milliseconds(10), RetxSuppressionExponential::DEFAULT_MAX_INTERVAL);
+  strategy->afterReceiveInterest(*face4, *interest, fibEntry, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy->m_sendInterestHistory.size(), 2);
+  BOOST_CHECK(strategy->m_sendInterestHistory.back().get<1>() != first);
+
+  // all upstreams have been used, start over with the highest ranked upstream
+  this->advanceClocks(time::milliseconds(10), RetxSuppressionExponential::DEFAULT_MAX_INTERVAL);
+  strategy->afterReceiveInterest(*face4, *interest, fibEntry, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy->m_sendInterestHistory.size(), 3);
+  BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory.back().get<1>(), first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -24,6 +24,7 @@
  */
 
 #include "fw/ncc-strategy.hpp"
+#include "fw/ncc-wheel-strategy.hpp"
 #include "strategy-tester.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
 #include "tests/limited-io.hpp"
@@ -38,15 +39,18 @@ using namespace nfd::tests;
 
 BOOST_FIXTURE_TEST_SUITE(FwNccStrategy, UnitTestTimeFixture)
 
+// NccWheelStrategy must behave the same as NccStrategy
+typedef boost::mpl::list<fw::NccStrategy, fw::NccWheelStrategy> NccStrategies;
+
 // NccStrategy is fairly complex.
 // The most important property is:
 // it remembers which upstream is the fastest to return Data,
 // and favors this upstream in subsequent Interests.
-BOOST_AUTO_TEST_CASE(FavorRespondingUpstream)
+BOOST_AUTO_TEST_CASE_TEMPLATE(FavorRespondingUpstream, S, NccStrategies)
 {
   LimitedIo limitedIo(this);
   Forwarder forwarder;
-  typedef StrategyTester<fw::NccStrategy> NccStrategyTester;
+  typedef StrategyTester<S> NccStrategyTester;
   shared_ptr<NccStrategyTester> strategy = make_shared<NccStrategyTester>(ref(forwarder));
   strategy->onAction.connect(bind(&LimitedIo::afterOp, &limitedIo));
 
@@ -108,10 +112,10 @@ BOOST_AUTO_TEST_CASE(FavorRespondingUpstream)
   BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory[2].get<1>(), face2);
 }
 
-BOOST_AUTO_TEST_CASE(Bug1853)
+BOOST_AUTO_TEST_CASE_TEMPLATE(Bug1853, S, NccStrategies)
 {
   Forwarder forwarder;
-  typedef StrategyTester<fw::NccStrategy> NccStrategyTester;
+  typedef StrategyTester<S> NccStrategyTester;
   shared_ptr<NccStrategyTester> strategy = make_shared<NccStrategyTester>(ref(forwarder));
 
   shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
@@ -162,11 +166,11 @@ BOOST_AUTO_TEST_CASE(Bug1853)
   this->advanceClocks(time::milliseconds(10), time::milliseconds(1000));// should not crash
 }
 
-BOOST_AUTO_TEST_CASE(Bug1961)
+BOOST_AUTO_TEST_CASE_TEMPLATE(Bug1961, S, NccStrategies)
 {
   LimitedIo limitedIo(this);
   Forwarder forwarder;
-  typedef StrategyTester<fw::NccStrategy> NccStrategyTester;
+  typedef StrategyTester<S> NccStrategyTester;
   shared_ptr<NccStrategyTester> strategy = make_shared<NccStrategyTester>(ref(forwarder));
   strategy->onAction.connect(bind(&LimitedIo::afterOp, &limitedIo));
 
@@ -224,11 +228,11 @@ BOOST_AUTO_TEST_CASE(Bug1961)
   BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory[2].get<1>(), face1);
 }
 
-BOOST_AUTO_TEST_CASE(Bug1971)
+BOOST_AUTO_TEST_CASE_TEMPLATE(Bug1971, S, NccStrategies)
 {
   LimitedIo limitedIo(this);
   Forwarder forwarder;
-  typedef StrategyTester<fw::NccStrategy> NccStrategyTester;
+  typedef StrategyTester<S> NccStrategyTester;
   shared_ptr<NccStrategyTester> strategy = make_shared<NccStrategyTester>(ref(forwarder));
   strategy->onAction.connect(bind(&LimitedIo::afterOp, &limitedIo));
 
@@ -276,10 +280,10 @@ BOOST_AUTO_TEST_CASE(Bug1971)
   BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory[1].get<1>(), face2);
 }
 
-BOOST_AUTO_TEST_CASE(Bug1998)
+BOOST_AUTO_TEST_CASE_TEMPLATE(Bug1998, S, NccStrategies)
 {
   Forwarder forwarder;
-  typedef StrategyTester<fw::NccStrategy> NccStrategyTester;
+  typedef StrategyTester<S> NccStrategyTester;
   shared_ptr<NccStrategyTester> strategy = make_shared<NccStrategyTester>(ref(forwarder));
 
   shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
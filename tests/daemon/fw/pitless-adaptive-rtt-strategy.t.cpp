@@ -0,0 +1,284 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/pitless-adaptive-rtt-strategy.hpp"
+#include "table/name-tree.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+/** \brief records the upstream of every forwarded Interest
+ */
+class PITlessAdaptiveRttStrategyTester : public PITlessAdaptiveRttStrategy
+{
+public:
+  explicit
+  PITlessAdaptiveRttStrategyTester(Forwarder& forwarder)
+    : PITlessAdaptiveRttStrategy(forwarder)
+  {
+  }
+
+protected:
+  virtual void
+  sendInterestPITless(const Interest& interest, Face& outFace,
+                      bool wantNewNonce = false) DECL_OVERRIDE
+  {
+    m_sendInterestHistory.push_back(outFace.shared_from_this());
+  }
+
+public:
+  std::vector<shared_ptr<Face>> m_sendInterestHistory;
+};
+
+class PITlessAdaptiveRttStrategyFixture : public UnitTestTimeFixture
+{
+protected:
+  PITlessAdaptiveRttStrategyFixture()
+    : strategy(make_shared<PITlessAdaptiveRttStrategyTester>(ref(forwarder)))
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+  {
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+    forwarder.addFace(face3);
+
+    StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+    strategyChoice.install(strategy);
+    strategyChoice.insert(Name(), strategy->getName());
+
+    fibEntry = forwarder.getFib().insert("ndn:/P").first;
+    fibEntry->addNextHop(face1, 10);
+    fibEntry->addNextHop(face2, 20);
+  }
+
+  /** \brief let strategy process an Interest from face3
+   *  \return upstream face, or nullptr if the Interest is not forwarded
+   */
+  shared_ptr<Face>
+  forward(const Name& name,
+          const time::milliseconds& lifetime = time::milliseconds(4000))
+  {
+    shared_ptr<Interest> interest = makeInterest(name);
+    interest->setInterestLifetime(lifetime);
+
+    size_t nSent = strategy->m_sendInterestHistory.size();
+    strategy->afterReceiveInterestPITless(*face3, *interest, fibEntry);
+    if (strategy->m_sendInterestHistory.size() == nSent) {
+      return nullptr;
+    }
+    return strategy->m_sendInterestHistory.back();
+  }
+
+  /** \brief let strategy process a Data from \p upstream
+   */
+  void
+  reply(const Name& name, Face& upstream)
+  {
+    strategy->afterReceiveDataPITless(upstream, *makeData(name));
+  }
+
+  /** \return RTT estimator of \p upstream, or nullptr if \p upstream is not used yet
+   */
+  const RttEstimator*
+  getRtt(const Face& upstream)
+  {
+    shared_ptr<measurements::Entry> me = forwarder.getMeasurements().get(*fibEntry);
+    BOOST_REQUIRE(me != nullptr);
+    shared_ptr<PITlessAdaptiveRttStrategy::MtInfo> mi =
+      me->getStrategyInfo<PITlessAdaptiveRttStrategy::MtInfo>();
+    BOOST_REQUIRE(mi != nullptr);
+
+    auto it = mi->faceStats.find(upstream.getId());
+    if (it == mi->faceStats.end()) {
+      return nullptr;
+    }
+    return &it->second.rtt;
+  }
+
+protected:
+  Forwarder forwarder;
+  shared_ptr<PITlessAdaptiveRttStrategyTester> strategy;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+  shared_ptr<fib::Entry> fibEntry;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwPITlessAdaptiveRttStrategy, PITlessAdaptiveRttStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(TryUnused)
+{
+  // every upstream is tried once before RTT is known
+  BOOST_CHECK_EQUAL(this->forward("ndn:/P/1"), face1);
+  BOOST_CHECK_EQUAL(this->forward("ndn:/P/2"), face2);
+
+  // without samples, upstreams tie, and the first nexthop wins
+  BOOST_CHECK_EQUAL(this->forward("ndn:/P/3"), face1);
+}
+
+BOOST_AUTO_TEST_CASE(NoNextHop)
+{
+  fibEntry->removeNextHop(face1);
+  fibEntry->removeNextHop(face2);
+  fibEntry->addNextHop(face3, 10);
+
+  // downstream is the only nexthop
+  BOOST_CHECK(this->forward("ndn:/P/1") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(NoRoute)
+{
+  // nothing matches, so this is the empty entry, which is not in NameTree
+  shared_ptr<fib::Entry> noRoute = forwarder.getFib().findLongestPrefixMatch("ndn:/Q/A");
+  BOOST_REQUIRE(noRoute->getNextHops().empty());
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/Q/A");
+  strategy->afterReceiveInterestPITless(*face3, *interest, noRoute);
+  BOOST_CHECK_EQUAL(strategy->m_sendInterestHistory.size(), 0);
+
+  // Data without a probe is ignored
+  this->reply("ndn:/Q/A", *face1);
+}
+
+BOOST_AUTO_TEST_CASE(Measure)
+{
+  BOOST_REQUIRE_EQUAL(this->forward("ndn:/P/1"), face1);
+  BOOST_REQUIRE_EQUAL(this->forward("ndn:/P/2"), face2);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(10));
+
+  // Data from another upstream does not complete the probe
+  this->reply("ndn:/P/1", *face2);
+  BOOST_CHECK_EQUAL(this->getRtt(*face2)->getNSamples(), 0);
+
+  this->reply("ndn:/P/2", *face2);
+  BOOST_REQUIRE_EQUAL(this->getRtt(*face2)->getNSamples(), 1);
+  BOOST_CHECK_EQUAL(this->getRtt(*face2)->getSmoothedRtt(), time::milliseconds(10));
+
+  // probe is completed only once
+  this->reply("ndn:/P/2", *face2);
+  BOOST_CHECK_EQUAL(this->getRtt(*face2)->getNSamples(), 1);
+
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(40));
+  this->reply("ndn:/P/1", *face1);
+  BOOST_REQUIRE_EQUAL(this->getRtt(*face1)->getNSamples(), 1);
+  BOOST_CHECK_EQUAL(this->getRtt(*face1)->getSmoothedRtt(), time::milliseconds(50));
+
+  // face2 has lower RTT
+  for (int i = 10; i < 20; ++i) {
+    BOOST_CHECK_EQUAL(this->forward(Name("ndn:/P").appendNumber(i)), face2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FollowCongestion)
+{
+  BOOST_REQUIRE_EQUAL(this->forward("ndn:/P/1"), face1);
+  BOOST_REQUIRE_EQUAL(this->forward("ndn:/P/2"), face2);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(10));
+  this->reply("ndn:/P/2", *face2);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(40));
+  this->reply("ndn:/P/1", *face1);
+
+  // face2 becomes congested, so that its RTT exceeds face1's
+  int nForwardedToFace2 = 0;
+  for (int i = 10; i < 20; ++i) {
+    Name name = Name("ndn:/P").appendNumber(i);
+    shared_ptr<Face> upstream = this->forward(name);
+    if (upstream == face1) {
+      break;
+    }
+    BOOST_REQUIRE_EQUAL(upstream, face2);
+    ++nForwardedToFace2;
+    this->advanceClocks(time::milliseconds(10), time::milliseconds(200));
+    this->reply(name, *face2);
+  }
+  BOOST_CHECK_EQUAL(nForwardedToFace2, 3);
+  BOOST_CHECK_GT(this->getRtt(*face2)->getSmoothedRtt(), time::milliseconds(50));
+}
+
+BOOST_AUTO_TEST_CASE(Explore)
+{
+  BOOST_REQUIRE_EQUAL(this->forward("ndn:/P/1"), face1);
+  BOOST_REQUIRE_EQUAL(this->forward("ndn:/P/2"), face2);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(10));
+  this->reply("ndn:/P/1", *face1);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(40));
+  this->reply("ndn:/P/2", *face2);
+
+  // face1 is faster, and keeps its samples fresh
+  for (uint32_t i = 1; i < PITlessAdaptiveRttStrategy::EXPLORE_PERIOD; ++i) {
+    Name name = Name("ndn:/P").appendNumber(100 + i);
+    BOOST_REQUIRE_EQUAL(this->forward(name), face1);
+    this->advanceClocks(time::milliseconds(1), time::milliseconds(10));
+    this->reply(name, *face1);
+  }
+
+  // face2 has the oldest sample
+  BOOST_CHECK_EQUAL(this->forward("ndn:/P/200"), face2);
+  BOOST_CHECK_EQUAL(this->forward("ndn:/P/201"), face1);
+}
+
+BOOST_AUTO_TEST_CASE(LostProbe)
+{
+  const size_t SLOT_MASK = PITlessAdaptiveRttStrategy::PROBE_TABLE_SIZE - 1;
+  Name lost("ndn:/P/lost");
+  size_t slot = name_tree::computeHash(lost) & SLOT_MASK;
+
+  // find another Name that uses the same probe slot
+  Name collider;
+  for (int i = 0; collider.empty(); ++i) {
+    Name name = Name("ndn:/P").appendNumber(i);
+    if ((name_tree::computeHash(name) & SLOT_MASK) == slot) {
+      collider = name;
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(this->forward(lost, time::milliseconds(200)), face1);
+
+  // a pending probe is not replaced
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(100));
+  this->forward(collider);
+  BOOST_CHECK_EQUAL(strategy->m_probes[slot].faceId, face1->getId());
+  BOOST_CHECK_EQUAL(this->getRtt(*face1)->getNSamples(), 0);
+
+  // an expired probe is charged with InterestLifetime before it is replaced
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(200));
+  shared_ptr<Face> upstream = this->forward(collider);
+  BOOST_CHECK_EQUAL(strategy->m_probes[slot].faceId, upstream->getId());
+  BOOST_REQUIRE_EQUAL(this->getRtt(*face1)->getNSamples(), 1);
+  BOOST_CHECK_EQUAL(this->getRtt(*face1)->getSmoothedRtt(), time::milliseconds(200));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
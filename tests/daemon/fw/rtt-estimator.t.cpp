@@ -74,6 +74,21 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_GT(rto6, rto1);
 }
 
+BOOST_AUTO_TEST_CASE(SmoothedRtt)
+{
+  RttEstimator rtt;
+  BOOST_CHECK_EQUAL(rtt.getNSamples(), 0);
+  BOOST_CHECK_EQUAL(rtt.getSmoothedRtt(), RttEstimator::getInitialRtt());
+
+  rtt.addMeasurement(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(rtt.getNSamples(), 1);
+  BOOST_CHECK_EQUAL(rtt.getSmoothedRtt(), time::milliseconds(100));
+
+  rtt.addMeasurement(time::milliseconds(200)); // gain is 0.1
+  BOOST_CHECK_EQUAL(rtt.getNSamples(), 2);
+  BOOST_CHECK_EQUAL(rtt.getSmoothedRtt(), time::milliseconds(110));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
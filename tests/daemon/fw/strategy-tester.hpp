@@ -52,9 +52,11 @@ public:
   signal::Signal<StrategyTester<S>> onAction;
 
 protected:
+  using S::sendInterest;
+
   virtual void
   sendInterest(shared_ptr<pit::Entry> pitEntry,
-               shared_ptr<Face> outFace,
+               Face& outFace,
                bool wantNewNonce = false) DECL_OVERRIDE;
 
   virtual void
@@ -72,11 +74,12 @@ public:
 template<typename S>
 inline void
 StrategyTester<S>::sendInterest(shared_ptr<pit::Entry> pitEntry,
-                                shared_ptr<Face> outFace,
+                                Face& outFace,
                                 bool wantNewNonce)
 {
-  m_sendInterestHistory.push_back(SendInterestArgs(pitEntry, outFace));
-  pitEntry->insertOrUpdateOutRecord(outFace, pitEntry->getInterest());
+  shared_ptr<Face> face = outFace.shared_from_this();
+  m_sendInterestHistory.push_back(SendInterestArgs(pitEntry, face));
+  pitEntry->insertOrUpdateOutRecord(face, pitEntry->getInterest());
   onAction();
 }
 
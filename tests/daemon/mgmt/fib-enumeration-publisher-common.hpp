@@ -31,6 +31,7 @@
 #include "mgmt/app-face.hpp"
 #include "mgmt/internal-face.hpp"
 #include "table/fib.hpp"
+#include "fw/forwarder.hpp"
 #include "table/name-tree.hpp"
 
 #include "tests/test-common.hpp"
@@ -97,7 +98,7 @@ public:
          i != nextHops.end();
          ++i)
       {
-        if (i->getFace()->getId() == faceId && i->getCost() == cost)
+        if (i->getFaceId() == faceId && i->getCost() == cost)
           {
             return true;
           }
@@ -203,6 +204,8 @@ public:
   }
 
 protected:
+  /// provides FaceTable, which assigns FaceIds to faces used as nexthops
+  Forwarder m_forwarder;
   NameTree m_nameTree;
   Fib m_fib;
   shared_ptr<InternalFace> m_face;
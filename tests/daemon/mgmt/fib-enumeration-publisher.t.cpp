@@ -49,6 +49,8 @@ BOOST_AUTO_TEST_CASE(TestFibEnumerationPublisher)
 
       shared_ptr<DummyFace> dummy1(make_shared<DummyFace>());
       shared_ptr<DummyFace> dummy2(make_shared<DummyFace>());
+      m_forwarder.addFace(dummy1);
+      m_forwarder.addFace(dummy2);
 
       shared_ptr<fib::Entry> entry = m_fib.insert(prefix).first;
       entry->addNextHop(dummy1, std::numeric_limits<uint64_t>::max() - 1);
@@ -63,6 +65,8 @@ BOOST_AUTO_TEST_CASE(TestFibEnumerationPublisher)
 
       shared_ptr<DummyFace> dummy1(make_shared<DummyFace>());
       shared_ptr<DummyFace> dummy2(make_shared<DummyFace>());
+      m_forwarder.addFace(dummy1);
+      m_forwarder.addFace(dummy2);
 
       shared_ptr<fib::Entry> entry = m_fib.insert(prefix).first;
       entry->addNextHop(dummy1, std::numeric_limits<uint8_t>::max() - 1);
@@ -64,6 +64,8 @@ public:
   addFace(shared_ptr<Face> face)
   {
     m_faces.push_back(face);
+    // FIB nexthops refer to faces by FaceId
+    m_forwarder.addFace(face);
   }
 
   void
@@ -194,9 +196,9 @@ public:
 BOOST_FIXTURE_TEST_SUITE(MgmtFibManager, AuthorizedCommandFixture<FibManagerFixture>)
 
 bool
-foundNextHop(FaceId id, uint32_t cost, const fib::NextHop& next)
+foundNextHop(uint32_t cost, const fib::NextHop& next)
 {
-  return id == next.getFace()->getId() && next.getCost() == cost;
+  return next.getCost() == cost;
 }
 
 bool
@@ -208,7 +210,7 @@ addedNextHopWithCost(const Fib& fib, const Name& prefix, size_t oldSize, uint32_
     {
       const fib::NextHopList& hops = entry->getNextHops();
       return hops.size() == oldSize + 1 &&
-        std::find_if(hops.begin(), hops.end(), bind(&foundNextHop, -1, cost, _1)) != hops.end();
+        std::find_if(hops.begin(), hops.end(), bind(&foundNextHop, cost, _1)) != hops.end();
     }
   return false;
 }
@@ -217,7 +219,7 @@ bool
 foundNextHopWithFace(FaceId id, uint32_t cost,
                      shared_ptr<Face> face, const fib::NextHop& next)
 {
-  return id == next.getFace()->getId() && next.getCost() == cost && face == next.getFace();
+  return id == next.getFaceId() && next.getCost() == cost && face->getId() == next.getFaceId();
 }
 
 bool
@@ -230,7 +232,7 @@ addedNextHopWithFace(const Fib& fib, const Name& prefix, size_t oldSize,
     {
       const fib::NextHopList& hops = entry->getNextHops();
       return hops.size() == oldSize + 1 &&
-        std::find_if(hops.begin(), hops.end(), bind(&foundNextHop, -1, cost, _1)) != hops.end();
+        std::find_if(hops.begin(), hops.end(), bind(&foundNextHop, cost, _1)) != hops.end();
     }
   return false;
 }
@@ -558,7 +560,7 @@ BOOST_AUTO_TEST_CASE(AddNextHopVerbAddToExisting)
           const fib::NextHopList& hops = entry->getNextHops();
           BOOST_REQUIRE(hops.size() == 1);
           BOOST_REQUIRE(std::find_if(hops.begin(), hops.end(),
-                                     bind(&foundNextHop, -1, 100 + i, _1)) != hops.end());
+                                     bind(&foundNextHop, 100 + i, _1)) != hops.end());
 
         }
       else
@@ -638,7 +640,7 @@ BOOST_AUTO_TEST_CASE(AddNextHopVerbUpdateFaceCost)
       BOOST_REQUIRE(hops.size() == 1);
       BOOST_REQUIRE(std::find_if(hops.begin(),
                                  hops.end(),
-                                 bind(&foundNextHop, -1, 102, _1)) != hops.end());
+                                 bind(&foundNextHop, 102, _1)) != hops.end());
     }
   else
     {
@@ -682,7 +684,7 @@ removedNextHopWithCost(const Fib& fib, const Name& prefix, size_t oldSize, uint3
     {
       const fib::NextHopList& hops = entry->getNextHops();
       return hops.size() == oldSize - 1 &&
-        std::find_if(hops.begin(), hops.end(), bind(&foundNextHop, -1, cost, _1)) == hops.end();
+        std::find_if(hops.begin(), hops.end(), bind(&foundNextHop, cost, _1)) == hops.end();
     }
   return false;
 }
@@ -24,6 +24,8 @@
  */
 
 #include "mgmt/status-server.hpp"
+#include "mgmt/pit-status-tlv.hpp"
+#include "mgmt/cs-status-tlv.hpp"
 #include "fw/forwarder.hpp"
 #include "version.hpp"
 #include "mgmt/internal-face.hpp"
@@ -99,6 +101,115 @@ BOOST_AUTO_TEST_CASE(Status)
   BOOST_CHECK_EQUAL(status.getNCsEntries(), forwarder.getCs().size());
 }
 
+BOOST_AUTO_TEST_CASE(PitStatus)
+{
+  Forwarder forwarder;
+  shared_ptr<InternalFace> internalFace = make_shared<InternalFace>();
+  internalFace->onReceiveData.connect(&interceptResponse);
+  ndn::KeyChain keyChain;
+  StatusServer statusServer(internalFace, ref(forwarder), keyChain);
+
+  Pit& pit = forwarder.getPit();
+  pit.setLimit(3);
+  pit.insert(*makeInterest("ndn:/pit1"), 301);
+  pit.insert(*makeInterest("ndn:/pit2"), 301);
+  pit.insert(*makeInterest("ndn:/pit3"), 302);
+  pit.insert(*makeInterest("ndn:/pit4"), 302);
+
+  shared_ptr<Interest> request = makeInterest("ndn:/localhost/nfd/status/pit");
+  request->setMustBeFresh(true);
+
+  g_response.reset();
+  internalFace->sendInterest(*request);
+  g_io.run_one();
+  BOOST_REQUIRE(static_cast<bool>(g_response));
+  BOOST_CHECK(Name("ndn:/localhost/nfd/status/pit").isPrefixOf(g_response->getName()));
+
+  Block status = g_response->getContent().blockFromValue();
+  BOOST_REQUIRE_EQUAL(status.type(), static_cast<uint32_t>(tlv::PitStatus));
+  status.parse();
+
+  Block::element_const_iterator it = status.elements_begin();
+  BOOST_REQUIRE(it != status.elements_end());
+  BOOST_CHECK_EQUAL(it->type(), static_cast<uint32_t>(tlv::nfd::NPitEntries));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*it), 3);
+  ++it;
+  BOOST_REQUIRE(it != status.elements_end());
+  BOOST_CHECK_EQUAL(it->type(), static_cast<uint32_t>(tlv::PitCapacity));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*it), 3);
+  ++it;
+  BOOST_REQUIRE(it != status.elements_end());
+  BOOST_CHECK_EQUAL(it->type(), static_cast<uint32_t>(tlv::NPitRejected));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*it), 1);
+  ++it;
+  BOOST_REQUIRE(it != status.elements_end());
+  BOOST_CHECK_EQUAL(it->type(), static_cast<uint32_t>(tlv::NPitEvicted));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*it), 0);
+  ++it;
+
+  std::map<uint64_t, uint64_t> usages;
+  for (; it != status.elements_end(); ++it) {
+    BOOST_REQUIRE_EQUAL(it->type(), static_cast<uint32_t>(tlv::PitFaceUsage));
+    it->parse();
+    BOOST_REQUIRE_EQUAL(it->elements().size(), 2);
+    usages[readNonNegativeInteger(it->elements()[0])] =
+      readNonNegativeInteger(it->elements()[1]);
+  }
+  BOOST_CHECK_EQUAL(usages.size(), 2);
+  BOOST_CHECK_EQUAL(usages[301], 2);
+  BOOST_CHECK_EQUAL(usages[302], 1);
+}
+
+BOOST_AUTO_TEST_CASE(CsStatus)
+{
+  Forwarder forwarder;
+  shared_ptr<InternalFace> internalFace = make_shared<InternalFace>();
+  internalFace->onReceiveData.connect(&interceptResponse);
+  ndn::KeyChain keyChain;
+  StatusServer statusServer(internalFace, ref(forwarder), keyChain);
+
+  Cs& cs = forwarder.getCs();
+  cs.setLimit(10);
+  cs.insert(*makeData("ndn:/cs1"));
+  cs.insert(*makeData("ndn:/cs2"));
+  cs.find(Interest("ndn:/cs1"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+  cs.find(Interest("ndn:/cs3"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  cs.find(Interest("ndn:/cs4"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  shared_ptr<Interest> request = makeInterest("ndn:/localhost/nfd/status/cs");
+  request->setMustBeFresh(true);
+
+  g_response.reset();
+  internalFace->sendInterest(*request);
+  g_io.run_one();
+  BOOST_REQUIRE(static_cast<bool>(g_response));
+  BOOST_CHECK(Name("ndn:/localhost/nfd/status/cs").isPrefixOf(g_response->getName()));
+
+  Block status = g_response->getContent().blockFromValue();
+  BOOST_REQUIRE_EQUAL(status.type(), static_cast<uint32_t>(tlv::CsStatus));
+  status.parse();
+  BOOST_REQUIRE_EQUAL(status.elements().size(), 5);
+
+  BOOST_CHECK_EQUAL(status.elements()[0].type(), static_cast<uint32_t>(tlv::nfd::NCsEntries));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(status.elements()[0]), 2);
+  BOOST_CHECK_EQUAL(status.elements()[1].type(), static_cast<uint32_t>(tlv::CsCapacity));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(status.elements()[1]), 10);
+  BOOST_CHECK_EQUAL(status.elements()[2].type(), static_cast<uint32_t>(tlv::CsPolicyName));
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(status.elements()[2].value()),
+                                status.elements()[2].value_size()),
+                    cs.getPolicy()->getName());
+  BOOST_CHECK_EQUAL(status.elements()[3].type(), static_cast<uint32_t>(tlv::NCsHits));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(status.elements()[3]), 1);
+  BOOST_CHECK_EQUAL(status.elements()[4].type(), static_cast<uint32_t>(tlv::NCsMisses));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(status.elements()[4]), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
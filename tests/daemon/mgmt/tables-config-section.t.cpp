@@ -30,6 +30,9 @@
 #include "tests/test-common.hpp"
 #include "tests/daemon/fw/dummy-strategy.hpp"
 
+#include <boost/filesystem.hpp>
+#include <fstream>
+
 namespace nfd {
 namespace tests {
 
@@ -45,7 +48,8 @@ public:
     , m_fib(m_forwarder.getFib())
     , m_strategyChoice(m_forwarder.getStrategyChoice())
     , m_measurements(m_forwarder.getMeasurements())
-    , m_tablesConfig(m_cs, m_pit, m_fib, m_strategyChoice, m_measurements)
+    , m_nameTree(m_forwarder.getNameTree())
+    , m_tablesConfig(m_cs, m_pit, m_fib, m_strategyChoice, m_measurements, m_nameTree)
   {
     m_tablesConfig.setConfigFile(m_config);
   }
@@ -77,6 +81,7 @@ protected:
   Fib& m_fib;
   StrategyChoice& m_strategyChoice;
   Measurements& m_measurements;
+  NameTree& m_nameTree;
 
   TablesConfigSection m_tablesConfig;
   ConfigFile m_config;
@@ -178,6 +183,388 @@ BOOST_AUTO_TEST_CASE(InvalidValueCsMaxPackets)
                              this, _1, expectedMsg));
 }
 
+BOOST_AUTO_TEST_CASE(ValidCsPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_policy clock-pro\n"
+    "}\n";
+
+  BOOST_REQUIRE_NE(m_cs.getPolicy()->getName(), "clock-pro");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_NE(m_cs.getPolicy()->getName(), "clock-pro");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getPolicy()->getName(), "clock-pro");
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCsPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_policy unknown\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value \"unknown\" for option \"cs_policy\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(ValidCsAdmission)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_admission tinylfu\n"
+    "}\n";
+
+  BOOST_REQUIRE(m_cs.getAdmissionFilter() == nullptr);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(m_cs.getAdmissionFilter() == nullptr);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  const cs::AdmissionFilter* filter = m_cs.getAdmissionFilter();
+  BOOST_REQUIRE(filter != nullptr);
+  BOOST_CHECK_EQUAL(filter->getName(), "tinylfu");
+
+  // reloading same config keeps the filter and its access history
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getAdmissionFilter(), filter);
+
+  const std::string CONFIG_NONE =
+    "tables\n"
+    "{\n"
+    "  cs_admission none\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_NONE, false));
+  BOOST_CHECK(m_cs.getAdmissionFilter() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCsAdmission)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_admission unknown\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value \"unknown\" for option \"cs_admission\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(CsShards)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_max_packets 400\n"
+    "  cs_policy clock-pro\n"
+    "  cs_admission tinylfu\n"
+    "  cs_shards 4\n"
+    "}\n";
+
+  TablesConfigSection tablesConfig(m_forwarder);
+  ConfigFile config;
+  tablesConfig.setConfigFile(config);
+
+  BOOST_REQUIRE_NO_THROW(config.parse(CONFIG, true, "dummy-config"));
+  BOOST_CHECK(m_forwarder.getShardedCs() == nullptr);
+
+  BOOST_REQUIRE_NO_THROW(config.parse(CONFIG, false, "dummy-config"));
+  ShardedCs* shardedCs = m_forwarder.getShardedCs();
+  BOOST_REQUIRE(shardedCs != nullptr);
+  BOOST_CHECK_EQUAL(shardedCs->getNShards(), 4);
+  BOOST_CHECK_EQUAL(shardedCs->getLimit(), 400);
+  for (size_t i = 0; i < shardedCs->getNShards(); ++i) {
+    BOOST_CHECK_EQUAL(shardedCs->getShard(i).getPolicy()->getName(), "clock-pro");
+    BOOST_REQUIRE(shardedCs->getShard(i).getAdmissionFilter() != nullptr);
+    BOOST_CHECK_EQUAL(shardedCs->getShard(i).getAdmissionFilter()->getName(), "tinylfu");
+  }
+
+  const std::string CONFIG_UNSHARDED =
+    "tables\n"
+    "{\n"
+    "  cs_shards 1\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(config.parse(CONFIG_UNSHARDED, false, "dummy-config"));
+  BOOST_CHECK(m_forwarder.getShardedCs() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CsShardsIgnoreSnapshot)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_shards 2\n"
+    "  cs_snapshot_file /tmp/nfd-test-cs-shards.snapshot\n"
+    "}\n";
+
+  TablesConfigSection tablesConfig(m_forwarder);
+  ConfigFile config;
+  tablesConfig.setConfigFile(config);
+
+  BOOST_REQUIRE_NO_THROW(config.parse(CONFIG, false, "dummy-config"));
+  BOOST_CHECK(m_forwarder.getShardedCs() != nullptr);
+  // snapshot covers only the unsharded CS
+  BOOST_CHECK_EQUAL(tablesConfig.getCsSnapshotFile(), "");
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCsShards)
+{
+  const std::string expectedMsg = "Invalid value for option \"cs_shards\" in \"tables\" section";
+
+  TablesConfigSection tablesConfig(m_forwarder);
+  ConfigFile config;
+  tablesConfig.setConfigFile(config);
+
+  const std::string CONFIG_ZERO =
+    "tables\n"
+    "{\n"
+    "  cs_shards 0\n"
+    "}\n";
+  BOOST_CHECK_EXCEPTION(config.parse(CONFIG_ZERO, true, "dummy-config"),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  const std::string CONFIG_TEXT =
+    "tables\n"
+    "{\n"
+    "  cs_shards many\n"
+    "}\n";
+  BOOST_CHECK_EXCEPTION(config.parse(CONFIG_TEXT, true, "dummy-config"),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  // m_tablesConfig is constructed from individual tables and cannot shard the CS
+  const std::string CONFIG_SHARDED =
+    "tables\n"
+    "{\n"
+    "  cs_shards 4\n"
+    "}\n";
+  BOOST_CHECK_THROW(runConfig(CONFIG_SHARDED, true), ConfigFile::Error);
+  BOOST_CHECK(m_forwarder.getShardedCs() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(PitAdmission)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  pit_max_entries 1000\n"
+    "  pit_overload_policy evict-soonest-expiring\n"
+    "  pit_face_quota 100\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_pit.getLimit(), std::numeric_limits<size_t>::max());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_pit.getLimit(), 1000);
+  BOOST_CHECK_EQUAL(m_pit.getOverloadPolicy(), pit::OVERLOAD_EVICT_SOONEST_EXPIRING);
+  BOOST_CHECK_EQUAL(m_pit.getFaceQuota(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidPitOverloadPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  pit_overload_policy drop-all\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value \"drop-all\" for option \"pit_overload_policy\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(NameComponentInterning)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  name_component_interning yes\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_nameTree.isComponentInterning(), false);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_nameTree.isComponentInterning(), true);
+
+  // omitting the option turns interning off again
+  BOOST_REQUIRE_NO_THROW(runConfig("tables\n{\n}\n", false));
+  BOOST_CHECK_EQUAL(m_nameTree.isComponentInterning(), false);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidNameComponentInterning)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  name_component_interning maybe\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value \"maybe\" for option \"name_component_interning\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidPitMaxEntries)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  pit_max_entries 0\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"pit_max_entries\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(CsSnapshotFile)
+{
+  const std::string path =
+    (boost::filesystem::current_path() / "unit-test-tables-config-cs.snapshot").string();
+  {
+    Cs cs;
+    cs.insert(*makeData("/A"));
+    cs.insert(*makeData("/B"));
+    std::ofstream os(path, std::ios::binary);
+    cs.saveSnapshot(os);
+  }
+
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_snapshot_file " + path + "\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_cs.size(), 0);
+  BOOST_CHECK_EQUAL(m_tablesConfig.getCsSnapshotFile(), "");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+  BOOST_CHECK_EQUAL(m_tablesConfig.getCsSnapshotFile(), path);
+
+  // reloading config does not load the snapshot again
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.size(), 2);
+
+  boost::system::error_code error;
+  boost::filesystem::remove(path, error);
+}
+
+BOOST_AUTO_TEST_CASE(CsDiskStore)
+{
+  const std::string path =
+    (boost::filesystem::current_path() / "unit-test-tables-config-cs.disk").string();
+
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_disk_store_file " + path + "\n"
+    "  cs_disk_store_size 2\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(m_cs.getDiskStore() == nullptr);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  const cs::DiskStore* diskStore = m_cs.getDiskStore();
+  BOOST_REQUIRE(diskStore != nullptr);
+  BOOST_CHECK_EQUAL(diskStore->getPath(), path);
+  BOOST_CHECK_EQUAL(diskStore->getNSegments(), 2);
+  BOOST_CHECK(boost::filesystem::exists(path));
+
+  // reloading same config keeps the DiskStore
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getDiskStore(), diskStore);
+
+  // evicted Data goes to the DiskStore
+  m_cs.setLimit(1);
+  m_cs.insert(*makeData("/A"));
+  m_cs.insert(*makeData("/B"));
+  BOOST_CHECK_EQUAL(m_cs.getDiskStore()->size(), 1);
+
+  const std::string CONFIG_NO_DISK_STORE =
+    "tables\n"
+    "{\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_NO_DISK_STORE, false));
+  BOOST_CHECK(m_cs.getDiskStore() == nullptr);
+
+  boost::system::error_code error;
+  boost::filesystem::remove(path, error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCsDiskStore)
+{
+  const std::string CONFIG_SIZE =
+    "tables\n"
+    "{\n"
+    "  cs_disk_store_file /tmp/unit-test-tables-config-cs.disk\n"
+    "  cs_disk_store_size 0\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_disk_store_size\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG_SIZE, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  const std::string CONFIG_PATH =
+    "tables\n"
+    "{\n"
+    "  cs_disk_store_file /nonexistent-directory/cs.disk\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_PATH, true));
+  BOOST_CHECK_THROW(runConfig(CONFIG_PATH, false), ConfigFile::Error);
+  BOOST_CHECK(m_cs.getDiskStore() == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(ConfigStrategy)
 {
   const std::string CONFIG =
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+#include "table/cs-admission-tinylfu.hpp"
+#include "table/cs-policy-lru.hpp"
+#include "table/name-tree.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(CsAdmissionTinyLfu)
+
+BOOST_AUTO_TEST_CASE(Sketch)
+{
+  tinylfu::CountMinSketch sketch(100);
+  BOOST_CHECK_EQUAL(sketch.getWidth(), 128);
+
+  BOOST_CHECK_EQUAL(sketch.estimate(1), 0);
+  for (int i = 0; i < 6; ++i) {
+    sketch.increment(1);
+  }
+  sketch.increment(2);
+  BOOST_CHECK_GE(sketch.estimate(1), 6);
+  BOOST_CHECK_GE(sketch.estimate(2), 1);
+
+  // counters saturate
+  for (int i = 0; i < 100; ++i) {
+    sketch.increment(3);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(3), tinylfu::CountMinSketch::MAX_COUNT);
+
+  // aging
+  sketch.halve();
+  BOOST_CHECK_GE(sketch.estimate(1), 3);
+  BOOST_CHECK_LT(sketch.estimate(1), 6);
+  BOOST_CHECK_EQUAL(sketch.estimate(3), tinylfu::CountMinSketch::MAX_COUNT / 2);
+}
+
+BOOST_AUTO_TEST_CASE(Aging)
+{
+  TinyLfuFilter filter;
+  filter.setLimit(4);
+  uint64_t hashA = name_tree::computeHash("/A");
+
+  // sample size is SAMPLE_FACTOR * 4; the 40th access halves the counters
+  for (size_t i = 0; i < TinyLfuFilter::SAMPLE_FACTOR * 4 - 1; ++i) {
+    filter.recordAccess(hashA);
+  }
+  BOOST_CHECK_EQUAL(filter.estimateFrequency(hashA), tinylfu::CountMinSketch::MAX_COUNT);
+
+  filter.recordAccess(hashA);
+  BOOST_CHECK_EQUAL(filter.estimateFrequency(hashA), tinylfu::CountMinSketch::MAX_COUNT / 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(ScanResistance, BaseFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(unique_ptr<Policy>(new LruPolicy()));
+  cs.setAdmissionFilter(unique_ptr<AdmissionFilter>(new TinyLfuFilter()));
+  BOOST_REQUIRE(cs.getAdmissionFilter() != nullptr);
+  BOOST_CHECK_EQUAL(cs.getAdmissionFilter()->getName(), TinyLfuFilter::FILTER_NAME);
+
+  // CS is not full: everything is admitted
+  BOOST_CHECK_EQUAL(cs.insert(*makeData("ndn:/A")), true);
+  BOOST_CHECK_EQUAL(cs.insert(*makeData("ndn:/B")), true);
+  BOOST_CHECK_EQUAL(cs.insert(*makeData("ndn:/C")), true);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // make A, B, C popular
+  for (int i = 0; i < 3; ++i) {
+    for (const char* uri : {"ndn:/A", "ndn:/B", "ndn:/C"}) {
+      cs.find(Interest(uri),
+              bind([] { BOOST_CHECK(true); }),
+              bind([] { BOOST_CHECK(false); }));
+    }
+  }
+
+  // scan: one-time Data are rejected
+  for (int i = 0; i < 10; ++i) {
+    Name name("ndn:/scan");
+    name.appendNumber(i);
+    BOOST_CHECK_EQUAL(cs.insert(*makeData(name)), false);
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(cs.getAdmissionFilter()->getNRejected(), 10);
+  BOOST_CHECK_EQUAL(cs.getAdmissionFilter()->getNAdmitted(), 0);
+
+  for (const char* uri : {"ndn:/A", "ndn:/B", "ndn:/C"}) {
+    cs.find(Interest(uri),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+
+  // a Data requested more often than the victim is admitted
+  shared_ptr<Data> dataD = makeData("ndn:/D");
+  for (int i = 0; i < 8; ++i) {
+    cs.insert(*dataD);
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(cs.getAdmissionFilter()->getNAdmitted(), 1);
+  cs.find(Interest("ndn:/D"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(RemoveFilter, BaseFixture)
+{
+  Cs cs(1);
+  cs.setAdmissionFilter(unique_ptr<AdmissionFilter>(new TinyLfuFilter()));
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(cs.insert(*makeData("ndn:/B")), false);
+
+  cs.setAdmissionFilter(nullptr);
+  BOOST_CHECK(cs.getAdmissionFilter() == nullptr);
+  BOOST_CHECK_EQUAL(cs.insert(*makeData("ndn:/B")), true);
+  cs.find(Interest("ndn:/B"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+#include "table/cs-disk-store.hpp"
+#include "table/cs-admission-tinylfu.hpp"
+#include "table/cs-policy-lru.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+class DiskStoreFixture : public UnitTestTimeFixture
+{
+protected:
+  DiskStoreFixture()
+    : path((boost::filesystem::current_path() / "unit-test-cs-disk-store.bin").string())
+  {
+  }
+
+  ~DiskStoreFixture()
+  {
+    boost::system::error_code error;
+    boost::filesystem::remove(path, error);
+  }
+
+  shared_ptr<Data>
+  makeFreshData(const Name& name, const time::milliseconds& freshnessPeriod)
+  {
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(freshnessPeriod);
+    data->wireEncode();
+    return data;
+  }
+
+protected:
+  std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TableCsDiskStore, DiskStoreFixture)
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  DiskStore store(path, 4, 4096);
+  time::steady_clock::TimePoint staleTime = time::steady_clock::now() + time::seconds(1);
+
+  shared_ptr<Data> dataA = makeData("ndn:/A/1");
+  BOOST_CHECK(store.insert(*dataA, staleTime));
+  BOOST_CHECK(store.insert(*makeData("ndn:/A/2"), staleTime));
+  BOOST_CHECK_EQUAL(store.size(), 2);
+
+  // same Name supersedes the previous record
+  BOOST_CHECK(store.insert(*dataA, staleTime));
+  BOOST_CHECK_EQUAL(store.size(), 2);
+
+  time::steady_clock::TimePoint foundStaleTime;
+  BOOST_CHECK(store.find(Interest("ndn:/A"), foundStaleTime) == nullptr); // not exact Name
+  BOOST_CHECK(store.find(Interest("ndn:/B"), foundStaleTime) == nullptr);
+
+  shared_ptr<Data> found = store.find(Interest("ndn:/A/1"), foundStaleTime);
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getFullName(), dataA->getFullName());
+  BOOST_CHECK(foundStaleTime == staleTime);
+
+  // found Data is removed, because CS promotes it
+  BOOST_CHECK_EQUAL(store.size(), 1);
+  BOOST_CHECK(store.find(Interest("ndn:/A/1"), foundStaleTime) == nullptr);
+
+  // full Name
+  shared_ptr<Data> dataC = makeData("ndn:/C");
+  store.insert(*dataC, staleTime);
+  BOOST_CHECK(store.find(Interest(dataC->getFullName()), foundStaleTime) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MustBeFresh)
+{
+  DiskStore store(path, 4, 4096);
+  store.insert(*makeData("ndn:/A"), time::steady_clock::now() + time::milliseconds(10));
+  this->advanceClocks(time::milliseconds(11));
+
+  Interest interest("ndn:/A");
+  interest.setMustBeFresh(true);
+  time::steady_clock::TimePoint staleTime;
+  BOOST_CHECK(store.find(interest, staleTime) == nullptr);
+
+  interest.setMustBeFresh(false);
+  BOOST_CHECK(store.find(interest, staleTime) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ReclaimSegment)
+{
+  // each record occupies between (wire + 16) and (wire + 23) octets
+  shared_ptr<Data> sample = makeData(Name("ndn:/sample").appendNumber(0));
+  size_t segmentSize = (sample->wireEncode().size() + 24) * 2;
+  DiskStore store(path, 2, segmentSize);
+  time::steady_clock::TimePoint staleTime = time::steady_clock::TimePoint::max();
+
+  // each segment holds two records
+  for (int i = 0; i < 4; ++i) {
+    Name name("ndn:/sample");
+    name.appendNumber(i);
+    store.insert(*makeData(name), staleTime);
+  }
+  BOOST_CHECK_EQUAL(store.size(), 4);
+  BOOST_CHECK_EQUAL(store.getNReclaimedSegments(), 0);
+
+  // the fifth record wraps around, and reclaims the first segment
+  store.insert(*makeData(Name("ndn:/sample").appendNumber(4)), staleTime);
+  BOOST_CHECK_EQUAL(store.getNReclaimedSegments(), 1);
+  BOOST_CHECK_EQUAL(store.size(), 3);
+
+  time::steady_clock::TimePoint foundStaleTime;
+  BOOST_CHECK(store.find(Interest(Name("ndn:/sample").appendNumber(0)), foundStaleTime) == nullptr);
+  BOOST_CHECK(store.find(Interest(Name("ndn:/sample").appendNumber(1)), foundStaleTime) == nullptr);
+  BOOST_CHECK(store.find(Interest(Name("ndn:/sample").appendNumber(2)), foundStaleTime) != nullptr);
+  BOOST_CHECK(store.find(Interest(Name("ndn:/sample").appendNumber(4)), foundStaleTime) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SecondTier)
+{
+  Cs cs(2);
+  cs.setPolicy(unique_ptr<Policy>(new LruPolicy()));
+  cs.setDiskStore(unique_ptr<DiskStore>(new DiskStore(path, 4, 4096)));
+
+  cs.insert(*makeFreshData("ndn:/A", time::milliseconds(100)));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C")); // evicts A to disk
+  cs.insert(*makeData("ndn:/D"), true); // evicts B to disk
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 2);
+
+  // unsolicited Data is not written to disk
+  cs.insert(*makeData("ndn:/E")); // evicts C to disk
+  cs.insert(*makeData("ndn:/F")); // evicts unsolicited D
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 3);
+
+  // hit on disk promotes A to memory
+  this->advanceClocks(time::milliseconds(50));
+  bool isHit = false;
+  cs.find(Interest("ndn:/A"),
+          bind([&isHit] { isHit = true; }),
+          bind([] { BOOST_CHECK(false); }));
+  BOOST_CHECK(isHit);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  // promoted entry keeps its original stale time
+  this->advanceClocks(time::milliseconds(60));
+  Interest interestA("ndn:/A");
+  interestA.setMustBeFresh(true);
+  cs.find(interestA,
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  cs.find(Interest("ndn:/D"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+}
+
+BOOST_AUTO_TEST_CASE(PromotionBypassesAdmission)
+{
+  Cs cs(1);
+  cs.setPolicy(unique_ptr<Policy>(new LruPolicy()));
+  cs.setDiskStore(unique_ptr<DiskStore>(new DiskStore(path, 4, 4096)));
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B")); // evicts A to disk
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 1);
+
+  // B is more popular than A, so the admission filter would reject A in favor of B
+  cs.setAdmissionFilter(unique_ptr<AdmissionFilter>(new TinyLfuFilter()));
+  for (int i = 0; i < 3; ++i) {
+    cs.find(Interest("ndn:/B"),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+
+  // A is promoted nevertheless, and B is evicted to disk
+  bool isHit = false;
+  cs.find(Interest("ndn:/A"),
+          bind([&isHit] { isHit = true; }),
+          bind([] { BOOST_CHECK(false); }));
+  BOOST_CHECK(isHit);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 1);
+  BOOST_CHECK_EQUAL(cs.getAdmissionFilter()->getNRejected(), 0);
+
+  // neither Data is lost
+  for (const char* uri : {"ndn:/A", "ndn:/B"}) {
+    cs.find(Interest(uri),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
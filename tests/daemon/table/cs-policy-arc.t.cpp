@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+#include "table/cs-policy-arc.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(CsArc)
+
+BOOST_FIXTURE_TEST_CASE(GhostHit, BaseFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(unique_ptr<Policy>(new ArcPolicy()));
+  ArcPolicy& policy = static_cast<ArcPolicy&>(*cs.getPolicy());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+
+  // use A, which moves A to T2
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  // evict B from T1, and remember it in B1
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(policy.getQueueSize(arc::QUEUE_RECENT), 2);
+  BOOST_CHECK_EQUAL(policy.getQueueSize(arc::QUEUE_FREQUENT), 1);
+  BOOST_CHECK_EQUAL(policy.getGhostListSize(arc::QUEUE_RECENT), 1);
+  cs.find(Interest("ndn:/B"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  // B is found in B1: T1 target grows, B goes to T2, C is evicted from T1
+  cs.insert(*makeData("ndn:/B"));
+  BOOST_CHECK_EQUAL(policy.getTargetRecentSize(), 1);
+  BOOST_CHECK_EQUAL(policy.getQueueSize(arc::QUEUE_FREQUENT), 2);
+  cs.find(Interest("ndn:/C"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  cs.find(Interest("ndn:/D"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(ScanResistance, BaseFixture)
+{
+  Cs cs(10);
+  cs.setPolicy(unique_ptr<Policy>(new ArcPolicy()));
+
+  for (int i = 0; i < 5; ++i) {
+    cs.insert(*makeData(Name("/hot").appendNumber(i)));
+  }
+  for (int i = 0; i < 5; ++i) {
+    cs.find(Interest(Name("/hot").appendNumber(i)),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+
+  // one-time scan passes through T1 only
+  for (int i = 0; i < 100; ++i) {
+    cs.insert(*makeData(Name("/scan").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+
+  for (int i = 0; i < 5; ++i) {
+    cs.find(Interest(Name("/hot").appendNumber(i)),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+  BOOST_CHECK_EQUAL(cs.getNHits(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+#include "table/cs-policy-clock-pro.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(CsClockPro)
+
+BOOST_FIXTURE_TEST_CASE(NonResidentHit, BaseFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(unique_ptr<Policy>(new ClockProPolicy()));
+  ClockProPolicy& policy = static_cast<ClockProPolicy&>(*cs.getPolicy());
+
+  cs.insert(*makeData("ndn:/A"));
+  cs.insert(*makeData("ndn:/B"));
+  cs.insert(*makeData("ndn:/C"));
+  BOOST_CHECK_EQUAL(policy.getNColdPages(), 3);
+
+  // evict A, which is in its test period and stays as a non-resident page
+  cs.insert(*makeData("ndn:/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(policy.getNNonResidentPages(), 1);
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  // A is inserted again during its test period: A becomes hot, cold target grows
+  cs.insert(*makeData("ndn:/A"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(policy.getNHotPages(), 1);
+  BOOST_CHECK_EQUAL(policy.getColdTarget(), 2);
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(ScanResistance, BaseFixture)
+{
+  Cs cs(10);
+  cs.setPolicy(unique_ptr<Policy>(new ClockProPolicy()));
+  ClockProPolicy& policy = static_cast<ClockProPolicy&>(*cs.getPolicy());
+
+  for (int i = 0; i < 5; ++i) {
+    cs.insert(*makeData(Name("/hot").appendNumber(i)));
+  }
+  for (int i = 0; i < 5; ++i) {
+    cs.find(Interest(Name("/hot").appendNumber(i)),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+
+  // referenced cold pages are promoted to hot when HAND_cold passes them,
+  // while one-time scan pages are evicted
+  for (int i = 0; i < 100; ++i) {
+    cs.insert(*makeData(Name("/scan").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+  BOOST_CHECK_EQUAL(policy.getNHotPages(), 5);
+  BOOST_CHECK_LE(policy.getNNonResidentPages(), cs.getLimit());
+
+  for (int i = 0; i < 5; ++i) {
+    cs.find(Interest(Name("/hot").appendNumber(i)),
+            bind([] { BOOST_CHECK(true); }),
+            bind([] { BOOST_CHECK(false); }));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
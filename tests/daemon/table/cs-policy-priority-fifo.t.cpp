@@ -141,6 +141,45 @@ BOOST_FIXTURE_TEST_CASE(Refresh, UnitTestTimeFixture)
           bind([] { BOOST_CHECK(true); }));
 }
 
+BOOST_FIXTURE_TEST_CASE(StaleOrder, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  cs.setPolicy(unique_ptr<Policy>(new PriorityFifoPolicy()));
+
+  shared_ptr<Data> dataA = makeData("ndn:/A");
+  dataA->setFreshnessPeriod(time::milliseconds(500));
+  dataA->wireEncode();
+  cs.insert(*dataA);
+
+  shared_ptr<Data> dataB = makeData("ndn:/B");
+  dataB->setFreshnessPeriod(time::milliseconds(100));
+  dataB->wireEncode();
+  cs.insert(*dataB);
+
+  shared_ptr<Data> dataC = makeData("ndn:/C");
+  dataC->setFreshnessPeriod(time::milliseconds(300));
+  dataC->wireEncode();
+  cs.insert(*dataC);
+
+  // all entries become stale without any scheduled event
+  this->advanceClocks(time::milliseconds(600));
+
+  // stale entries are evicted in the order they became stale: B, C, A
+  const char* expectedVictims[] = {"ndn:/B", "ndn:/C", "ndn:/A"};
+  for (size_t i = 0; i < 3; ++i) {
+    Name name("ndn:/D");
+    name.appendNumber(i);
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(time::milliseconds(99999));
+    data->wireEncode();
+    cs.insert(*data);
+    BOOST_CHECK_EQUAL(cs.size(), 3);
+    cs.find(Interest(expectedVictims[i]),
+            bind([] { BOOST_CHECK(false); }),
+            bind([] { BOOST_CHECK(true); }));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
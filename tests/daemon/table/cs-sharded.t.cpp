@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-sharded.hpp"
+#include "table/cs-policy-lru.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_FIXTURE_TEST_SUITE(TableCsSharded, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(Routing)
+{
+  ShardedCs cs(4, 100);
+  BOOST_CHECK_EQUAL(cs.getNShards(), 4);
+  BOOST_CHECK_EQUAL(cs.getRoutingPrefixLength(), ShardedCs::DEFAULT_ROUTING_PREFIX_LENGTH);
+
+  // all Names under one routing prefix go to one shard
+  size_t index = cs.getShardIndex("/A");
+  BOOST_CHECK_EQUAL(cs.getShardIndex("/A/B"), index);
+  BOOST_CHECK_EQUAL(cs.getShardIndex("/A/C/D"), index);
+
+  // precomputed hashes pick the same shard, and the entry keeps the Name hash
+  Name nameAcd("/A/C/D");
+  name_tree::HashContext hashes(nameAcd);
+  BOOST_CHECK_EQUAL(cs.getShardIndex(nameAcd, hashes), index);
+
+  cs.insert(*makeData("/A/B"));
+  cs.insert(*makeData(nameAcd), hashes);
+  BOOST_CHECK_EQUAL(cs.getShard(index).size(), 2);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  const Entry* entry = cs.getShard(index).probe(Interest(nameAcd));
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getNameHash(), hashes.getFullHash());
+
+  // routing is spread across shards
+  std::set<size_t> indices;
+  for (int i = 0; i < 100; ++i) {
+    indices.insert(cs.getShardIndex(Name("/P").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(indices.size(), 1);
+  for (int i = 0; i < 100; ++i) {
+    indices.insert(cs.getShardIndex(Name().appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(indices.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Limit)
+{
+  ShardedCs cs(3, 10, 1, [] { return unique_ptr<Policy>(new LruPolicy()); });
+  BOOST_CHECK_EQUAL(cs.getLimit(), 10);
+  BOOST_CHECK_EQUAL(cs.getShard(0).getLimit(), 4);
+  BOOST_CHECK_EQUAL(cs.getShard(1).getLimit(), 3);
+  BOOST_CHECK_EQUAL(cs.getShard(2).getLimit(), 3);
+  BOOST_CHECK_EQUAL(cs.getShard(0).getPolicy()->getName(), LruPolicy::POLICY_NAME);
+  BOOST_CHECK(cs.getShard(0).getPolicy() != cs.getShard(1).getPolicy());
+
+  // each shard evicts independently
+  size_t index = cs.getShardIndex("/A");
+  for (int i = 0; i < 10; ++i) {
+    cs.insert(*makeData(Name("/A").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(cs.getShard(index).size(), cs.getShard(index).getLimit());
+  BOOST_CHECK_EQUAL(cs.size(), cs.getShard(index).getLimit());
+
+  cs.setLimit(30);
+  BOOST_CHECK_EQUAL(cs.getLimit(), 30);
+}
+
+BOOST_AUTO_TEST_CASE(FindAndCounters)
+{
+  ShardedCs cs(4, 100);
+  cs.insert(*makeData("/A/1"));
+  cs.insert(*makeData("/B/1"));
+  BOOST_CHECK_EQUAL(cs.getNInserts(), 2);
+
+  cs.find(Interest("/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+  cs.find(Interest("/C"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  BOOST_CHECK_EQUAL(cs.getNHits(), 1);
+  BOOST_CHECK_EQUAL(cs.getNMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(FindShortName)
+{
+  ShardedCs cs(4, 100);
+  cs.insert(*makeData("/A/1"));
+  cs.insert(*makeData("/B/1"));
+
+  // Interest Name is shorter than routing prefix, all shards are searched
+  Name found;
+  cs.find(Interest("/"),
+          [&] (const Interest&, const Data& data) { found = data.getName(); },
+          bind([] { BOOST_CHECK(false); }));
+  BOOST_CHECK_EQUAL(found, "/A/1");
+
+  Interest rightmost("/");
+  rightmost.setChildSelector(1);
+  cs.find(rightmost,
+          [&] (const Interest&, const Data& data) { found = data.getName(); },
+          bind([] { BOOST_CHECK(false); }));
+  BOOST_CHECK_EQUAL(found, "/B/1");
+
+  BOOST_CHECK_EQUAL(cs.getNHits(), 2);
+
+  // only the answering shard performs a lookup with side effects
+  size_t indexA = cs.getShardIndex("/A");
+  size_t indexB = cs.getShardIndex("/B");
+  for (size_t i = 0; i < cs.getNShards(); ++i) {
+    BOOST_CHECK_EQUAL(cs.getShard(i).getNMisses(), 0);
+    size_t nExpectedHits = (i == indexA ? 1 : 0) + (i == indexB ? 1 : 0);
+    BOOST_CHECK_EQUAL(cs.getShard(i).getNHits(), nExpectedHits);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FindFullName)
+{
+  ShardedCs cs(4, 100, 3);
+  shared_ptr<Data> data = makeData("/A/B");
+  cs.insert(*data);
+
+  // the implicit digest is not part of the routing prefix
+  BOOST_CHECK_EQUAL(cs.getShardIndex(data->getFullName()), cs.getShardIndex(data->getName()));
+
+  Name found;
+  cs.find(Interest(data->getFullName()),
+          [&] (const Interest&, const Data& foundData) { found = foundData.getFullName(); },
+          bind([] { BOOST_CHECK(false); }));
+  BOOST_CHECK_EQUAL(found, data->getFullName());
+  BOOST_CHECK_EQUAL(cs.getNHits(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
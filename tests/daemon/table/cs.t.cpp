@@ -26,6 +26,8 @@
 #include "table/cs.hpp"
 #include <ndn-cxx/util/crypto.hpp>
 
+#include <sstream>
+
 #include "tests/test-common.hpp"
 
 #define CHECK_CS_FIND(expected) find([&] (uint32_t found) { BOOST_CHECK_EQUAL(expected, found); });
@@ -366,6 +368,172 @@ BOOST_AUTO_TEST_CASE(Enumeration)
   BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
 }
 
+BOOST_AUTO_TEST_CASE(CompactEntry)
+{
+  Cs cs;
+
+  shared_ptr<Data> data = makeData("/A/B");
+  data->setFreshnessPeriod(time::seconds(10));
+  data->wireEncode();
+  cs.insert(*data);
+
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  const Entry& entry = *cs.begin();
+  BOOST_CHECK_EQUAL(entry.getName(), data->getName());
+  BOOST_CHECK_EQUAL(entry.getWire().size(), data->wireEncode().size());
+  BOOST_CHECK_EQUAL(entry.getFullName(), data->getFullName());
+  BOOST_CHECK_EQUAL(entry.getImplicitDigest(), data->getFullName()[-1]);
+
+  // Name is compared on the wire encoding
+  BOOST_CHECK_EQUAL(entry.getNameSize(), 2);
+  BOOST_CHECK_EQUAL(entry.compareName("/A/B"), 0);
+  BOOST_CHECK_EQUAL(entry.compareName("/A/B/C", 2), 0);
+  BOOST_CHECK_LT(entry.compareName("/A/C"), 0);
+  BOOST_CHECK_LT(entry.compareName("/A/BB"), 0);
+  BOOST_CHECK_GT(entry.compareName("/A"), 0);
+  BOOST_CHECK_GT(entry.compareName("/A/A/Z"), 0);
+
+  // Data is materialized from wire encoding
+  shared_ptr<const Data> decoded = entry.getData();
+  BOOST_CHECK(decoded != data);
+  BOOST_CHECK_EQUAL(decoded->getName(), data->getName());
+  BOOST_CHECK_EQUAL(decoded->getFreshnessPeriod(), data->getFreshnessPeriod());
+  BOOST_CHECK_EQUAL(decoded->getFullName(), data->getFullName());
+
+  // Interest with full name is matched using the digest computed from wire encoding
+  cs.find(Interest(data->getFullName()),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  // the entry shares the buffer of the Data
+  BOOST_CHECK(entry.getWire().wire() == data->wireEncode().wire());
+  BOOST_CHECK(entry.getNameWire() == data->getName().wireEncode());
+
+  // same Data in another buffer refreshes the entry,
+  // another Data with same Name is a separate entry
+  const Block& wire = data->wireEncode();
+  cs.insert(Data(Block(wire.wire(), wire.size())));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  shared_ptr<Data> other = make_shared<Data>("/A/B");
+  other->setContent(reinterpret_cast<const uint8_t*>("x"), 1);
+  signData(other);
+  cs.insert(*other);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CanonicalOrder)
+{
+  Cs cs;
+  std::vector<Name> names{"/A/C", "/A/BB", "/A/B/C", "/A/B", "/A", "/B"};
+  for (const Name& name : names) {
+    cs.insert(*makeData(name));
+  }
+
+  // entries are ordered as their Names, although they are compared on the wire encoding
+  std::sort(names.begin(), names.end());
+  std::vector<Name> actual;
+  for (const auto& csEntry : cs) {
+    actual.push_back(csEntry.getName());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), names.begin(), names.end());
+}
+
+BOOST_AUTO_TEST_SUITE(Snapshot)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  Cs cs1(3);
+  cs1.insert(*makeData("/A"));
+  cs1.insert(*makeData("/B"));
+  cs1.insert(*makeData("/C"));
+
+  std::stringstream ss;
+  cs1.saveSnapshot(ss);
+
+  // only two entries fit, /A would be evicted first and is skipped
+  Cs cs2(2);
+  BOOST_CHECK_EQUAL(cs2.loadSnapshot(ss), 2);
+  BOOST_CHECK_EQUAL(cs2.size(), 2);
+
+  std::set<Name> expected = {"/B", "/C"};
+  std::set<Name> actual;
+  for (const auto& csEntry : cs2) {
+    actual.insert(csEntry.getName());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  // policy order is restored: /B is evicted before /C
+  cs2.insert(*makeData("/D"));
+  cs2.find(Interest("/B"),
+           bind([] { BOOST_CHECK(false); }),
+           bind([] { BOOST_CHECK(true); }));
+  cs2.find(Interest("/C"),
+           bind([] { BOOST_CHECK(true); }),
+           bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(StaleTime, UnitTestTimeFixture)
+{
+  Cs cs1;
+  shared_ptr<Data> data = makeData("/A");
+  data->setFreshnessPeriod(time::seconds(10));
+  data->wireEncode();
+  cs1.insert(*data);
+
+  std::stringstream ss;
+  cs1.saveSnapshot(ss);
+
+  this->advanceClocks(time::seconds(4));
+
+  Cs cs2;
+  BOOST_CHECK_EQUAL(cs2.loadSnapshot(ss), 1);
+
+  shared_ptr<Interest> interest = makeInterest("/A");
+  interest->setMustBeFresh(true);
+  cs2.find(*interest,
+           bind([] { BOOST_CHECK(true); }),
+           bind([] { BOOST_CHECK(false); }));
+
+  // entry is stale 10 seconds after its original insertion, not after loading
+  this->advanceClocks(time::seconds(8));
+  cs2.find(*interest,
+           bind([] { BOOST_CHECK(false); }),
+           bind([] { BOOST_CHECK(true); }));
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  Cs cs;
+
+  std::stringstream ss1("not a snapshot");
+  BOOST_CHECK_THROW(cs.loadSnapshot(ss1), Cs::Error);
+
+  Cs cs1;
+  cs1.insert(*makeData("/A"));
+  std::stringstream ss2;
+  cs1.saveSnapshot(ss2);
+  std::string truncated = ss2.str();
+  truncated.resize(truncated.size() - 1);
+  std::stringstream ss3(truncated);
+  BOOST_CHECK_THROW(cs.loadSnapshot(ss3), Cs::Error);
+
+  // a record longer than the maximum packet size is rejected before it is read
+  Cs cs2;
+  std::stringstream ss4;
+  cs2.saveSnapshot(ss4);
+  uint8_t isUnsolicited = 0;
+  uint8_t hasStaleTime = 0;
+  int64_t staleTime = 0;
+  uint32_t wireLength = std::numeric_limits<uint32_t>::max();
+  ss4.write(reinterpret_cast<const char*>(&isUnsolicited), sizeof(isUnsolicited));
+  ss4.write(reinterpret_cast<const char*>(&hasStaleTime), sizeof(hasStaleTime));
+  ss4.write(reinterpret_cast<const char*>(&staleTime), sizeof(staleTime));
+  ss4.write(reinterpret_cast<const char*>(&wireLength), sizeof(wireLength));
+  BOOST_CHECK_THROW(cs.loadSnapshot(ss4), Cs::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Snapshot
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
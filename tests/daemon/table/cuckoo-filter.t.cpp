@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cuckoo-filter.hpp"
+#include "core/city-hash.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TableCuckooFilter, BaseFixture)
+
+static uint64_t
+makeKey(uint64_t i)
+{
+  return Hash128to64(uint128(i, 0x2545f4914f6cdd1dULL));
+}
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  CuckooFilter filter(100);
+  BOOST_CHECK_EQUAL(filter.size(), 0);
+  BOOST_CHECK_EQUAL(filter.getCapacity(), 100);
+  BOOST_CHECK_GE(filter.getNSlots() * CuckooFilter::MAX_LOAD, 100);
+  BOOST_CHECK_EQUAL(filter.contains(makeKey(1)), false);
+
+  BOOST_CHECK_EQUAL(filter.insert(makeKey(1)), true);
+  BOOST_CHECK_EQUAL(filter.contains(makeKey(1)), true);
+  BOOST_CHECK_EQUAL(filter.size(), 1);
+
+  BOOST_CHECK_EQUAL(filter.insert(makeKey(1)), false);
+  BOOST_CHECK_EQUAL(filter.size(), 1);
+
+  filter.reset(10);
+  BOOST_CHECK_EQUAL(filter.size(), 0);
+  BOOST_CHECK_EQUAL(filter.getCapacity(), 10);
+  BOOST_CHECK_EQUAL(filter.contains(makeKey(1)), false);
+}
+
+BOOST_AUTO_TEST_CASE(NoFalseNegative)
+{
+  const size_t CAPACITY = 5000;
+  CuckooFilter filter(CAPACITY);
+
+  // insert twice the capacity, so that relocation and stash are exercised
+  for (uint64_t i = 0; i < CAPACITY * 2; ++i) {
+    filter.insert(makeKey(i));
+  }
+  BOOST_CHECK_LE(filter.size(), CAPACITY * 2);
+
+  size_t nMissing = 0;
+  for (uint64_t i = 0; i < CAPACITY * 2; ++i) {
+    if (!filter.contains(makeKey(i))) {
+      ++nMissing;
+    }
+  }
+  BOOST_CHECK_EQUAL(nMissing, 0);
+
+  size_t nFalsePositives = 0;
+  for (uint64_t i = CAPACITY * 2; i < CAPACITY * 4; ++i) {
+    if (filter.contains(makeKey(i))) {
+      ++nFalsePositives;
+    }
+  }
+  BOOST_CHECK_LE(nFalsePositives, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
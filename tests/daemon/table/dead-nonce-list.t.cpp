@@ -24,6 +24,7 @@
  */
 
 #include "table/dead-nonce-list.hpp"
+#include "table/name-tree.hpp"
 
 #include "tests/test-common.hpp"
 
@@ -50,6 +51,37 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
 }
 
+BOOST_AUTO_TEST_CASE(NameHash)
+{
+  Name nameA("ndn:/A/B");
+  Name nameB("ndn:/B/C");
+  const uint32_t nonce1 = 0x7a1c6e05;
+
+  DeadNonceList dnl;
+  dnl.add(name_tree::computeHash(nameA), nameA.size(), nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(name_tree::computeHash(nameA), nameA.size(), nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(name_tree::computeHash(nameB), nameB.size(), nonce1), false);
+
+  dnl.add(nameB, nonce1);
+  BOOST_CHECK_EQUAL(dnl.has(name_tree::computeHash(nameB), nameB.size(), nonce1), true);
+}
+
+BOOST_AUTO_TEST_CASE(RepeatedComponents)
+{
+  // XOR of component hashes is the same for these Names
+  Name nameA("ndn:/A/A/B");
+  Name nameB("ndn:/B");
+  BOOST_REQUIRE_EQUAL(name_tree::computeHash(nameA), name_tree::computeHash(nameB));
+  const uint32_t nonce1 = 0x4c2d91e6;
+
+  DeadNonceList dnl;
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+}
+
 BOOST_AUTO_TEST_CASE(MinLifetime)
 {
   BOOST_CHECK_THROW(DeadNonceList dnl(time::milliseconds::zero()), std::invalid_argument);
@@ -63,7 +95,7 @@ protected:
     : dnl(LIFETIME)
     , name("ndn:/N")
     , addNonceBatch(0)
-    , addNonceInterval(LIFETIME / DeadNonceList::EXPECTED_MARK_COUNT)
+    , addNonceInterval(LIFETIME / DeadNonceList::ROTATIONS_PER_LIFETIME)
     , timeUnit(addNonceInterval / 2)
   {
     this->addNonce();
@@ -72,7 +104,7 @@ protected:
   void
   setRate(size_t nNoncesPerLifetime)
   {
-    addNonceBatch = nNoncesPerLifetime / DeadNonceList::EXPECTED_MARK_COUNT;
+    addNonceBatch = nNoncesPerLifetime / DeadNonceList::ROTATIONS_PER_LIFETIME;
   }
 
   void
@@ -153,6 +185,39 @@ BOOST_FIXTURE_TEST_CASE(CapacityUp, PeriodicalInsertionFixture)
   BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
 }
 
+BOOST_FIXTURE_TEST_CASE(Burst, UnitTestTimeFixture)
+{
+  const time::nanoseconds LIFETIME = time::milliseconds(200);
+  DeadNonceList dnl(LIFETIME);
+  size_t cap0 = dnl.m_capacity;
+
+  Name nameC("ndn:/C");
+  const uint32_t nonceC = 0x6e0b52d7;
+  dnl.add(nameC, nonceC);
+
+  // many times the capacity of a generation, within one rotation interval
+  Name name("ndn:/N");
+  const size_t N_BURST = DeadNonceList::INITIAL_CAPACITY * 4;
+  for (uint32_t nonce = 1; nonce <= N_BURST; ++nonce) {
+    dnl.add(name, nonce);
+  }
+  BOOST_CHECK_EQUAL(dnl.size(), N_BURST + 1);
+  BOOST_CHECK_GT(dnl.m_capacity, cap0);
+
+  // the current generation grows instead of rotating early, so entries are kept for lifetime
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+  BOOST_CHECK_EQUAL(dnl.has(name, 1), true);
+  BOOST_CHECK_EQUAL(dnl.has(name, N_BURST), true);
+
+  this->advanceClocks(time::milliseconds(1), LIFETIME);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+  BOOST_CHECK_EQUAL(dnl.has(name, 1), true);
+
+  this->advanceClocks(time::milliseconds(1), LIFETIME / 2);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+  BOOST_CHECK_EQUAL(dnl.has(name, 1), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/fib-snapshot.hpp"
+#include "table/fib.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fib {
+namespace tests {
+
+using namespace nfd::tests;
+
+class FibSnapshotFixture : public BaseFixture
+{
+public:
+  FibSnapshotFixture()
+    : fib(nameTree)
+  {
+  }
+
+  shared_ptr<Entry>
+  insert(const Name& prefix)
+  {
+    shared_ptr<Entry> entry = fib.insert(prefix).first;
+    entries.push_back(std::make_pair(entry, name_tree::computeHash(prefix)));
+    return entry;
+  }
+
+public:
+  NameTree nameTree;
+  Fib fib;
+  std::vector<std::pair<shared_ptr<Entry>, size_t>> entries;
+};
+
+static shared_ptr<Entry>
+lpm(const Snapshot& snapshot, const Name& name)
+{
+  return snapshot.findLongestPrefixMatch(name, name_tree::HashContext(name));
+}
+
+BOOST_FIXTURE_TEST_SUITE(TableFibSnapshot, FibSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  shared_ptr<Entry> root = this->insert("/");
+  shared_ptr<Entry> a = this->insert("/A");
+  shared_ptr<Entry> abc = this->insert("/A/B/C");
+  shared_ptr<Entry> xyz = this->insert("/X/Y/Z");
+
+  Snapshot snapshot(entries);
+  BOOST_CHECK_EQUAL(snapshot.size(), 4);
+
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/"), root);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A"), a);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B"), a);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B/C"), abc);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B/C/D/E/F/G"), abc);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/BB/C"), a);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/X/Y"), root);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/X/Y/Z"), xyz);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/Q"), root);
+
+  Name name("/A/B/C/D");
+  name_tree::HashContext hashes(name);
+  BOOST_CHECK_EQUAL(snapshot.findLongestPrefixMatch(name, hashes, 1), abc);
+  BOOST_CHECK_EQUAL(snapshot.findLongestPrefixMatch(name, hashes, 3), abc);
+  BOOST_CHECK(snapshot.findLongestPrefixMatch(name, hashes, 4) == nullptr);
+  BOOST_CHECK(snapshot.findLongestPrefixMatch("/Q", name_tree::HashContext("/Q"), 1) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(NoRoot)
+{
+  shared_ptr<Entry> a = this->insert("/A");
+
+  Snapshot snapshot(entries);
+  BOOST_CHECK(lpm(snapshot, "/B") == nullptr);
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B"), a);
+
+  Snapshot emptySnapshot;
+  BOOST_CHECK_EQUAL(emptySnapshot.size(), 0);
+  BOOST_CHECK(lpm(emptySnapshot, "/A") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ErasedEntry)
+{
+  shared_ptr<Entry> root = this->insert("/");
+  shared_ptr<Entry> a = this->insert("/A");
+  shared_ptr<Entry> ab = this->insert("/A/B");
+
+  Snapshot snapshot(entries);
+  entries.clear();
+
+  // an erased entry is skipped, even if it is still referenced
+  fib.erase("/A/B");
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B/C"), a);
+
+  ab.reset();
+  a.reset();
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B/C"), root);
+  BOOST_CHECK_EQUAL(snapshot.size(), 3);
+
+  // a re-inserted entry is not in the old snapshot
+  this->insert("/A");
+  BOOST_CHECK_EQUAL(lpm(snapshot, "/A/B/C"), root);
+}
+
+BOOST_AUTO_TEST_CASE(Builder)
+{
+  shared_ptr<Entry> root = this->insert("/");
+  shared_ptr<Entry> a = this->insert("/A");
+  shared_ptr<Entry> ab = this->insert("/A/B");
+  shared_ptr<const Snapshot> base = make_shared<Snapshot>(entries);
+
+  fib.erase("/A");
+  Snapshot::EntryMap newEntries;
+  shared_ptr<Entry> abc = fib.insert("/A/B/C").first;
+  newEntries.insert(std::make_pair(name_tree::computeHash("/A/B/C"), abc));
+  shared_ptr<Entry> x = fib.insert("/X").first;
+  newEntries.insert(std::make_pair(name_tree::computeHash("/X"), x));
+
+  Snapshot::Builder builder(base, newEntries);
+  size_t nSteps = 0;
+  while (!builder.build(1)) {
+    ++nSteps;
+    BOOST_REQUIRE_LT(nSteps, 100);
+  }
+  // each record is copied and indexed in its own step
+  BOOST_CHECK_GE(nSteps, 8);
+
+  shared_ptr<const Snapshot> snapshot = builder.getSnapshot();
+  BOOST_CHECK_EQUAL(snapshot->size(), 4);
+  BOOST_CHECK_EQUAL(lpm(*snapshot, "/A"), root);
+  BOOST_CHECK_EQUAL(lpm(*snapshot, "/A/B/C/D"), abc);
+  BOOST_CHECK_EQUAL(lpm(*snapshot, "/A/B/D"), ab);
+  BOOST_CHECK_EQUAL(lpm(*snapshot, "/X/Y"), x);
+
+  // the base snapshot is not changed
+  BOOST_CHECK_EQUAL(base->size(), 3);
+  BOOST_CHECK_EQUAL(lpm(*base, "/X/Y"), root);
+}
+
+BOOST_AUTO_TEST_CASE(ManyPrefixes)
+{
+  std::vector<shared_ptr<Entry>> storage;
+  for (int i = 0; i < 500; ++i) {
+    Name prefix("/P");
+    prefix.appendNumber(i);
+    if (i % 2 == 0) {
+      prefix.appendNumber(i * 3);
+    }
+    storage.push_back(this->insert(prefix));
+  }
+
+  Snapshot snapshot(entries);
+  for (int i = 0; i < 500; ++i) {
+    Name name("/P");
+    name.appendNumber(i).appendNumber(i * 3).append("data");
+    BOOST_CHECK_EQUAL(lpm(snapshot, name), storage[i]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fib
+} // namespace nfd
@@ -24,6 +24,7 @@
  */
 
 #include "table/fib.hpp"
+#include "fw/forwarder.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
 
 #include "tests/test-common.hpp"
@@ -36,8 +37,11 @@ BOOST_FIXTURE_TEST_SUITE(TableFib, BaseFixture)
 BOOST_AUTO_TEST_CASE(Entry)
 {
   Name prefix("ndn:/pxWhfFza");
+  Forwarder forwarder;
   shared_ptr<Face> face1 = make_shared<DummyFace>();
   shared_ptr<Face> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
 
   fib::Entry entry(prefix);
   BOOST_CHECK_EQUAL(entry.getPrefix(), prefix);
@@ -50,14 +54,14 @@ BOOST_AUTO_TEST_CASE(Entry)
   const fib::NextHopList& nexthops2 = entry.getNextHops();
   // [(face1,20)]
   BOOST_CHECK_EQUAL(nexthops2.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops2.begin()->getFace(), face1);
+  BOOST_CHECK_EQUAL(nexthops2.begin()->getFaceId(), face1->getId());
   BOOST_CHECK_EQUAL(nexthops2.begin()->getCost(), 20);
 
   entry.addNextHop(face1, 30);
   const fib::NextHopList& nexthops3 = entry.getNextHops();
   // [(face1,30)]
   BOOST_CHECK_EQUAL(nexthops3.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops3.begin()->getFace(), face1);
+  BOOST_CHECK_EQUAL(nexthops3.begin()->getFaceId(), face1->getId());
   BOOST_CHECK_EQUAL(nexthops3.begin()->getCost(), 30);
 
   entry.addNextHop(face2, 40);
@@ -70,11 +74,11 @@ BOOST_AUTO_TEST_CASE(Entry)
     ++i;
     switch (i) {
       case 0 :
-        BOOST_CHECK_EQUAL(it->getFace(), face1);
+        BOOST_CHECK_EQUAL(it->getFaceId(), face1->getId());
         BOOST_CHECK_EQUAL(it->getCost(), 30);
         break;
       case 1 :
-        BOOST_CHECK_EQUAL(it->getFace(), face2);
+        BOOST_CHECK_EQUAL(it->getFaceId(), face2->getId());
         BOOST_CHECK_EQUAL(it->getCost(), 40);
         break;
     }
@@ -90,11 +94,11 @@ BOOST_AUTO_TEST_CASE(Entry)
     ++i;
     switch (i) {
       case 0 :
-        BOOST_CHECK_EQUAL(it->getFace(), face2);
+        BOOST_CHECK_EQUAL(it->getFaceId(), face2->getId());
         BOOST_CHECK_EQUAL(it->getCost(), 10);
         break;
       case 1 :
-        BOOST_CHECK_EQUAL(it->getFace(), face1);
+        BOOST_CHECK_EQUAL(it->getFaceId(), face1->getId());
         BOOST_CHECK_EQUAL(it->getCost(), 30);
         break;
     }
@@ -104,14 +108,14 @@ BOOST_AUTO_TEST_CASE(Entry)
   const fib::NextHopList& nexthops6 = entry.getNextHops();
   // [(face2,10)]
   BOOST_CHECK_EQUAL(nexthops6.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops6.begin()->getFace(), face2);
+  BOOST_CHECK_EQUAL(nexthops6.begin()->getFaceId(), face2->getId());
   BOOST_CHECK_EQUAL(nexthops6.begin()->getCost(), 10);
 
   entry.removeNextHop(face1);
   const fib::NextHopList& nexthops7 = entry.getNextHops();
   // [(face2,10)]
   BOOST_CHECK_EQUAL(nexthops7.size(), 1);
-  BOOST_CHECK_EQUAL(nexthops7.begin()->getFace(), face2);
+  BOOST_CHECK_EQUAL(nexthops7.begin()->getFaceId(), face2->getId());
   BOOST_CHECK_EQUAL(nexthops7.begin()->getCost(), 10);
 
   entry.removeNextHop(face2);
@@ -200,8 +204,11 @@ BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
 
 BOOST_AUTO_TEST_CASE(RemoveNextHopFromAllEntries)
 {
+  Forwarder forwarder;
   shared_ptr<Face> face1 = make_shared<DummyFace>();
   shared_ptr<Face> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
   Name nameEmpty("ndn:/");
   Name nameA("ndn:/A");
   Name nameB("ndn:/B");
@@ -258,7 +265,7 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromAllEntries)
   BOOST_CHECK_EQUAL(entry->getPrefix(), nameA);
   const fib::NextHopList& nexthopsA = entry->getNextHops();
   BOOST_CHECK_EQUAL(nexthopsA.size(), 1);
-  BOOST_CHECK_EQUAL(nexthopsA.begin()->getFace(), face2);
+  BOOST_CHECK_EQUAL(nexthopsA.begin()->getFaceId(), face2->getId());
 
   entry = fib.findLongestPrefixMatch(nameB);
   BOOST_CHECK_EQUAL(entry->getPrefix(), nameEmpty);
@@ -268,7 +275,9 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromManyEntries)
 {
   NameTree nameTree(16);
   Fib fib(nameTree);
+  Forwarder forwarder;
   shared_ptr<Face> face1 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
 
   for (uint64_t i = 0; i < 300; ++i) {
     shared_ptr<fib::Entry> entry = fib.insert(Name("/P").appendVersion(i)).first;
@@ -280,6 +289,57 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromManyEntries)
   BOOST_CHECK_EQUAL(fib.size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(RemoveNextHopByFaceIndex, UnitTestTimeFixture)
+{
+  Forwarder forwarder;
+  Fib& fib = forwarder.getFib();
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  const size_t nEntries = Fib::REMOVAL_CHUNK_SIZE * 2 + 10;
+  for (uint64_t i = 0; i < nEntries; ++i) {
+    shared_ptr<fib::Entry> entry = fib.insert(Name("/P").appendVersion(i)).first;
+    entry->addNextHop(face1, 0);
+    if (i % 2 == 0) {
+      entry->addNextHop(face2, 10);
+    }
+  }
+  fib.insert("/Q").first->addNextHop(face2, 0);
+  fib.insert("/R").first->addNextHop(face2, 0);
+  fib.findExactMatch("/R")->removeNextHop(face2);
+  BOOST_CHECK_EQUAL(fib.size(), nEntries + 2);
+
+  // face2 has fewer routes than a chunk, they are removed immediately
+  face2->close();
+  BOOST_CHECK(!fib.hasPendingNextHopRemovals());
+  BOOST_CHECK_EQUAL(fib.size(), nEntries + 1); // /Q is erased
+  BOOST_CHECK_EQUAL(fib.findExactMatch(Name("/P").appendVersion(0))->getNextHops().size(), 1);
+
+  // face1 has more routes than a chunk, they are removed in several chunks
+  FaceId faceId1 = face1->getId();
+  face1->close();
+  BOOST_CHECK(fib.hasPendingNextHopRemovals());
+  BOOST_CHECK_EQUAL(fib.size(), nEntries + 1 - Fib::REMOVAL_CHUNK_SIZE);
+
+  // remaining NextHops of face1 no longer resolve to a face
+  size_t nRemaining = 0;
+  for (const fib::Entry& entry : fib) {
+    for (const fib::NextHop& nexthop : entry.getNextHops()) {
+      if (nexthop.getFaceId() == faceId1) {
+        ++nRemaining;
+        BOOST_CHECK(forwarder.getFaceTable().find(faceId1) == nullptr);
+      }
+    }
+  }
+  BOOST_CHECK_GT(nRemaining, 0);
+
+  this->advanceClocks(time::milliseconds(1), 5);
+  BOOST_CHECK(!fib.hasPendingNextHopRemovals());
+  BOOST_CHECK_EQUAL(fib.size(), 1); // /R has no nexthops, but was not affected
+}
+
 void
 validateFindExactMatch(const Fib& fib, const Name& target)
 {
@@ -400,6 +460,176 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(PrefixFromNameTree)
+{
+  NameTree nameTree;
+  nameTree.setComponentInterning(true);
+  Fib fib(nameTree);
+
+  shared_ptr<fib::Entry> entry = fib.insert("ndn:/A/B").first;
+  BOOST_CHECK_EQUAL(entry->getPrefix(), "ndn:/A/B");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("ndn:/A/B/C")->getPrefix(), "ndn:/A/B");
+
+  // an erased entry keeps its prefix
+  fib.erase("ndn:/A/B");
+  BOOST_CHECK_EQUAL(entry->getPrefix(), "ndn:/A/B");
+}
+
+BOOST_AUTO_TEST_CASE(LpmCache)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  BOOST_CHECK_GT(fib.getLpmCacheSize(), 0);
+  shared_ptr<fib::Entry> entryA = fib.insert("/A").first;
+  uint64_t nInvalidations = fib.getLpmCacheCounters().nInvalidations;
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C"), entryA);
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nMisses, 1);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C"), entryA);
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nHits, 1);
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X")->getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X")->getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nHits, 2);
+
+  // insert invalidates
+  shared_ptr<fib::Entry> entryAB = fib.insert("/A/B").first;
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nInvalidations, nInvalidations + 1);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C"), entryAB);
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nMisses, 3);
+
+  // inserting an existing entry does not invalidate
+  fib.insert("/A/B");
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nInvalidations, nInvalidations + 1);
+
+  // erase invalidates, including when the last nexthop is removed
+  Forwarder forwarder;
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  entryAB->addNextHop(face1, 0);
+  fib.removeNextHopFromAllEntries(face1);
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nInvalidations, nInvalidations + 3);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C")->getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X")->getPrefix(), "/");
+
+  fib.setLpmCacheSize(0);
+  BOOST_CHECK_EQUAL(fib.getLpmCacheSize(), 0);
+  uint64_t nHits = fib.getLpmCacheCounters().nHits;
+  fib.findLongestPrefixMatch("/X");
+  fib.findLongestPrefixMatch("/X");
+  BOOST_CHECK_EQUAL(fib.getLpmCacheCounters().nHits, nHits);
+}
+
+BOOST_AUTO_TEST_CASE(LpmCacheConsistency)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.setLpmCacheSize(3); // small cache causes frequent slot conflicts
+
+  std::vector<Name> names;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      names.push_back(Name("/P").appendNumber(i).appendNumber(j));
+    }
+  }
+
+  for (size_t round = 0; round < 200; ++round) {
+    const Name& prefix = names[(round * 7) % names.size()].getPrefix(1 + round % 3);
+    if (round % 5 == 0) {
+      fib.erase(prefix);
+    }
+    else if (round % 5 == 1) {
+      fib.insert(prefix);
+    }
+    // PIT entries in NameTree do not affect FIB lookups
+    nameTree.lookup(Name(prefix).append("pit"));
+
+    for (const Name& name : names) {
+      shared_ptr<name_tree::Entry> nte = nameTree.findLongestPrefixMatch(name,
+        [] (const name_tree::Entry& entry) { return static_cast<bool>(entry.getFibEntry()); });
+      Name expected = static_cast<bool>(nte) ? nte->getPrefix() : Name();
+      BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name)->getPrefix(), expected);
+    }
+  }
+  BOOST_CHECK_GT(fib.getLpmCacheCounters().nHits, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(Snapshot, UnitTestTimeFixture)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.setLpmCacheSize(0);
+  shared_ptr<const fib::Snapshot> snapshot0 = fib.getSnapshot();
+  BOOST_REQUIRE(snapshot0 != nullptr);
+  BOOST_CHECK_EQUAL(snapshot0->size(), 0);
+
+  // entries inserted since the snapshot was compiled are found before the rebuild
+  fib.insert("/A");
+  fib.insert("/A/B/C");
+  BOOST_CHECK_EQUAL(fib.getSnapshot(), snapshot0);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B")->getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D")->getPrefix(), "/A/B/C");
+
+  this->advanceClocks(time::milliseconds(10), Fib::SNAPSHOT_DELAY);
+  shared_ptr<const fib::Snapshot> snapshot = fib.getSnapshot();
+  BOOST_CHECK_NE(snapshot, snapshot0);
+  BOOST_CHECK_EQUAL(snapshot->size(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B")->getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.getSnapshot(), snapshot);
+
+  // the snapshot stays in use during a batch of changes, which produces one new snapshot
+  fib.insert("/X");
+  BOOST_CHECK_EQUAL(fib.getSnapshot(), snapshot);
+  this->advanceClocks(time::milliseconds(10), Fib::SNAPSHOT_DELAY / 2);
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.getSnapshot(), snapshot);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B")->getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D")->getPrefix(), "/A/B/C");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X/Y")->getPrefix(), "/X");
+
+  this->advanceClocks(time::milliseconds(10), Fib::SNAPSHOT_DELAY / 2);
+  shared_ptr<const fib::Snapshot> snapshot2 = fib.getSnapshot();
+  BOOST_CHECK_NE(snapshot2, snapshot);
+  BOOST_CHECK_EQUAL(snapshot2->size(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B")->getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D")->getPrefix(), "/A/B/C");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X/Y")->getPrefix(), "/X");
+
+  // an erased and re-inserted prefix is found
+  fib.erase("/X");
+  fib.insert("/X");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X/Y")->getPrefix(), "/X");
+  this->advanceClocks(time::milliseconds(10), Fib::SNAPSHOT_DELAY);
+  BOOST_CHECK_EQUAL(fib.getSnapshot()->size(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X/Y")->getPrefix(), "/X");
+}
+
+BOOST_FIXTURE_TEST_CASE(SnapshotChunks, UnitTestTimeFixture)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.setLpmCacheSize(0);
+  size_t nEntries = Fib::SNAPSHOT_CHUNK_SIZE * 3;
+  for (size_t i = 0; i < nEntries; ++i) {
+    fib.insert(Name("/P").appendNumber(i));
+  }
+
+  // the rebuild takes several chunks, and lookups are correct between chunks
+  Name name7("/P");
+  name7.appendNumber(7);
+  int nTicks = 0;
+  while (fib.getSnapshot()->size() != nEntries) {
+    BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(Name(name7).append("x"))->getPrefix(), name7);
+    this->advanceClocks(time::milliseconds(1));
+    BOOST_REQUIRE_LT(++nTicks, 1000);
+  }
+  for (size_t i = 0; i < nEntries; i += 97) {
+    Name name("/P");
+    name.appendNumber(i);
+    BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name)->getPrefix(), name);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Iterator)
 {
   NameTree nameTree;
@@ -55,6 +55,18 @@ BOOST_AUTO_TEST_CASE(Get_Parent)
 
   shared_ptr<measurements::Entry> entry0c = measurements.getParent(*entryA);
   BOOST_CHECK_EQUAL(entry0, entry0c);
+  BOOST_CHECK(measurements.getParent(*entry0) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(NameFromInternedNameTree)
+{
+  NameTree nameTree;
+  nameTree.setComponentInterning(true);
+  Measurements measurements(nameTree);
+
+  shared_ptr<measurements::Entry> entryAB = measurements.get("ndn:/A/B");
+  BOOST_CHECK_EQUAL(entryAB->getName(), "ndn:/A/B");
+  BOOST_CHECK_EQUAL(measurements.getParent(*entryAB)->getName(), "ndn:/A");
 }
 
 class DummyStrategyInfo1 : public fw::StrategyInfo
@@ -189,7 +201,39 @@ BOOST_FIXTURE_TEST_CASE(EraseNameTreeEntry, UnitTestTimeFixture)
   size_t nNameTreeEntriesBefore = nameTree.size();
 
   shared_ptr<measurements::Entry> entry = measurements.get("/A");
-  this->advanceClocks(Measurements::getInitialLifetime() + time::milliseconds(10));
+  this->advanceClocks(Measurements::getInitialLifetime() + Measurements::getSweepInterval());
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+  BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
+}
+
+BOOST_FIXTURE_TEST_CASE(Sweep, UnitTestTimeFixture)
+{
+  NameTree nameTree;
+  Measurements measurements(nameTree);
+  size_t nNameTreeEntriesBefore = nameTree.size();
+
+  // more entries than one sweep chunk
+  const size_t N_ENTRIES = Measurements::SWEEP_CHUNK_SIZE * 2 + 1;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    measurements.get(Name("/A").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(measurements.size(), N_ENTRIES);
+
+  // extending lifetime many times does not move the entry in the expiry index,
+  // and the entry survives the sweep of its original bucket
+  shared_ptr<measurements::Entry> entryB = measurements.get("/B");
+  for (int i = 0; i < 100; ++i) {
+    measurements.extendLifetime(*entryB, time::seconds(10));
+  }
+  entryB.reset();
+
+  this->advanceClocks(time::milliseconds(100),
+                      Measurements::getInitialLifetime() + Measurements::getSweepInterval());
+  BOOST_CHECK_EQUAL(measurements.size(), 1);
+  BOOST_CHECK(measurements.findExactMatch("/B") != nullptr);
+  BOOST_CHECK(measurements.findExactMatch(Name("/A").appendNumber(0)) == nullptr);
+
+  this->advanceClocks(time::milliseconds(100), time::seconds(10) + Measurements::getSweepInterval());
   BOOST_CHECK_EQUAL(measurements.size(), 0);
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
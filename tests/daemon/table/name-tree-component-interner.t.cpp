@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/name-tree-component-interner.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace name_tree {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_FIXTURE_TEST_SUITE(TableNameTreeComponentInterner, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(AcquireRelease)
+{
+  ComponentInterner interner;
+  name::Component a("A");
+  name::Component b("B");
+
+  BOOST_CHECK_EQUAL(interner.find(a, 1), ComponentInterner::INVALID_ID);
+  ComponentInterner::Id idA = interner.acquire(a, 1);
+  ComponentInterner::Id idB = interner.acquire(b, 2);
+  BOOST_CHECK_NE(idA, idB);
+  BOOST_CHECK_EQUAL(interner.size(), 2);
+  BOOST_CHECK_EQUAL(interner.find(a, 1), idA);
+  BOOST_CHECK_EQUAL(interner.get(idA), a);
+  BOOST_CHECK_NE(interner.get(idA).wire(), a.wire());
+
+  BOOST_CHECK_EQUAL(interner.acquire(name::Component("A"), 1), idA);
+  BOOST_CHECK_EQUAL(interner.getRefCount(idA), 2);
+  interner.release(idA);
+  BOOST_CHECK_EQUAL(interner.find(a, 1), idA);
+  interner.release(idA);
+  BOOST_CHECK_EQUAL(interner.find(a, 1), ComponentInterner::INVALID_ID);
+  BOOST_CHECK_EQUAL(interner.size(), 1);
+
+  // Id is reused
+  BOOST_CHECK_EQUAL(interner.acquire(name::Component("C"), 3), idA);
+  BOOST_CHECK_EQUAL(interner.find(b, 2), idB);
+}
+
+BOOST_AUTO_TEST_CASE(HashCollision)
+{
+  ComponentInterner interner;
+  name::Component a("A");
+  name::Component b("B");
+
+  ComponentInterner::Id idA = interner.acquire(a, 7);
+  BOOST_CHECK_EQUAL(interner.find(b, 7), ComponentInterner::INVALID_ID);
+  ComponentInterner::Id idB = interner.acquire(b, 7);
+  BOOST_CHECK_NE(idA, idB);
+  BOOST_CHECK_EQUAL(interner.find(a, 7), idA);
+  BOOST_CHECK_EQUAL(interner.find(b, 7), idB);
+
+  interner.release(idA);
+  BOOST_CHECK_EQUAL(interner.find(a, 7), ComponentInterner::INVALID_ID);
+  BOOST_CHECK_EQUAL(interner.find(b, 7), idB);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace name_tree
+} // namespace nfd
@@ -48,6 +48,110 @@ BOOST_AUTO_TEST_CASE(Hash)
   BOOST_CHECK_EQUAL(hashSet.size(), prefix.size() + 1);
 }
 
+BOOST_AUTO_TEST_CASE(PacketHashContext)
+{
+  Name prefix("/nohello/world/ndn/research");
+  name_tree::HashContext hashes(prefix);
+  BOOST_CHECK_EQUAL(hashes.size(), prefix.size());
+  std::vector<size_t> hashSet = name_tree::computeHashSet(prefix);
+  for (size_t i = 0; i <= prefix.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes.getHash(i), hashSet[i]);
+  }
+  BOOST_CHECK_EQUAL(hashes.getFullHash(), name_tree::computeHash(prefix));
+  BOOST_CHECK(hashes.matches(prefix));
+  BOOST_CHECK(hashes.matches(Name("/nohello/world/ndn/research")));
+  BOOST_CHECK(!hashes.matches(Name("/nohello/world/ndn")));
+
+  // the context is recomputed in place for another Name
+  name_tree::HashContext ctx;
+  BOOST_CHECK(!ctx.matches(Name()));
+  ctx.reset(prefix);
+  BOOST_CHECK(ctx.matches(prefix));
+  BOOST_CHECK_EQUAL(ctx.getFullHash(), hashes.getFullHash());
+  ctx.reset("/nohello/world");
+  BOOST_CHECK(!ctx.matches(prefix));
+  BOOST_CHECK_EQUAL(ctx.size(), 2);
+  BOOST_CHECK_EQUAL(ctx.getFullHash(), hashes.getHash(2));
+
+  // NameTree accepts the context in place of the Name hash
+  NameTree nt;
+  shared_ptr<name_tree::Entry> entry = nt.lookup(prefix, hashes);
+  BOOST_CHECK_EQUAL(nt.size(), prefix.size() + 1);
+  BOOST_CHECK_EQUAL(entry->getHash(), hashes.getFullHash());
+  BOOST_CHECK_EQUAL(nt.lookup(prefix), entry);
+  BOOST_CHECK_EQUAL(nt.findExactMatch(prefix, hashes), entry);
+  BOOST_CHECK_EQUAL(nt.findExactMatch(prefix.getPrefix(2)), entry->getParent()->getParent());
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name(prefix).append("x"),
+                                              name_tree::HashContext(Name(prefix).append("x"))),
+                    entry);
+}
+
+BOOST_AUTO_TEST_CASE(ComponentInterning)
+{
+  NameTree nt;
+  nt.setComponentInterning(true);
+  BOOST_CHECK(nt.isComponentInterning());
+  const name_tree::ComponentInterner& interner = nt.getComponentInterner();
+
+  shared_ptr<name_tree::Entry> abc = nt.lookup("/A/B/C");
+  shared_ptr<name_tree::Entry> xbc = nt.lookup("/X/B/C");
+  BOOST_CHECK_EQUAL(nt.size(), 6);
+  BOOST_CHECK_EQUAL(interner.size(), 4); // A, B, C, X
+  BOOST_CHECK_EQUAL(abc->getPrefix(), "/A/B/C");
+  BOOST_CHECK_EQUAL(xbc->getPrefix(), "/X/B/C");
+  BOOST_CHECK_EQUAL(abc->getComponentId(), xbc->getComponentId());
+  BOOST_CHECK_EQUAL(interner.getRefCount(abc->getComponentId()), 2);
+  BOOST_CHECK_EQUAL(nt.findExactMatch(Name())->getComponentId(),
+                    name_tree::ComponentInterner::INVALID_ID);
+
+  // an Interest name is matched by component Id
+  shared_ptr<Interest> interest = makeInterest("/A/B/C/D");
+  BOOST_CHECK_EQUAL(nt.lookup(interest->getName())->getParent(), abc);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/A/B/C"), abc);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/X/B/C/D/E"), xbc);
+  BOOST_CHECK_EQUAL(interner.size(), 5);
+
+  // an erased entry holds its components until it is destroyed
+  BOOST_CHECK(nt.eraseEntryIfEmpty(nt.findExactMatch("/A/B/C/D")));
+  BOOST_CHECK_EQUAL(nt.size(), 4); // /, /X, /X/B, /X/B/C
+  BOOST_CHECK_EQUAL(interner.size(), 4); // A, B, C held by abc, and X
+  BOOST_CHECK_EQUAL(abc->getPrefix(), "/A/B/C");
+  BOOST_CHECK_EQUAL(interner.getRefCount(xbc->getComponentId()), 2);
+  abc.reset();
+  BOOST_CHECK_EQUAL(interner.size(), 3); // X, B, C
+  BOOST_CHECK_EQUAL(interner.getRefCount(xbc->getComponentId()), 1);
+  BOOST_CHECK(nt.eraseEntryIfEmpty(xbc));
+  xbc.reset();
+  BOOST_CHECK_EQUAL(interner.size(), 0);
+
+  // entries created without interning are still found
+  nt.setComponentInterning(false);
+  shared_ptr<name_tree::Entry> plain = nt.lookup("/A/B");
+  nt.setComponentInterning(true);
+  BOOST_CHECK_EQUAL(nt.lookup("/A/B"), plain);
+  BOOST_CHECK_EQUAL(interner.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ComponentInterningOff)
+{
+  NameTree nt;
+  nt.setComponentInterning(true);
+  shared_ptr<name_tree::Entry> ab = nt.lookup("/A/B");
+  nt.setComponentInterning(false);
+
+  // interned entries are compared by Name components
+  BOOST_CHECK_EQUAL(nt.lookup("/A/B"), ab);
+  shared_ptr<name_tree::Entry> abc = nt.lookup("/A/B/C");
+  BOOST_CHECK_EQUAL(abc->getParent(), ab);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK_EQUAL(abc->getComponentId(), name_tree::ComponentInterner::INVALID_ID);
+  BOOST_CHECK_EQUAL(abc->getPrefix(), "/A/B/C");
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/A/B"), ab);
+  BOOST_CHECK(nt.findExactMatch("/A/X") == nullptr);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/A/B/X"), ab);
+  BOOST_CHECK_EQUAL(ab->getPrefix(), "/A/B");
+}
+
 BOOST_AUTO_TEST_CASE(Entry)
 {
   Name prefix("ndn:/named-data/research/abc/def/ghi");
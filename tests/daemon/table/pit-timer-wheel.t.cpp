@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/pit-timer-wheel.hpp"
+#include "table/pit-entry.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace pit {
+namespace tests {
+
+using namespace nfd::tests;
+
+class TimerWheelFixture : public UnitTestTimeFixture
+{
+protected:
+  TimerWheelFixture()
+    : wheel(bind(&TimerWheelFixture::expire, this, _1))
+  {
+  }
+
+  shared_ptr<Entry>
+  makeEntry(const Name& name)
+  {
+    return make_shared<Entry>(*makeInterest(name));
+  }
+
+private:
+  void
+  expire(const shared_ptr<Entry>& entry)
+  {
+    expired.push_back(entry->getName());
+  }
+
+protected:
+  TimerWheel wheel;
+  std::vector<Name> expired;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TablePitTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Expire)
+{
+  shared_ptr<Entry> entryA = makeEntry("/A");
+  shared_ptr<Entry> entryB = makeEntry("/B");
+  shared_ptr<Entry> entryC = makeEntry("/C");
+  shared_ptr<Entry> entryD = makeEntry("/D");
+
+  // deadlines on level 0, level 1, level 2, and in the past
+  wheel.arm(*entryA, time::milliseconds(100));
+  wheel.arm(*entryB, time::milliseconds(4000));
+  wheel.arm(*entryC, time::milliseconds(70000));
+  wheel.arm(*entryD, time::milliseconds(-10));
+  BOOST_CHECK_EQUAL(wheel.size(), 4);
+
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(99));
+  BOOST_REQUIRE_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(expired[0], "/D");
+
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(2));
+  BOOST_REQUIRE_EQUAL(expired.size(), 2);
+  BOOST_CHECK_EQUAL(expired[1], "/A");
+
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(3890));
+  BOOST_CHECK_EQUAL(expired.size(), 2);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(20));
+  BOOST_REQUIRE_EQUAL(expired.size(), 3);
+  BOOST_CHECK_EQUAL(expired[2], "/B");
+
+  this->advanceClocks(time::milliseconds(100), time::milliseconds(65800));
+  BOOST_CHECK_EQUAL(expired.size(), 3);
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(200));
+  BOOST_REQUIRE_EQUAL(expired.size(), 4);
+  BOOST_CHECK_EQUAL(expired[3], "/C");
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CancelRearm)
+{
+  shared_ptr<Entry> entryA = makeEntry("/A");
+  shared_ptr<Entry> entryB = makeEntry("/B");
+  shared_ptr<Entry> entryC = makeEntry("/C");
+
+  wheel.arm(*entryA, time::milliseconds(50));
+  wheel.arm(*entryB, time::milliseconds(50));
+  wheel.arm(*entryC, time::milliseconds(50));
+  wheel.cancel(*entryB);
+  wheel.cancel(*entryB);
+  wheel.arm(*entryC, time::milliseconds(500));
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  this->advanceClocks(time::milliseconds(5), time::milliseconds(100));
+  BOOST_REQUIRE_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(expired[0], "/A");
+
+  this->advanceClocks(time::milliseconds(5), time::milliseconds(500));
+  BOOST_REQUIRE_EQUAL(expired.size(), 2);
+  BOOST_CHECK_EQUAL(expired[1], "/C");
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CancelWithinBatch)
+{
+  shared_ptr<Entry> entryA = makeEntry("/A");
+  shared_ptr<Entry> entryB = makeEntry("/B");
+
+  // both entries expire on the same tick, and whichever expires first cancels the other
+  TimerWheel wheel2([&] (const shared_ptr<Entry>& entry) {
+    expired.push_back(entry->getName());
+    wheel2.cancel(entry == entryA ? *entryB : *entryA);
+  });
+  wheel2.arm(*entryA, time::milliseconds(20));
+  wheel2.arm(*entryB, time::milliseconds(20));
+
+  this->advanceClocks(time::milliseconds(5), time::milliseconds(100));
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(wheel2.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace pit
+} // namespace nfd
@@ -151,6 +151,59 @@ BOOST_AUTO_TEST_CASE(EntryInOutRecords)
   BOOST_CHECK(entry.getOutRecord(*face2) == entry.getOutRecords().end());
 }
 
+BOOST_AUTO_TEST_CASE(EntryRecordsSpill)
+{
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 5; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+  }
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/Vq9JfHmP");
+  pit::Entry entry(*interest);
+
+  // insert more InRecords than can be stored inline
+  std::vector<pit::InRecordCollection::iterator> inIts;
+  for (const shared_ptr<Face>& face : faces) {
+    inIts.push_back(entry.insertOrUpdateInRecord(face, *interest));
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 5);
+  BOOST_CHECK_EQUAL(std::distance(entry.getInRecords().begin(), entry.getInRecords().end()), 5);
+
+  // handles stay valid after later insertions
+  const pit::InRecord* inRecord4 = &*inIts[4];
+  for (size_t i = 0; i < faces.size(); ++i) {
+    BOOST_CHECK_EQUAL(inIts[i]->getFace(), faces[i]);
+    BOOST_CHECK(inIts[i] == entry.getInRecord(*faces[i]));
+  }
+
+  // insert and delete OutRecords across inline and spilled storage
+  std::vector<pit::OutRecordCollection::iterator> outIts;
+  for (const shared_ptr<Face>& face : faces) {
+    outIts.push_back(entry.insertOrUpdateOutRecord(face, *interest));
+  }
+  entry.deleteOutRecord(*faces[0]);
+  entry.deleteOutRecord(*faces[3]);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 3);
+  BOOST_CHECK_EQUAL(outIts[1]->getFace(), faces[1]);
+  BOOST_CHECK_EQUAL(outIts[2]->getFace(), faces[2]);
+  BOOST_CHECK_EQUAL(outIts[4]->getFace(), faces[4]);
+  BOOST_CHECK(entry.getOutRecord(*faces[0]) == entry.getOutRecords().end());
+  BOOST_CHECK(entry.getOutRecord(*faces[3]) == entry.getOutRecords().end());
+
+  // vacated slots are reused without moving remaining records
+  pit::OutRecordCollection::iterator out0 = entry.insertOrUpdateOutRecord(faces[0], *interest);
+  pit::OutRecordCollection::iterator out3 = entry.insertOrUpdateOutRecord(faces[3], *interest);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 5);
+  BOOST_CHECK_EQUAL(out0->getFace(), faces[0]);
+  BOOST_CHECK_EQUAL(out3->getFace(), faces[3]);
+  BOOST_CHECK_EQUAL(outIts[4]->getFace(), faces[4]);
+  BOOST_CHECK_EQUAL(&*inIts[4], inRecord4);
+
+  entry.deleteInRecords();
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 0);
+  BOOST_CHECK(entry.getInRecords().begin() == entry.getInRecords().end());
+}
+
 BOOST_AUTO_TEST_CASE(EntryNonce)
 {
   shared_ptr<Face> face1 = make_shared<DummyFace>();
@@ -394,6 +447,58 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(SelectorIndex)
+{
+  NameTree nameTree;
+  Pit pit(nameTree);
+  Name name("/fdA3Kb9sm");
+
+  // selector variants are inserted before the entry without selectors
+  std::vector<shared_ptr<pit::Entry>> variants;
+  for (int i = 1; i <= 4; ++i) {
+    shared_ptr<Interest> interest = makeInterest(name);
+    interest->setMinSuffixComponents(i);
+    std::pair<shared_ptr<pit::Entry>, bool> insertResult = pit.insert(*interest);
+    BOOST_CHECK_EQUAL(insertResult.second, true);
+    BOOST_CHECK_NE(insertResult.first->getSelectorHash(), 0);
+    variants.push_back(insertResult.first);
+  }
+
+  shared_ptr<Interest> plainInterest = makeInterest(name);
+  shared_ptr<pit::Entry> plain = pit.insert(*plainInterest).first;
+  BOOST_CHECK_EQUAL(plain->getSelectorHash(), 0);
+  BOOST_CHECK_EQUAL(pit.size(), 5);
+
+  shared_ptr<name_tree::Entry> nte = nameTree.findExactMatch(name);
+  BOOST_REQUIRE(nte != nullptr);
+  BOOST_CHECK_EQUAL(nte->getPitEntries().front(), plain);
+  BOOST_CHECK_EQUAL(nte->getPitSelectorHashes().size(), 5);
+  BOOST_CHECK_EQUAL(nte->getPitSelectorHashes().front(), 0);
+
+  // every variant is found again
+  for (int i = 1; i <= 4; ++i) {
+    shared_ptr<Interest> interest = makeInterest(name);
+    interest->setMinSuffixComponents(i);
+    std::pair<shared_ptr<pit::Entry>, bool> insertResult = pit.insert(*interest);
+    BOOST_CHECK_EQUAL(insertResult.second, false);
+    BOOST_CHECK_EQUAL(insertResult.first, variants[i - 1]);
+  }
+  BOOST_CHECK_EQUAL(pit.insert(*makeInterest(name)).first, plain);
+  BOOST_CHECK_EQUAL(pit.size(), 5);
+
+  // the entry without selectors stays first after erasing another entry
+  pit.erase(variants[0]);
+  BOOST_CHECK_EQUAL(nte->getPitEntries().front(), plain);
+  BOOST_CHECK_EQUAL(nte->getPitSelectorHashes().size(), 4);
+
+  pit.erase(plain);
+  BOOST_CHECK_EQUAL(nte->getPitSelectorHashes().size(), 3);
+  BOOST_CHECK_NE(nte->getPitSelectorHashes().front(), 0);
+  BOOST_CHECK_EQUAL(pit.insert(*makeInterest(name)).second, true);
+  BOOST_CHECK_EQUAL(pit.insert(*makeInterest(name)).second, false);
+  BOOST_CHECK_EQUAL(pit.size(), 4);
+}
+
 BOOST_AUTO_TEST_CASE(FindAllDataMatches)
 {
   Name nameA   ("ndn:/A");
@@ -495,6 +600,115 @@ BOOST_AUTO_TEST_CASE(Iterator)
   }
 }
 
+BOOST_AUTO_TEST_CASE(LimitReject)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  pit.setLimit(2);
+
+  shared_ptr<Interest> interestA = makeInterest("/A");
+  shared_ptr<Interest> interestB = makeInterest("/B");
+  shared_ptr<Interest> interestC = makeInterest("/C");
+
+  BOOST_CHECK(pit.insert(*interestA, 1).second);
+  BOOST_CHECK(pit.insert(*interestB, 1).second);
+
+  std::pair<shared_ptr<Entry>, bool> insertResult = pit.insert(*interestC, 1);
+  BOOST_CHECK(insertResult.first == nullptr);
+  BOOST_CHECK_EQUAL(insertResult.second, false);
+  BOOST_CHECK_EQUAL(pit.size(), 2);
+  BOOST_CHECK_EQUAL(pit.getNRejected(), 1);
+  BOOST_CHECK(nameTree.findExactMatch("/C") == nullptr);
+
+  // an Interest that joins an existing entry is not rejected
+  insertResult = pit.insert(*makeInterest("/A"), 2);
+  BOOST_REQUIRE(insertResult.first != nullptr);
+  BOOST_CHECK_EQUAL(insertResult.second, false);
+  BOOST_CHECK_EQUAL(pit.getNRejected(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(LimitEvictOldest)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  pit.setLimit(2);
+  pit.setOverloadPolicy(OVERLOAD_EVICT_OLDEST);
+
+  std::vector<Name> evicted;
+  pit.beforeEvict.connect([&] (const shared_ptr<Entry>& entry) {
+    evicted.push_back(entry->getName());
+  });
+
+  pit.insert(*makeInterest("/A"));
+  pit.insert(*makeInterest("/B"));
+  BOOST_CHECK(pit.insert(*makeInterest("/C")).second);
+  BOOST_CHECK(pit.insert(*makeInterest("/D")).second);
+
+  BOOST_CHECK_EQUAL(pit.size(), 2);
+  BOOST_CHECK_EQUAL(pit.getNEvicted(), 2);
+  BOOST_REQUIRE_EQUAL(evicted.size(), 2);
+  BOOST_CHECK_EQUAL(evicted[0], "/A");
+  BOOST_CHECK_EQUAL(evicted[1], "/B");
+  BOOST_CHECK(nameTree.findExactMatch("/A") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(LimitEvictSoonestExpiring, UnitTestTimeFixture)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  pit.setLimit(3);
+  pit.setOverloadPolicy(OVERLOAD_EVICT_SOONEST_EXPIRING);
+
+  shared_ptr<Entry> entryA = pit.insert(*makeInterest("/A")).first;
+  shared_ptr<Entry> entryB = pit.insert(*makeInterest("/B")).first;
+  shared_ptr<Entry> entryC = pit.insert(*makeInterest("/C")).first;
+  pit.setExpiryTimer(*entryA, time::seconds(4));
+  pit.setExpiryTimer(*entryB, time::milliseconds(100));
+  pit.setExpiryTimer(*entryC, time::seconds(2));
+
+  BOOST_CHECK(pit.insert(*makeInterest("/D")).second);
+  BOOST_CHECK_EQUAL(pit.size(), 3);
+  BOOST_CHECK(nameTree.findExactMatch("/B") == nullptr);
+
+  // the evicted entry does not expire
+  int nExpired = 0;
+  pit.onExpire.connect([&] (const shared_ptr<Entry>&) { ++nExpired; });
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(500));
+  BOOST_CHECK_EQUAL(nExpired, 0);
+}
+
+BOOST_AUTO_TEST_CASE(FaceQuota)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  pit.setFaceQuota(2);
+  pit.setLimit(10);
+  pit.setOverloadPolicy(OVERLOAD_EVICT_OLDEST);
+
+  shared_ptr<Entry> entryA = pit.insert(*makeInterest("/A"), 1).first;
+  pit.insert(*makeInterest("/B"), 1);
+  pit.insert(*makeInterest("/C"), 2);
+  BOOST_CHECK_EQUAL(pit.getFaceUsage(1), 2);
+  BOOST_CHECK_EQUAL(pit.getFaceUsage(2), 1);
+  BOOST_CHECK_EQUAL(pit.getFaceUsage(3), 0);
+
+  // face 1 is over quota, and no entry is evicted on its behalf
+  BOOST_CHECK(pit.insert(*makeInterest("/D"), 1).first == nullptr);
+  BOOST_CHECK_EQUAL(pit.size(), 3);
+  BOOST_CHECK_EQUAL(pit.getNRejected(), 1);
+  BOOST_CHECK_EQUAL(pit.getNEvicted(), 0);
+
+  // other faces and internal insertions are unaffected
+  BOOST_CHECK(pit.insert(*makeInterest("/E"), 2).second);
+  BOOST_CHECK(pit.insert(*makeInterest("/F")).second);
+
+  // erasing an entry returns quota to its face
+  pit.erase(entryA);
+  BOOST_CHECK_EQUAL(pit.getFaceUsage(1), 1);
+  BOOST_CHECK(pit.insert(*makeInterest("/D"), 1).second);
+  BOOST_CHECK_EQUAL(pit.getFaceUsages().size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -124,6 +124,65 @@ BOOST_AUTO_TEST_CASE(Effective)
   BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/D")  .getName(), nameQ);
 }
 
+BOOST_AUTO_TEST_CASE(EffectiveCached)
+{
+  Forwarder forwarder;
+  Name nameP("ndn:/strategy/P");
+  Name nameQ("ndn:/strategy/Q");
+  shared_ptr<Strategy> strategyP = make_shared<DummyStrategy>(ref(forwarder), nameP);
+  shared_ptr<Strategy> strategyQ = make_shared<DummyStrategy>(ref(forwarder), nameQ);
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  Pit& pit = forwarder.getPit();
+  table.install(strategyP);
+  table.install(strategyQ);
+
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+  shared_ptr<pit::Entry> pitABC = pit.insert(*makeInterest("ndn:/A/B/C")).first;
+  shared_ptr<pit::Entry> pitAD = pit.insert(*makeInterest("ndn:/A/D")).first;
+  shared_ptr<pit::Entry> pitE = pit.insert(*makeInterest("ndn:/E")).first;
+  // { '/'=>P }
+
+  // repeated lookups are served from the cache on NameTree entries
+  for (int i = 0; i < 2; ++i) {
+    BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyP.get());
+    BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitAD), strategyP.get());
+    BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitE), strategyP.get());
+  }
+
+  BOOST_CHECK(table.insert("ndn:/A", nameQ));
+  // { '/'=>P, '/A'=>Q }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyQ.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitAD), strategyQ.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitE), strategyP.get());
+
+  BOOST_CHECK(table.insert("ndn:/A/B", nameP));
+  // { '/'=>P, '/A'=>Q, '/A/B'=>P }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyP.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitAD), strategyQ.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy("ndn:/A/B/C/F"), strategyP.get());
+
+  BOOST_CHECK(table.insert("ndn:/", nameQ));
+  // { '/'=>Q, '/A'=>Q, '/A/B'=>P }, '/A/B' subtree is unaffected
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyP.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitE), strategyQ.get());
+
+  table.erase("ndn:/A/B");
+  // { '/'=>Q, '/A'=>Q }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyQ.get());
+
+  BOOST_CHECK(table.insert("ndn:/A", nameP));
+  // { '/'=>Q, '/A'=>P }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyP.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitAD), strategyP.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitE), strategyQ.get());
+
+  table.erase("ndn:/A");
+  // { '/'=>Q }
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitABC), strategyQ.get());
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitAD), strategyQ.get());
+}
+
 //XXX BOOST_CONCEPT_ASSERT((ForwardIterator<std::vector<int>::iterator>))
 //    is also failing. There might be a problem with ForwardIterator concept checking.
 //BOOST_CONCEPT_ASSERT((ForwardIterator<StrategyChoice::const_iterator>));
@@ -24,13 +24,30 @@
  */
 
 #include "table/cs.hpp"
+#include "table/cs-policy-priority-fifo.hpp"
+#include "table/cs-policy-lru.hpp"
+#include "table/cs-policy-arc.hpp"
+#include "table/cs-policy-clock-pro.hpp"
+#include "table/cs-admission-tinylfu.hpp"
 #include <ndn-cxx/security/key-chain.hpp>
 
+#include <cmath>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
 #include "tests/test-common.hpp"
 
 namespace nfd {
 namespace tests {
 
+using cs::Policy;
+using cs::PriorityFifoPolicy;
+using cs::LruPolicy;
+using cs::ArcPolicy;
+using cs::ClockProPolicy;
+using cs::AdmissionFilter;
+using cs::TinyLfuFilter;
+
 class CsBenchmarkFixture : public BaseFixture
 {
 protected:
@@ -106,9 +123,91 @@ protected:
     return workload;
   }
 
+  /** \brief generates object indices in [0,nObjects) following a Zipf distribution
+   */
+  class ZipfGenerator
+  {
+  public:
+    ZipfGenerator(size_t nObjects, double alpha, uint32_t seed = 1)
+      : m_cdf(nObjects)
+      , m_rng(seed)
+    {
+      double sum = 0.0;
+      for (size_t i = 0; i < nObjects; ++i) {
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), alpha);
+        m_cdf[i] = sum;
+      }
+      for (double& p : m_cdf) {
+        p /= sum;
+      }
+    }
+
+    size_t
+    operator()()
+    {
+      double u = m_dist(m_rng);
+      size_t i = std::lower_bound(m_cdf.begin(), m_cdf.end(), u) - m_cdf.begin();
+      return std::min(i, m_cdf.size() - 1);
+    }
+
+  private:
+    std::vector<double> m_cdf;
+    boost::random::mt19937 m_rng;
+    boost::random::uniform_real_distribution<double> m_dist;
+  };
+
+  /** \brief a request trace: each request is an index into a Data workload
+   */
+  typedef std::vector<size_t> Trace;
+
+  /** \brief replays \p trace against \p store, inserting Data upon every miss
+   *  \return hit ratio
+   */
+  double
+  replayTrace(Cs& store, const Trace& trace,
+              const std::vector<shared_ptr<Interest>>& interests,
+              const std::vector<shared_ptr<Data>>& data)
+  {
+    for (size_t i : trace) {
+      store.find(*interests[i], bind([]{}), bind([&store, &data, i] { store.insert(*data[i]); }));
+    }
+    return static_cast<double>(store.getNHits()) / (store.getNHits() + store.getNMisses());
+  }
+
+  /** \brief replays \p trace under each combination of policy and admission filter,
+   *         and reports the hit ratios
+   */
+  void
+  reportHitRatios(const std::string& workloadName, const Trace& trace,
+                  const std::vector<shared_ptr<Interest>>& interests,
+                  const std::vector<shared_ptr<Data>>& data)
+  {
+    typedef std::function<unique_ptr<Policy>()> PolicyFactory;
+    std::vector<PolicyFactory> policies = {
+      [] { return unique_ptr<Policy>(new PriorityFifoPolicy()); },
+      [] { return unique_ptr<Policy>(new LruPolicy()); },
+      [] { return unique_ptr<Policy>(new ArcPolicy()); },
+      [] { return unique_ptr<Policy>(new ClockProPolicy()); },
+    };
+
+    for (const PolicyFactory& makePolicy : policies) {
+      for (bool hasFilter : {false, true}) {
+        Cs store(HIT_RATIO_CS_CAPACITY, makePolicy());
+        if (hasFilter) {
+          store.setAdmissionFilter(unique_ptr<AdmissionFilter>(new TinyLfuFilter()));
+        }
+
+        double hitRatio = replayTrace(store, trace, interests, data);
+        BOOST_TEST_MESSAGE("hit-ratio " << workloadName << " " << store.getPolicy()->getName() <<
+                           (hasFilter ? "+tinylfu" : "") << ": " << hitRatio);
+      }
+    }
+  }
+
 protected:
   Cs cs;
   static const size_t CS_CAPACITY = 50000;
+  static const size_t HIT_RATIO_CS_CAPACITY = 1000;
 };
 
 BOOST_FIXTURE_TEST_SUITE(TableCsBenchmark, CsBenchmarkFixture)
@@ -217,6 +316,57 @@ BOOST_AUTO_TEST_CASE(Rightmost)
   BOOST_TEST_MESSAGE("find(rightmost) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d);
 }
 
+// hit ratio under Zipf-distributed requests
+BOOST_AUTO_TEST_CASE(HitRatioZipf)
+{
+  const size_t N_OBJECTS = HIT_RATIO_CS_CAPACITY * 20;
+  const size_t N_REQUESTS = N_OBJECTS * 10;
+
+  std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(N_OBJECTS);
+  std::vector<shared_ptr<Data>> dataWorkload = makeDataWorkload(N_OBJECTS);
+
+  ZipfGenerator zipf(N_OBJECTS, 0.9);
+  Trace trace(N_REQUESTS);
+  std::generate(trace.begin(), trace.end(), std::ref(zipf));
+
+  reportHitRatios("zipf", trace, interestWorkload, dataWorkload);
+}
+
+// hit ratio under Zipf-distributed requests interleaved with sequential one-time scans
+BOOST_AUTO_TEST_CASE(HitRatioZipfScan)
+{
+  const size_t N_OBJECTS = HIT_RATIO_CS_CAPACITY * 20;
+  const size_t N_REQUESTS = N_OBJECTS * 10;
+  const size_t SCAN_INTERVAL = HIT_RATIO_CS_CAPACITY * 4;
+  const size_t SCAN_LENGTH = HIT_RATIO_CS_CAPACITY;
+  const size_t N_SCAN_OBJECTS = N_REQUESTS / SCAN_INTERVAL * SCAN_LENGTH;
+
+  // scan objects are named under a separate prefix, and each of them is requested only once
+  std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(N_OBJECTS);
+  std::vector<shared_ptr<Data>> dataWorkload = makeDataWorkload(N_OBJECTS);
+  std::vector<shared_ptr<Interest>> scanInterests =
+    makeInterestWorkload(N_SCAN_OBJECTS, SimpleNameGenerator("/cs/benchmark/scan"));
+  std::vector<shared_ptr<Data>> scanData =
+    makeDataWorkload(N_SCAN_OBJECTS, SimpleNameGenerator("/cs/benchmark/scan"));
+  interestWorkload.insert(interestWorkload.end(), scanInterests.begin(), scanInterests.end());
+  dataWorkload.insert(dataWorkload.end(), scanData.begin(), scanData.end());
+
+  ZipfGenerator zipf(N_OBJECTS, 0.9);
+  Trace trace;
+  trace.reserve(N_REQUESTS + N_SCAN_OBJECTS);
+  size_t nextScanObject = N_OBJECTS;
+  for (size_t i = 0; i < N_REQUESTS; ++i) {
+    trace.push_back(zipf());
+    if ((i + 1) % SCAN_INTERVAL == 0) {
+      for (size_t j = 0; j < SCAN_LENGTH; ++j) {
+        trace.push_back(nextScanObject++);
+      }
+    }
+  }
+
+  reportHitRatios("zipf+scan", trace, interestWorkload, dataWorkload);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
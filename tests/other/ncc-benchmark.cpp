@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/forwarder.hpp"
+#include "fw/ncc-strategy.hpp"
+#include "fw/ncc-wheel-strategy.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// counts heap allocations, so that timer overhead shows up per Interest
+static std::atomic<size_t> g_nAllocations(0);
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace nfd {
+namespace tests {
+
+class NccBenchmarkFixture : public BaseFixture
+{
+protected:
+  NccBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif // _DEBUG
+  }
+
+  time::microseconds
+  timedRun(std::function<void()> f)
+  {
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    f();
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+  /** \brief runs \p f, and reports its duration and heap allocations per operation
+   */
+  void
+  report(const std::string& label, size_t nOps, std::function<void()> f)
+  {
+    size_t nAllocationsBefore = g_nAllocations;
+    time::microseconds d = timedRun(f);
+    size_t nAllocations = g_nAllocations - nAllocationsBefore;
+    BOOST_TEST_MESSAGE(label << " " << nOps << ": " << d << ", " <<
+                       static_cast<double>(nAllocations) / nOps << " allocations/op");
+  }
+
+  static Name
+  makeName(size_t i)
+  {
+    Name name("/ncc/benchmark");
+    name.appendNumber(i % 16);
+    name.appendNumber(i);
+    return name;
+  }
+
+protected:
+  static const size_t N_INTERESTS = 10000;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwNccBenchmark, NccBenchmarkFixture)
+
+typedef boost::mpl::list<fw::NccStrategy, fw::NccWheelStrategy> NccStrategies;
+
+// Interest-Data exchange through Forwarder with two upstreams.
+// Each Interest arms the best face timeout and the propagation timer;
+// each Data cancels the propagation timer.
+BOOST_AUTO_TEST_CASE_TEMPLATE(ForwardAndSatisfy, S, NccStrategies)
+{
+  Forwarder forwarder;
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face3 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.addFace(face3);
+  forwarder.getStrategyChoice().insert("/ncc/benchmark", S::STRATEGY_NAME);
+  shared_ptr<fib::Entry> fibEntry = forwarder.getFib().insert("/ncc/benchmark").first;
+  fibEntry->addNextHop(face2, 10);
+  fibEntry->addNextHop(face3, 20);
+
+  std::vector<shared_ptr<Interest>> interestWorkload(N_INTERESTS);
+  std::vector<shared_ptr<Data>> dataWorkload(N_INTERESTS);
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    interestWorkload[i] = makeInterest(makeName(i));
+    interestWorkload[i]->wireEncode();
+    dataWorkload[i] = makeData(makeName(i));
+    dataWorkload[i]->wireEncode();
+  }
+
+  // make face2 the best face, so that every Interest arms both timers
+  shared_ptr<Interest> warmupInterest = makeInterest("/ncc/benchmark/warmup");
+  face1->receiveInterest(*warmupInterest);
+  face2->receiveData(*makeData("/ncc/benchmark/warmup"));
+
+  face2->m_sentInterests.reserve(N_INTERESTS + 1);
+  face1->m_sentDatas.reserve(N_INTERESTS + 1);
+  const std::string strategyName = S::STRATEGY_NAME.at(-2).toUri();
+
+  report(strategyName + " forward", N_INTERESTS, [&] {
+    for (const shared_ptr<Interest>& interest : interestWorkload) {
+      face1->receiveInterest(*interest);
+    }
+  });
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), N_INTERESTS + 1);
+
+  report(strategyName + " satisfy", N_INTERESTS, [&] {
+    for (const shared_ptr<Data>& data : dataWorkload) {
+      face2->receiveData(*data);
+    }
+  });
+  BOOST_CHECK_EQUAL(face1->m_sentDatas.size(), N_INTERESTS + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd